@@ -2,6 +2,8 @@
 #include "../route_analysis/waypoint_snapper.h"
 #include "../pathfinding/shortest_planner.h"
 #include "../pathfinding/optimized_planner.h"
+#include "../pathfinding/isochrone_planner.h"
+#include "../pathfinding/visibility_graph_planner.h"
 #include "../utils/geo_calculations.h"
 #include "../utils/time_calculator.h"
 #include "../utils/fuel_calculator.h"
@@ -9,10 +11,14 @@
 #include "../utils/JSON_maker.h"
 #include <iostream>
 #include <chrono>
+#include <cmath>
 
 ShipRouter::ShipRouter()
     : isInitialized_(false)
+    , gridFileShallowDepthM_(-1.0)
+    , gridLayout_(CellLayout::ROW_MAJOR)
     , hasWeatherData_(false)
+    , replanLegIndex_(0)
 {
 }
 
@@ -30,6 +36,7 @@ bool ShipRouter::Initialize(
     std::cout << "Initializing ShipRouter..." << std::endl;
 
     try {
+        gridCache_.Clear();
         gridBuilder_ = std::make_unique<GridBuilder>();
         
         if (!gridBuilder_->LoadBathymetryData(gebco_path)) {
@@ -57,8 +64,7 @@ bool ShipRouter::LoadWeatherData(const std::string& weather_dir) {
     
     try {
         weatherLoader_ = std::make_unique<WeatherLoader>();
-        weatherData_ = weatherLoader_->LoadWeatherData(weather_dir);
-        hasWeatherData_ = !weatherData_.empty();
+        UpdateWeatherData(weatherLoader_->LoadWeatherData(weather_dir));
         
         return true;
         
@@ -69,6 +75,34 @@ bool ShipRouter::LoadWeatherData(const std::string& weather_dir) {
     }
 }
 
+bool ShipRouter::LoadTilePyramid(const std::string& pyramid_path) {
+    auto pyramid = std::make_unique<TilePyramid>();
+    if (!pyramid->Open(pyramid_path)) {
+        std::cerr << "[ERROR] Failed to load tile pyramid" << std::endl;
+        return false;
+    }
+    
+    tilePyramid_ = std::move(pyramid);
+    gridCache_.Clear();
+    return true;
+}
+
+void ShipRouter::UpdateWeatherData(const std::map<std::string, WeatherDataInput>& weather_data) {
+    // 유지 중인 탐색 상태가 있으면 바뀐 영역만 무효화
+    std::vector<WeatherChangeRegion> regions;
+    if (!replanLegs_.empty()) {
+        regions = diffWeatherData(weatherData_, weather_data);
+    }
+    
+    // 플래너들은 weatherData_를 참조하므로 객체를 교체하지 않고 내용만 갱신
+    weatherData_ = weather_data;
+    hasWeatherData_ = !weatherData_.empty();
+    
+    for (auto& leg : replanLegs_) {
+        leg->NotifyWeatherChanged(regions);
+    }
+}
+
 // ================================================================
 // 메인 API: CalculateRoute
 // ================================================================
@@ -79,8 +113,8 @@ VoyageResult ShipRouter::CalculateRoute(
 {
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // 초기화 체크
-    if (!isInitialized_) {
+    // 초기화 체크 (타일 피라미드나 저장된 그리드만으로도 탐색 가능)
+    if (!isInitialized_ && !HasTilePyramid() && gridFileShallowDepthM_ < 0.0) {
         return MakeErrorResult("ShipRouter not initialized");
     }
     
@@ -97,11 +131,14 @@ VoyageResult ShipRouter::CalculateRoute(
         // STEP 1: 그리드 생성
         // ============================================================
         // std::cout << "\n(1) Building grid..." << std::endl;
-        NavigableGrid grid = BuildGrid(
+        std::shared_ptr<const NavigableGrid> grid_ptr = AcquireGrid(
             waypoints,
             config.gridCellSizeKm,
-            config.gridMarginCells
+            config.gridMarginCells,
+            config.equalDistanceGrid,
+            MinDepthFor(config)
         );
+        const NavigableGrid& grid = *grid_ptr;
         
         // ============================================================
         // STEP 2: 웨이포인트 스냅핑
@@ -134,13 +171,28 @@ VoyageResult ShipRouter::CalculateRoute(
             snapped_waypoints.push_back(info.snapped);
         }
         
+        // 쿼드트리: 연안/천해/웨이포인트만 원 해상도, 원해는 큰 잎으로 합침
+        std::unique_ptr<QuadtreeGrid> quadtree;
+        if (config.useQuadtree) {
+            if (grid.IsEqualDistance() || grid.IsTiled()) {
+                std::cout << "[ShipRouter] useQuadtree ignored on equal-distance/tiled grid" << std::endl;
+            } else {
+                std::vector<GridCoordinate> waypoint_cells;
+                for (const auto& wp : snapped_waypoints) {
+                    waypoint_cells.push_back(grid.GeoToGrid(wp));
+                }
+                quadtree = std::make_unique<QuadtreeGrid>(
+                    QuadtreeGrid::Build(grid, waypoint_cells, config.quadtreeMaxLeafCells));
+            }
+        }
+        
         // ============================================================
         // STEP 3: 최단 경로 탐색
         // ============================================================
         SinglePathResult shortest_result;
         if (config.calculateShortest) {
             // std::cout << "\n(3) Finding shortest path..." << std::endl;
-            shortest_result = FindShortestPath(grid, snapped_waypoints, config);
+            shortest_result = FindShortestPath(grid, snapped_waypoints, config, quadtree.get());
             
             if (!shortest_result.success) {
                 VoyageResult result = MakeErrorResult("Shortest path finding failed: " + shortest_result.error_message);
@@ -155,12 +207,36 @@ VoyageResult ShipRouter::CalculateRoute(
         SinglePathResult optimal_result;
         if (config.calculateOptimized) {
             // std::cout << "\n(4) Finding optimized path..." << std::endl;
-            optimal_result = FindOptimalPath(
-                grid,
-                snapped_waypoints,
-                config,
-                weatherData_
-            );
+            if (config.keepReplanState && grid.IsEqualDistance()) {
+                // D* Lite는 대칭 이웃을 가정하므로 행별 열 수가 다른 그리드에서는 미지원
+                std::cout << "[ShipRouter] keepReplanState ignored on equal-distance grid" << std::endl;
+            }
+            if (config.keepReplanState && quadtree) {
+                std::cout << "[ShipRouter] keepReplanState uses the cell grid, not the quadtree" << std::endl;
+            }
+            if (config.keepReplanState && !grid.IsEqualDistance()) {
+                optimal_result = FindIncrementalOptimalPath(grid, snapped_waypoints, config);
+            } else {
+                ClearReplanState();
+                
+                // 최단 경로의 (날씨 반영) 연료를 최적 탐색의 상한으로 사용
+                std::vector<GridCoordinate> reference_path;
+                // any-angle(가시성 그래프) 경로는 격자 경로보다 짧을 수 있어 상한으로 쓰지 않음
+                if (config.pruneWithShortestFuel && shortest_result.success && !config.useVisibilityGraph) {
+                    for (const auto& d : shortest_result.path_details) {
+                        reference_path.push_back(grid.GeoToGrid(d.position));
+                    }
+                }
+                
+                optimal_result = FindOptimalPath(
+                    grid,
+                    snapped_waypoints,
+                    config,
+                    weatherData_,
+                    reference_path,
+                    quadtree.get()
+                );
+            }
             
             if (!optimal_result.success) {
                 VoyageResult result = MakeErrorResult("Optimal path finding failed: " + optimal_result.error_message);
@@ -246,13 +322,219 @@ VoyageResult ShipRouter::CalculateRoute(
 NavigableGrid ShipRouter::BuildGrid(
     const std::vector<GeoCoordinate>& waypoints,
     double cellSizeKm,
-    int marginCells)
+    int marginCells,
+    bool equalDistance)
 {
-    return gridBuilder_->BuildNavigableGrid(
-        waypoints,
-        cellSizeKm,
-        marginCells
-    );
+    return *AcquireGrid(waypoints, cellSizeKm, marginCells, equalDistance);
+}
+
+std::shared_ptr<const NavigableGrid> ShipRouter::AcquireGrid(
+    const std::vector<GeoCoordinate>& waypoints,
+    double cellSizeKm,
+    int marginCells,
+    bool equalDistance,
+    double minDepthM)
+{
+    // 피라미드에 맞는 레벨이 있으면 타일 복사, 없으면 GridBuilder
+    // (피라미드 레벨은 일반 격자이므로 등거리 격자는 항상 GridBuilder로 생성)
+    int level = (HasTilePyramid() && !(equalDistance && gridBuilder_))
+        ? tilePyramid_->FindLevel(cellSizeKm) : -1;
+    if (level < 0 && !gridBuilder_) {
+        // LoadGrid로 등록한 그리드 중 웨이포인트 범위를 포함하는 것만 사용 가능
+        if (gridFileShallowDepthM_ >= 0.0) {
+            BoundingBox roi = BoundingBox::FromWaypoints(waypoints);
+            double depthM = (minDepthM >= 0.0) ? minDepthM : gridFileShallowDepthM_;
+            if (auto cached = gridCache_.Find(roi, cellSizeKm, depthM, equalDistance)) {
+                return cached;
+            }
+            if (auto base = gridCache_.Find(roi, cellSizeKm, gridFileShallowDepthM_, equalDistance)) {
+                return DeriveDepthGrid(base, base->Bounds(), cellSizeKm, depthM, equalDistance);
+            }
+        }
+        throw std::runtime_error("No grid source for " + std::to_string(cellSizeKm) + " km cells");
+    }
+    
+    // 흘수 기준이 없으면 데이터 소스의 기준 수심 사용
+    double baseDepthM = gridBuilder_ ? gridBuilder_->ShallowDepthM() : tilePyramid_->ShallowDepthM();
+    double shallowDepthM = (minDepthM >= 0.0) ? minDepthM : baseDepthM;
+    BoundingBox roi;
+    if (level >= 0) {
+        const PyramidLevelHeader& lv = tilePyramid_->Level(level);
+        roi = BoundingBox::FromWaypoints(waypoints);
+        roi.minLat -= marginCells * lv.cellDegLat;
+        roi.maxLat += marginCells * lv.cellDegLat;
+        roi.minLon -= marginCells * lv.cellDegLon;
+        roi.maxLon += marginCells * lv.cellDegLon;
+        
+        // 피라미드 범위 밖 (일부라도): GridBuilder가 있으면 직접 생성
+        if (gridBuilder_ && !tilePyramid_->Covers(level, roi)) {
+            std::cout << "[ShipRouter] ROI outside tile pyramid level " << level
+                      << " coverage, building grid on demand" << std::endl;
+            level = -1;
+        }
+    }
+    if (level < 0) {
+        roi = gridBuilder_->CalculateExpandedROI(waypoints, cellSizeKm, marginCells);
+    }
+    
+    bool rowLayout = equalDistance && level < 0;
+    if (auto cached = gridCache_.Find(roi, cellSizeKm, shallowDepthM, rowLayout)) {
+        std::cout << "[ShipRouter] Grid cache hit ("
+                  << cached->Rows() << "x" << cached->Cols() << ")" << std::endl;
+        return cached;
+    }
+    
+    std::shared_ptr<NavigableGrid> grid;
+    if (level >= 0) {
+        grid = std::make_shared<NavigableGrid>();
+        std::vector<int16_t> depths;
+        if (!tilePyramid_->AssembleGrid(level, roi, shallowDepthM, *grid, &depths)) {
+            throw std::runtime_error("ROI outside tile pyramid coverage");
+        }
+        grid->SetDepths(std::vector<float>(depths.begin(), depths.end()));
+        GridBuilder::BuildSearchLayers(*grid);
+    } else if (std::abs(shallowDepthM - baseDepthM) > 1e-3) {
+        // 기준 그리드(캐시 또는 새로 생성)의 수심 레이어로 재분류, GEBCO 재처리 없음
+        auto base = AcquireGrid(waypoints, cellSizeKm, marginCells, equalDistance);
+        if (base->HasDepths()) {
+            return DeriveDepthGrid(base, roi, cellSizeKm, shallowDepthM, rowLayout);
+        }
+        // 수심 레이어가 없는 기준 그리드 (타일 그리드): 흘수 기준 수심으로 다시 생성
+        std::cout << "[ShipRouter] Base grid has no depth layer, building for "
+                  << shallowDepthM << " m minimum depth" << std::endl;
+        GridBuilder builder(*gridBuilder_);
+        builder.SetShallowDepthM(shallowDepthM);
+        grid = std::make_shared<NavigableGrid>(
+            builder.BuildNavigableGrid(waypoints, cellSizeKm, marginCells, equalDistance));
+    } else {
+        grid = std::make_shared<NavigableGrid>(
+            gridBuilder_->BuildNavigableGrid(waypoints, cellSizeKm, marginCells, equalDistance));
+    }
+    grid->SetLayout(gridLayout_);
+    
+    gridCache_.Insert(roi, cellSizeKm, shallowDepthM, grid, rowLayout);
+    return grid;
+}
+
+std::shared_ptr<const NavigableGrid> ShipRouter::DeriveDepthGrid(
+    std::shared_ptr<const NavigableGrid> base,
+    const BoundingBox& roi,
+    double cellSizeKm,
+    double minDepthM,
+    bool rowLayout)
+{
+    // 흘수 + UKC 기준을 무시한 그리드로 계획하면 얕은 수역을 통과하므로 요청 실패 처리
+    if (!base->HasDepths()) {
+        throw std::runtime_error("Grid has no depth layer, cannot apply "
+            + std::to_string(minDepthM) + " m minimum depth (draft + under-keel clearance)");
+    }
+    
+    auto grid = std::make_shared<NavigableGrid>(*base);
+    grid->MakeWritable();
+    grid->ApplyDepthThreshold(minDepthM);
+    std::cout << "[ShipRouter] Reclassified grid for " << minDepthM << " m minimum depth" << std::endl;
+    
+    gridCache_.Insert(roi, cellSizeKm, minDepthM, grid, rowLayout);
+    return grid;
+}
+
+double ShipRouter::MinDepthFor(const VoyageConfig& config) {
+    return (config.underKeelClearanceM >= 0.0) ? config.draftM + config.underKeelClearanceM : -1.0;
+}
+
+void ShipRouter::SetGridCacheLimit(size_t max_bytes) {
+    gridCache_.SetMaxBytes(max_bytes);
+}
+
+void ShipRouter::SetBlockedGridLayout(bool blocked) {
+    CellLayout layout = blocked ? CellLayout::BLOCKED_8X8 : CellLayout::ROW_MAJOR;
+    if (layout != gridLayout_) {
+        gridLayout_ = layout;
+        gridCache_.Clear();   // 캐시된 그리드는 이전 배치
+    }
+}
+
+void ShipRouter::SetGdalDecimation(bool enabled) {
+    if (gridBuilder_ && gridBuilder_->GdalDecimation() != enabled) {
+        gridBuilder_->SetGdalDecimation(enabled);
+        gridCache_.Clear();   // 캐시된 그리드는 이전 방식의 수심 평균
+    }
+}
+
+bool ShipRouter::BuildBathymetryOverviews() {
+    return gridBuilder_ && gridBuilder_->BuildBathymetryOverviews();
+}
+
+void ShipRouter::SetCoastlineSimplification(double tolerance_cells) {
+    if (gridBuilder_ && gridBuilder_->CoastlineSimplification() != tolerance_cells) {
+        gridBuilder_->SetCoastlineSimplification(tolerance_cells);
+        gridCache_.Clear();   // 캐시된 그리드는 이전 해안선으로 래스터화됨
+    }
+}
+
+std::vector<float> ShipRouter::SampleDepths(const std::vector<GeoCoordinate>& points) const {
+    std::vector<float> depths;
+    if (!gridBuilder_) {
+        std::cerr << "[ShipRouter] SampleDepths: GEBCO not loaded (call Initialize first)" << std::endl;
+        return depths;
+    }
+    if (!gridBuilder_->SampleDepths(points, depths)) {
+        std::cerr << "[ShipRouter] SampleDepths: GEBCO read failed" << std::endl;
+        depths.clear();
+    }
+    return depths;
+}
+
+bool ShipRouter::SaveGrid(
+    const std::vector<GeoCoordinate>& waypoints,
+    const VoyageConfig& config,
+    const std::string& grid_path)
+{
+    try {
+        std::shared_ptr<const NavigableGrid> grid = AcquireGrid(
+            waypoints,
+            config.gridCellSizeKm,
+            config.gridMarginCells,
+            config.equalDistanceGrid,
+            MinDepthFor(config)
+        );
+        double shallowDepthM = (MinDepthFor(config) >= 0.0) ? MinDepthFor(config)
+            : gridBuilder_ ? gridBuilder_->ShallowDepthM()
+            : HasTilePyramid() ? tilePyramid_->ShallowDepthM() : gridFileShallowDepthM_;
+        return GridFile::Save(*grid, grid_path, GridFileInfo(config.gridCellSizeKm, shallowDepthM));
+    } catch (const std::exception& e) {
+        std::cerr << "[ERROR] Failed to save grid: " << e.what() << std::endl;
+        return false;
+    }
+}
+
+bool ShipRouter::LoadGrid(const std::string& grid_path) {
+    auto grid = std::make_shared<NavigableGrid>();
+    GridFileInfo info;
+    if (!GridFile::Map(grid_path, *grid, &info)) {
+        std::cerr << "[ERROR] Failed to load grid file" << std::endl;
+        return false;
+    }
+    if (info.cellSizeKm <= 0.0) {
+        std::cerr << "[ERROR] Grid file has no cell size: " << grid_path << std::endl;
+        return false;
+    }
+    
+    double shallowDepthM = gridBuilder_ ? gridBuilder_->ShallowDepthM()
+        : HasTilePyramid() ? tilePyramid_->ShallowDepthM() : info.shallowDepthM;
+    if (std::abs(shallowDepthM - info.shallowDepthM) > 1e-3) {
+        std::cout << "[ShipRouter] Grid file built with shallow depth " << info.shallowDepthM
+                  << " m (current " << shallowDepthM << " m), not used for routing" << std::endl;
+    }
+    if (!gridBuilder_ && !HasTilePyramid()) {
+        gridFileShallowDepthM_ = info.shallowDepthM;
+    }
+    
+    // 연결 요소는 파일에 저장하지 않으므로 매핑된 그리드 위에 새로 레이블링
+    grid->BuildComponents();
+    
+    gridCache_.Insert(grid->Bounds(), info.cellSizeKm, info.shallowDepthM, grid, grid->IsEqualDistance());
+    return true;
 }
 
 std::vector<SnappingInfo> ShipRouter::SnapWaypoints(
@@ -261,16 +543,44 @@ std::vector<SnappingInfo> ShipRouter::SnapWaypoints(
     double maxRadiusKm)
 {
     WaypointSnapper snapper(grid, nullptr);  // TODO: port snapper 추가?
-    return snapper.SnapMultipleWaypoints(waypoints, maxRadiusKm);
+    std::vector<SnappingInfo> results = snapper.SnapMultipleWaypoints(waypoints, maxRadiusKm);
+    for (auto& info : results) {
+        info.snapped.longitude = normalizeLongitude(info.snapped.longitude);
+    }
+    return results;
 }
 
 SinglePathResult ShipRouter::FindShortestPath(
     const NavigableGrid& grid,
     const std::vector<GeoCoordinate>& snapped_waypoints,
-    const VoyageConfig& config)
+    const VoyageConfig& config,
+    const QuadtreeGrid* quadtree)
 {
+    // 가시성 그래프: GSHHS 해안선 꼭짓점 사이 any-angle 최단 경로
+    if (config.useVisibilityGraph) {
+        if (gridBuilder_ && gridBuilder_->IsCoastlineLoaded()) {
+            std::vector<std::vector<GeoCoordinate>> land_rings;
+            for (const auto& ref : gridBuilder_->ExtractCoastline(grid.Bounds())) {
+                if (ref.polygon->level == 1) {   // 래스터화와 동일하게 육지만
+                    land_rings.push_back(ref.polygon->points);
+                    for (auto& pt : land_rings.back()) {
+                        pt.longitude += ref.lonShift;
+                    }
+                }
+            }
+            
+            VisibilityGraphPlanner planner(grid, config.shipSpeedMps);
+            planner.Build(land_rings, config.visibilityBufferKm, config.visibilitySimplifyKm,
+                          (config.searchThreads > 1) ? config.searchThreads : 0);
+            return FindPathThroughWaypoints(grid, snapped_waypoints, planner, config, false);
+        }
+        std::cout << "[ShipRouter] useVisibilityGraph needs GSHHS data, using grid A*" << std::endl;
+    }
+    
     // Create shortest path planner
     ShortestRoutePlanner planner(grid, config.shipSpeedMps);
+    planner.SetSearchThreads(config.searchThreads);
+    planner.SetQuadtree(quadtree);
     
     // Find path through all waypoints
     return FindPathThroughWaypoints(
@@ -286,7 +596,9 @@ SinglePathResult ShipRouter::FindOptimalPath(
     const NavigableGrid& grid,
     const std::vector<GeoCoordinate>& snapped_waypoints,
     const VoyageConfig& config,
-    const std::map<std::string, WeatherDataInput>& weather_data)
+    const std::map<std::string, WeatherDataInput>& weather_data,
+    const std::vector<GridCoordinate>& reference_path,
+    const QuadtreeGrid* quadtree)
 {
     // Prepare voyage info
     VoyageInfo voyageInfo;
@@ -294,6 +606,26 @@ SinglePathResult ShipRouter::FindOptimalPath(
     voyageInfo.draft = config.draftM;
     voyageInfo.trim = config.trimM;
     
+    // 등시선(isochrone) 엔진 선택 시
+    if (config.useIsochrone) {
+        IsochroneRoutePlanner planner(
+            grid,
+            voyageInfo,
+            config.startTimeUnix,
+            weather_data,
+            config.shipSpeedMps
+        );
+        planner.SetSearchThreads(config.searchThreads);
+        
+        return FindPathThroughWaypoints(
+            grid,
+            snapped_waypoints,
+            planner,
+            config,
+            true  // use weather
+        );
+    }
+    
     // Create optimized path planner
     OptimizedRoutePlanner planner(
         grid,
@@ -302,6 +634,10 @@ SinglePathResult ShipRouter::FindOptimalPath(
         weather_data,
         config.shipSpeedMps
     );
+    planner.SetSearchThreads(config.searchThreads);
+    planner.SetMaxLabelsPerCell(config.maxLabelsPerCell);
+    planner.SetReferencePath(reference_path);
+    planner.SetQuadtree(quadtree);
     
     // Find path through all waypoints
     return FindPathThroughWaypoints(
@@ -339,6 +675,13 @@ SinglePathResult ShipRouter::FindPathThroughWaypoints(
         GridCoordinate start = grid.GeoToGrid(waypoints[i]);
         GridCoordinate goal = grid.GeoToGrid(waypoints[i + 1]);
         
+        // 서로 다른 수역: 탐색 없이 즉시 실패 (8방향 연결 요소 기준이므로
+        // 가시선으로 셀을 잇는 any-angle 플래너에는 적용하지 않음)
+        if (!planner.IsAnyAngle() && IsLegDisconnected(grid, start, goal)) {
+            return MakeErrorPathResult("Path not found for segment " + std::to_string(i + 1)
+                + " (waypoints are not connected by water)");
+        }
+        
         // Find path for this segment
         PathSearchResult segment_result = planner.FindPath(grid, start, goal);
         
@@ -353,20 +696,7 @@ SinglePathResult ShipRouter::FindPathThroughWaypoints(
         total_time_hours += segment_result.total_time_hours;
         
         // Append path
-        if (i == 0) {
-            complete_path.insert(
-                complete_path.end(),
-                segment_result.path.begin(),
-                segment_result.path.end()
-            );
-        } else {
-            complete_path.insert(
-                complete_path.end(),
-                segment_result.path.begin() + 1,
-                segment_result.path.end()
-            );
-        }
-        
+        AppendSegment(complete_path, segment_result.path);
     }
     
     // Analyze path and create detailed result
@@ -380,6 +710,176 @@ SinglePathResult ShipRouter::FindPathThroughWaypoints(
     );
 }
 
+bool ShipRouter::IsLegDisconnected(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal)
+{
+    int32_t from = grid.ComponentOf(start.row, start.col);
+    int32_t to = grid.ComponentOf(goal.row, goal.col);
+    if (from < 0 || to < 0 || from == to) {
+        return false;   // 레이어 없음/비항해 셀은 엔진이 처리
+    }
+    std::cerr << "[ShipRouter] (" << start.row << ", " << start.col << ") and ("
+              << goal.row << ", " << goal.col << ") are in different water bodies ("
+              << grid.ComponentSize(from) << " vs " << grid.ComponentSize(to)
+              << " cells), search skipped" << std::endl;
+    return true;
+}
+
+void ShipRouter::AppendSegment(
+    std::vector<GridCoordinate>& complete_path,
+    const std::vector<GridCoordinate>& segment)
+{
+    if (complete_path.empty()) {
+        complete_path.insert(complete_path.end(), segment.begin(), segment.end());
+    } else if (!segment.empty()) {
+        complete_path.insert(complete_path.end(), segment.begin() + 1, segment.end());
+    }
+}
+
+// ================================================================
+// 증분 재탐색
+// ================================================================
+
+SinglePathResult ShipRouter::FindIncrementalOptimalPath(
+    const NavigableGrid& grid,
+    const std::vector<GeoCoordinate>& snapped_waypoints,
+    const VoyageConfig& config)
+{
+    ClearReplanState();
+    
+    if (snapped_waypoints.size() < 2) {
+        return MakeErrorPathResult("At least 2 waypoints required");
+    }
+    
+    // 플래너가 참조할 그리드를 보관 (CalculateRoute의 그리드는 지역 변수)
+    replanGrid_ = std::make_unique<NavigableGrid>(grid);
+    replanConfig_ = config;
+    
+    VoyageInfo voyageInfo;
+    voyageInfo.shipSpeed = config.shipSpeedMps;
+    voyageInfo.draft = config.draftM;
+    voyageInfo.trim = config.trimM;
+    
+    std::vector<GridCoordinate> complete_path;
+    double total_cost = 0.0;
+    double total_time_hours = 0.0;
+    
+    for (size_t i = 0; i < snapped_waypoints.size() - 1; ++i) {
+        GridCoordinate start = replanGrid_->GeoToGrid(snapped_waypoints[i]);
+        GridCoordinate goal = replanGrid_->GeoToGrid(snapped_waypoints[i + 1]);
+        
+        if (IsLegDisconnected(*replanGrid_, start, goal)) {
+            ClearReplanState();
+            return MakeErrorPathResult("Path not found for segment " + std::to_string(i + 1)
+                + " (waypoints are not connected by water)");
+        }
+        
+        auto leg = std::make_unique<IncrementalRoutePlanner>(
+            *replanGrid_,
+            voyageInfo,
+            config.startTimeUnix,
+            weatherData_,
+            config.shipSpeedMps
+        );
+        
+        PathSearchResult segment_result = leg->FindPath(*replanGrid_, start, goal);
+        if (!segment_result.IsSuccess()) {
+            ClearReplanState();
+            return MakeErrorPathResult("Path not found for segment " + std::to_string(i + 1));
+        }
+        
+        total_cost += segment_result.total_cost;
+        total_time_hours += segment_result.total_time_hours;
+        AppendSegment(complete_path, segment_result.path);
+        
+        replanLegs_.push_back(std::move(leg));
+    }
+    
+    return AnalyzePathResult(
+        complete_path,
+        *replanGrid_,
+        config,
+        true,
+        total_cost,
+        total_time_hours
+    );
+}
+
+SinglePathResult ShipRouter::ReplanRoute(
+    const GeoCoordinate& vessel_position,
+    unsigned int current_time_unix)
+{
+    if (replanLegs_.empty() || !replanGrid_) {
+        return MakeErrorPathResult("No replan state (set keepReplanState and call CalculateRoute first)");
+    }
+    
+    const NavigableGrid& grid = *replanGrid_;
+    
+    // 선박 위치를 항해 가능한 셀로 스냅
+    WaypointSnapper snapper(grid, nullptr);
+    SnappingInfo snap = snapper.SnapToNavigable(vessel_position, replanConfig_.maxSnapRadiusKm);
+    if (!snap.IsSuccess()) {
+        return MakeErrorPathResult("Vessel position snapping failed: " + snap.failure_reason);
+    }
+    GridCoordinate vessel = grid.GeoToGrid(snap.snapped);
+    
+    // 선박이 위치한 구간: 남은 구간 중 마지막 경로와 가장 가까운 구간
+    size_t best_leg = replanLegIndex_;
+    long long best_dist = -1;
+    for (size_t i = replanLegIndex_; i < replanLegs_.size(); ++i) {
+        for (const auto& cell : replanLegs_[i]->LastPath()) {
+            long long dr = cell.row - vessel.row;
+            long long dc = cell.col - vessel.col;
+            long long dist = dr * dr + dc * dc;
+            if (best_dist < 0 || dist < best_dist) {
+                best_dist = dist;
+                best_leg = i;
+            }
+        }
+    }
+    replanLegIndex_ = best_leg;
+    
+    std::vector<GridCoordinate> complete_path;
+    double total_cost = 0.0;
+    double total_time_hours = 0.0;
+    
+    for (size_t i = replanLegIndex_; i < replanLegs_.size(); ++i) {
+        // 현재 구간은 선박 위치에서, 이후 구간은 원래 출발점에서 (날씨 변경분만 복구)
+        GridCoordinate start = (i == replanLegIndex_) ? vessel : replanLegs_[i]->Start();
+        
+        PathSearchResult segment_result = replanLegs_[i]->Replan(start);
+        if (!segment_result.IsSuccess()) {
+            return MakeErrorPathResult("Replan failed for segment " + std::to_string(i + 1));
+        }
+        
+        total_cost += segment_result.total_cost;
+        total_time_hours += segment_result.total_time_hours;
+        AppendSegment(complete_path, segment_result.path);
+    }
+    
+    VoyageConfig analysis_config = replanConfig_;
+    if (current_time_unix != 0) {
+        analysis_config.startTimeUnix = current_time_unix;
+    }
+    
+    return AnalyzePathResult(
+        complete_path,
+        grid,
+        analysis_config,
+        true,
+        total_cost,
+        total_time_hours
+    );
+}
+
+void ShipRouter::ClearReplanState() {
+    replanLegs_.clear();
+    replanGrid_.reset();
+    replanLegIndex_ = 0;
+}
+
 SinglePathResult ShipRouter::AnalyzePathResult(
     const std::vector<GridCoordinate>& path_grid,
     const NavigableGrid& grid,
@@ -493,6 +993,9 @@ SinglePathResult ShipRouter::AnalyzePathResult(
         point.cumulative_distance_km = cumulative_distance;
         point.cumulative_fuel_kg = cumulative_fuel;
         
+        // 날짜변경선을 넘는 그리드는 연속 경도를 쓰므로 출력 시 정규화
+        point.position.longitude = normalizeLongitude(point.position.longitude);
+        
         result.path_details.push_back(point);
     }
     
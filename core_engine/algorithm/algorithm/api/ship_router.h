@@ -1,13 +1,19 @@
 #pragma once
 
 #include "../data_loading/grid_builder.h"
+#include "../data_loading/grid_cache.h"
+#include "../data_loading/grid_file.h"
+#include "../data_loading/tile_pyramid.h"
 #include "../data_loading/weather_loader.h"
 #include "../route_analysis/waypoint_snapper.h"
 #include "../results/route_results.h"
+#include "../types/quadtree_grid.h"
 #include "../types/voyage_types.h"
 #include "../pathfinding/route_planner.h"
+#include "../pathfinding/incremental_planner.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 /**
  * @class ShipRouter
@@ -49,6 +55,25 @@ public:
      */
     bool LoadWeatherData(const std::string& weather_dir);
     
+    /**
+     * @brief 사전 계산된 전역 타일 피라미드 로딩 (메모리 매핑)
+     * 
+     * 요청 셀 크기와 맞는 레벨이 있으면 GEBCO/GSHHS 처리 없이 타일을 복사해
+     * 그리드를 만듭니다. 맞는 레벨이 없으면 GridBuilder로 생성합니다.
+     * @param pyramid_path TilePyramid::Build로 만든 파일 경로
+     * @return bool 성공 여부
+     */
+    bool LoadTilePyramid(const std::string& pyramid_path);
+    bool HasTilePyramid() const { return tilePyramid_ && tilePyramid_->IsOpen(); }
+    
+    /**
+     * @brief 날씨 데이터 교체 (새 예보 수신)
+     * 
+     * 유지 중인 재탐색 상태가 있으면 값이 바뀐 영역만 무효화합니다.
+     * @param weather_data 새 날씨 데이터 맵
+     */
+    void UpdateWeatherData(const std::map<std::string, WeatherDataInput>& weather_data);
+    
     bool IsInitialized() const { return isInitialized_; }
     
     // ================================================================
@@ -66,6 +91,103 @@ public:
         const VoyageConfig& config = VoyageConfig()
     );
     
+    /**
+     * @brief 항해 중 최적 경로 증분 재탐색
+     * 
+     * config.keepReplanState로 계산한 마지막 최적 경로의 탐색 상태를 재사용하여
+     * 현재 선박 위치에서 목적지까지의 경로를 다시 계산합니다.
+     * 이미 지나간 구간(leg)은 제외됩니다.
+     * @param vessel_position 현재 선박 위치
+     * @param current_time_unix 현재 시각 (0이면 출발 시각 사용, 결과 분석용)
+     * @return SinglePathResult 현재 위치부터의 최적 경로
+     */
+    SinglePathResult ReplanRoute(
+        const GeoCoordinate& vessel_position,
+        unsigned int current_time_unix = 0
+    );
+    
+    bool HasReplanState() const { return !replanLegs_.empty(); }
+    
+    // ================================================================
+    // 그리드 캐시
+    // ================================================================
+    
+    /**
+     * @brief 생성된 그리드 LRU 캐시의 메모리 상한 설정
+     * 
+     * 같은 셀 크기/수심 기준의 확장 ROI가 같거나 이를 포함하는 그리드가
+     * 캐시에 있으면 GEBCO/GSHHS 처리 없이 재사용합니다.
+     * @param max_bytes 최대 메모리 (0이면 캐시 비활성화)
+     */
+    void SetGridCacheLimit(size_t max_bytes);
+    GridCacheStats GetGridCacheStats() const { return gridCache_.Stats(); }
+    void ClearGridCache() { gridCache_.Clear(); }
+    
+    /**
+     * @brief 새로 생성하는 그리드의 셀 배치 (8x8 블록 배치는 넓은 그리드에서 캐시 미스 감소)
+     * 
+     * 변경 시 캐시를 비웁니다. LoadGrid로 매핑한 그리드는 항상 행 우선입니다.
+     * @param blocked true면 CellLayout::BLOCKED_8X8, false면 ROW_MAJOR
+     */
+    void SetBlockedGridLayout(bool blocked);
+    
+    /**
+     * @brief GEBCO 블록 평균을 GDAL이 읽기 시점에 계산 (RasterIO + GRIORA_Average, 오버뷰 사용)
+     * 
+     * 큰 셀(5~20 km)에서 원 해상도 픽셀을 직접 평균하지 않아 빠르지만, 오버뷰를 거치면
+     * 셀 수심이 근사값이 됩니다. 등거리 그리드/날짜변경선을 넘는 창은 기존 방식. 변경 시 캐시를 비웁니다.
+     * @param enabled true면 GDAL 평균, false면 DownsampleWindow의 자체 블록 평균 (DownsampleDepthGrid와 동일)
+     */
+    void SetGdalDecimation(bool enabled);
+    
+    /**
+     * @brief GEBCO 평균 오버뷰(.ovr 사이드카)를 한 번 생성 (이후 로딩 시 자동 사용)
+     * @return bool 성공 여부 (Initialize 전이거나 타일 피라미드 모드면 false)
+     */
+    bool BuildBathymetryOverviews();
+    
+    /**
+     * @brief ROI로 자른 GSHHS 해안선을 래스터화 전에 Douglas-Peucker로 단순화
+     * 
+     * 허용 오차는 셀 단위라 셀이 클수록 꼭짓점이 많이 줄어듭니다. 해안 경계 셀의
+     * 육지 판정이 조금 달라질 수 있습니다. 변경 시 캐시를 비웁니다.
+     * @param tolerance_cells 허용 오차 (셀, 0이면 단순화 없음, 기본값)
+     */
+    void SetCoastlineSimplification(double tolerance_cells);
+    
+    /**
+     * @brief 여러 지점의 GEBCO 수심을 한 번에 조회 (경로 샘플의 선저 여유 확인 등)
+     * 
+     * GDAL 블록 단위로 묶어 읽고 디코딩한 블록을 캐시합니다. 래스터 밖의 지점은 0입니다.
+     * @param points 조회할 지점 (위도/경도)
+     * @return std::vector<float> 지점별 수심 (m, 해수면 아래 음수). Initialize 전이거나 읽기 실패 시 빈 벡터
+     */
+    std::vector<float> SampleDepths(const std::vector<GeoCoordinate>& points) const;
+    
+    /**
+     * @brief 웨이포인트 경로용 그리드를 생성하여 파일로 저장 (반복 항로, 프로세스 간 공유)
+     * @param waypoints 웨이포인트 리스트
+     * @param config 그리드 설정 (gridCellSizeKm, gridMarginCells, equalDistanceGrid)
+     * @param grid_path 저장 경로 (GridFile 형식)
+     * @return bool 성공 여부
+     */
+    bool SaveGrid(
+        const std::vector<GeoCoordinate>& waypoints,
+        const VoyageConfig& config,
+        const std::string& grid_path
+    );
+    
+    /**
+     * @brief 저장된 그리드를 메모리 매핑하여 그리드 캐시에 등록 (읽기 전용, 복사 없음)
+     * 
+     * 이후 같은 셀 크기/수심 기준으로 파일 범위 안의 경로를 계산하면 그리드 생성 없이
+     * 바로 탐색합니다. Initialize 없이도 사용할 수 있으며, Initialize/LoadTilePyramid는
+     * 캐시를 비우므로 그 뒤에 호출해야 합니다.
+     * @param grid_path SaveGrid(GridFile::Save)로 만든 파일 경로
+     * @return bool 성공 여부
+     */
+    bool LoadGrid(const std::string& grid_path);
+    
     // ================================================================
     // 개별 단계 API (디버깅/테스트용)
     // ================================================================
@@ -76,7 +198,8 @@ public:
     NavigableGrid BuildGrid(
         const std::vector<GeoCoordinate>& waypoints,
         double cellSizeKm = 5.0,
-        int marginCells = 20
+        int marginCells = 20,
+        bool equalDistance = false
     );
     
     /**
@@ -90,21 +213,30 @@ public:
     
     /**
      * @brief 3단계: 최단 경로 탐색
+     * 
+     * config.useVisibilityGraph이면 GSHHS 해안선 가시성 그래프를 사용 (quadtree 무시)
+     * @param quadtree grid로 만든 쿼드트리 (nullptr이 아니면 셀 대신 잎 그래프에서 탐색)
      */
     SinglePathResult FindShortestPath(
         const NavigableGrid& grid,
         const std::vector<GeoCoordinate>& snapped_waypoints,
-        const VoyageConfig& config
+        const VoyageConfig& config,
+        const QuadtreeGrid* quadtree = nullptr
     );
     
     /**
      * @brief 4단계: 최적 경로 탐색 (연료 최적화)
+     * @param reference_path 실행 가능한 기준 경로 (예: 최단 경로). 구간별 연료를
+     *                       A* 상한으로 사용하며, 비어 있으면 상한 없이 탐색
+     * @param quadtree grid로 만든 쿼드트리 (등시선 방식에는 미적용)
      */
     SinglePathResult FindOptimalPath(
         const NavigableGrid& grid,
         const std::vector<GeoCoordinate>& snapped_waypoints,
         const VoyageConfig& config,
-        const std::map<std::string, WeatherDataInput>& weather_data
+        const std::map<std::string, WeatherDataInput>& weather_data,
+        const std::vector<GridCoordinate>& reference_path = {},
+        const QuadtreeGrid* quadtree = nullptr
     );
 
 private:
@@ -117,14 +249,63 @@ private:
     std::unique_ptr<GridBuilder> gridBuilder_;
     std::unique_ptr<WeatherLoader> weatherLoader_;
     
+    // 생성된 그리드 캐시
+    GridCache gridCache_;
+    
+    // 사전 계산된 타일 피라미드 (선택적)
+    std::unique_ptr<TilePyramid> tilePyramid_;
+    
+    // LoadGrid로 등록한 그리드의 수심 기준 (-1이면 없음, GEBCO/피라미드가 없을 때 사용)
+    double gridFileShallowDepthM_;
+    
+    // 생성하는 그리드의 셀 배치
+    CellLayout gridLayout_;
+    
     // 날씨 데이터
     std::map<std::string, WeatherDataInput> weatherData_;
     bool hasWeatherData_;
     
+    // 증분 재탐색 상태 (마지막 최적 경로 탐색)
+    std::unique_ptr<NavigableGrid> replanGrid_;
+    std::vector<std::unique_ptr<IncrementalRoutePlanner>> replanLegs_;
+    VoyageConfig replanConfig_;
+    size_t replanLegIndex_;
+    
     // ================================================================
     // 내부 헬퍼 함수들
     // ================================================================
     
+    /**
+     * @brief 그리드 캐시 조회 후 없으면 생성하여 캐시에 저장
+     */
+    std::shared_ptr<const NavigableGrid> AcquireGrid(
+        const std::vector<GeoCoordinate>& waypoints,
+        double cellSizeKm,
+        int marginCells,
+        bool equalDistance = false,
+        double minDepthM = -1.0
+    );
+    
+    /**
+     * @brief 기준 그리드의 수심 레이어로 minDepthM 기준 그리드를 만들어 캐시에 저장
+     * 
+     * 수심 레이어가 없으면 (수심 없이 저장된 GridFile 등) runtime_error를 던집니다.
+     * 흘수 기준을 무시한 그리드를 반환하지 않기 위함이며, GridBuilder가 있으면
+     * AcquireGrid가 먼저 해당 수심으로 직접 생성합니다.
+     */
+    std::shared_ptr<const NavigableGrid> DeriveDepthGrid(
+        std::shared_ptr<const NavigableGrid> base,
+        const BoundingBox& roi,
+        double cellSizeKm,
+        double minDepthM,
+        bool rowLayout
+    );
+    
+    /**
+     * @brief 설정의 흘수 + 여유 수심 (underKeelClearanceM < 0이면 -1: GridBuilder 기준)
+     */
+    static double MinDepthFor(const VoyageConfig& config);
+    
     /**
      * @brief 여러 웨이포인트를 거치는 경로 탐색
      * @param grid Navigable grid
@@ -142,6 +323,39 @@ private:
         bool use_weather
     );
     
+    /**
+     * @brief 탐색 상태를 유지하는 최적 경로 탐색 (증분 재탐색용)
+     * 
+     * 그리드를 복사해 보관하고 구간(leg)마다 IncrementalRoutePlanner를 생성합니다.
+     */
+    SinglePathResult FindIncrementalOptimalPath(
+        const NavigableGrid& grid,
+        const std::vector<GeoCoordinate>& snapped_waypoints,
+        const VoyageConfig& config
+    );
+    
+    /**
+     * @brief 구간 양 끝이 서로 다른 연결 요소(호수, 막힌 해역)에 있는지 O(1) 검사
+     * 
+     * 연결 요소 레이어가 없으면 false (탐색으로 판단). 8방향 연결 기준이라
+     * any-angle 플래너(IRoutePlanner::IsAnyAngle)에는 쓰지 않습니다.
+     */
+    static bool IsLegDisconnected(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal
+    );
+    
+    /**
+     * @brief 구간별 경로를 하나로 연결 (첫 구간 이후는 시작점 중복 제거)
+     */
+    static void AppendSegment(
+        std::vector<GridCoordinate>& complete_path,
+        const std::vector<GridCoordinate>& segment
+    );
+    
+    void ClearReplanState();
+    
     /**
      * @brief 경로 분석 수행 (그리드 경로 → PathPointDetail 생성)
      * @param path_grid Grid path
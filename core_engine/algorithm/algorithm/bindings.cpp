@@ -70,10 +70,22 @@ PYBIND11_MODULE(algorithm_module, m) {
         .def_readwrite("trim_m", &VoyageConfig::trimM)
         .def_readwrite("grid_cell_size_km", &VoyageConfig::gridCellSizeKm)
         .def_readwrite("grid_margin_cells", &VoyageConfig::gridMarginCells)
+        .def_readwrite("equal_distance_grid", &VoyageConfig::equalDistanceGrid)
+        .def_readwrite("under_keel_clearance_m", &VoyageConfig::underKeelClearanceM)
         .def_readwrite("max_snap_radius_km", &VoyageConfig::maxSnapRadiusKm)
         .def_readwrite("start_time_unix", &VoyageConfig::startTimeUnix)
         .def_readwrite("calculate_shortest", &VoyageConfig::calculateShortest)
         .def_readwrite("calculate_optimized", &VoyageConfig::calculateOptimized)
+        .def_readwrite("keep_replan_state", &VoyageConfig::keepReplanState)
+        .def_readwrite("search_threads", &VoyageConfig::searchThreads)
+        .def_readwrite("use_isochrone", &VoyageConfig::useIsochrone)
+        .def_readwrite("max_labels_per_cell", &VoyageConfig::maxLabelsPerCell)
+        .def_readwrite("prune_with_shortest_fuel", &VoyageConfig::pruneWithShortestFuel)
+        .def_readwrite("use_quadtree", &VoyageConfig::useQuadtree)
+        .def_readwrite("quadtree_max_leaf_cells", &VoyageConfig::quadtreeMaxLeafCells)
+        .def_readwrite("use_visibility_graph", &VoyageConfig::useVisibilityGraph)
+        .def_readwrite("visibility_buffer_km", &VoyageConfig::visibilityBufferKm)
+        .def_readwrite("visibility_simplify_km", &VoyageConfig::visibilitySimplifyKm)
         .def_readwrite("output_path", &VoyageConfig::output_path);
 
     // ============================================================
@@ -130,6 +142,15 @@ PYBIND11_MODULE(algorithm_module, m) {
         .def_readwrite("shortest_path", &VoyageResult::shortest_path)
         .def_readwrite("optimized_path", &VoyageResult::optimized_path);
 
+    py::class_<GridCacheStats>(m, "GridCacheStats")
+        .def(py::init<>())
+        .def_readonly("hits", &GridCacheStats::hits)
+        .def_readonly("containment_hits", &GridCacheStats::containmentHits)
+        .def_readonly("misses", &GridCacheStats::misses)
+        .def_readonly("evictions", &GridCacheStats::evictions)
+        .def_readonly("entries", &GridCacheStats::entries)
+        .def_readonly("bytes", &GridCacheStats::bytes);
+
     // ============================================================
     // 6. 메인 API 클래스 (ShipRouter) 
     // ============================================================
@@ -143,6 +164,11 @@ PYBIND11_MODULE(algorithm_module, m) {
         .def("load_weather_data", &ShipRouter::LoadWeatherData, 
              py::arg("weather_dir"),
              "Load weather data from directory")
+        .def("load_tile_pyramid", &ShipRouter::LoadTilePyramid,
+             py::arg("pyramid_path"),
+             "Memory-map a precomputed navigability/depth tile pyramid")
+        .def("has_tile_pyramid", &ShipRouter::HasTilePyramid,
+             "Check if a tile pyramid is loaded")
         .def("is_initialized", &ShipRouter::IsInitialized,
              "Check if router is initialized")
         .def("calculate_route", 
@@ -150,5 +176,43 @@ PYBIND11_MODULE(algorithm_module, m) {
                  &ShipRouter::CalculateRoute),
              py::arg("waypoints"), 
              py::arg("config"),  // 기본 인자 제거!
-             "Calculate route through waypoints with given configuration");
+             "Calculate route through waypoints with given configuration")
+        .def("update_weather_data", &ShipRouter::UpdateWeatherData,
+             py::arg("weather_data"),
+             "Replace weather data (repairs kept replan state incrementally)")
+        .def("replan_route", &ShipRouter::ReplanRoute,
+             py::arg("vessel_position"),
+             py::arg("current_time_unix") = 0,
+             "Replan the last optimized route from the current vessel position")
+        .def("has_replan_state", &ShipRouter::HasReplanState,
+             "Check if incremental replan state is kept")
+        .def("set_grid_cache_limit", &ShipRouter::SetGridCacheLimit,
+             py::arg("max_bytes"),
+             "Set the memory cap of the built-grid LRU cache (0 disables it)")
+        .def("get_grid_cache_stats", &ShipRouter::GetGridCacheStats,
+             "Grid cache hit/miss counters")
+        .def("clear_grid_cache", &ShipRouter::ClearGridCache,
+             "Drop all cached grids")
+        .def("set_blocked_grid_layout", &ShipRouter::SetBlockedGridLayout,
+             py::arg("blocked"),
+             "Store newly built grids in 8x8 cell blocks (fewer cache misses on wide grids)")
+        .def("set_gdal_decimation", &ShipRouter::SetGdalDecimation,
+             py::arg("enabled"),
+             "Average GEBCO blocks in GDAL at read time (RasterIO GRIORA_Average, uses overviews)")
+        .def("build_bathymetry_overviews", &ShipRouter::BuildBathymetryOverviews,
+             "Build the averaged GEBCO overview sidecar once (.ovr)")
+        .def("set_coastline_simplification", &ShipRouter::SetCoastlineSimplification,
+             py::arg("tolerance_cells"),
+             "Douglas-Peucker tolerance (cells) for clipped coastlines before rasterisation (0 = off)")
+        .def("sample_depths", &ShipRouter::SampleDepths,
+             py::arg("points"),
+             "GEBCO depth (m, negative below sea level) at each point in one batched, block-cached read")
+        .def("save_grid", &ShipRouter::SaveGrid,
+             py::arg("waypoints"),
+             py::arg("config"),
+             py::arg("grid_path"),
+             "Build the grid for a route and save it to a binary grid file")
+        .def("load_grid", &ShipRouter::LoadGrid,
+             py::arg("grid_path"),
+             "Memory-map a saved grid file (read-only) into the grid cache");
 }
\ No newline at end of file
@@ -0,0 +1,364 @@
+#include "depth_downsample.h"
+#include <algorithm>
+
+// AVX2: always on when the whole file is built for it (DOWNSAMPLE_AVX2),
+// otherwise on x86-64 compiled per function and picked at run time
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define DEPTH_DOWNSAMPLE_AVX2 1
+#elif defined(_MSC_VER) && defined(_M_X64)
+#include <immintrin.h>
+#include <intrin.h>
+#define DEPTH_DOWNSAMPLE_AVX2 1
+#define DEPTH_DOWNSAMPLE_AVX2_DISPATCH 1
+#define DEPTH_DOWNSAMPLE_AVX2_TARGET
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#include <immintrin.h>
+#define DEPTH_DOWNSAMPLE_AVX2 1
+#define DEPTH_DOWNSAMPLE_AVX2_DISPATCH 1
+#define DEPTH_DOWNSAMPLE_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DEPTH_DOWNSAMPLE_NEON 1
+#endif
+
+#if defined(DEPTH_DOWNSAMPLE_AVX2) && !defined(DEPTH_DOWNSAMPLE_AVX2_TARGET)
+#define DEPTH_DOWNSAMPLE_AVX2_TARGET
+#endif
+
+namespace {
+
+    // Single cell (reference order: rows, then columns)
+    float AverageCell(const std::vector<const float*>& srcRows, int srcCols, int blockLon, int dstCol) {
+        const int srcColStart = dstCol * blockLon;
+        const int srcColEnd = std::min(srcColStart + blockLon, srcCols);
+
+        double sum = 0.0;
+        int count = 0;
+        for (const float* row : srcRows) {
+            for (int c = srcColStart; c < srcColEnd; ++c) {
+                sum += row[c];
+                ++count;
+            }
+        }
+        return (count > 0) ? static_cast<float>(sum / count) : 0.0f;
+    }
+
+#if defined(DEPTH_DOWNSAMPLE_AVX2)
+    // 8 cells at a time; returns the first cell left to the caller
+    DEPTH_DOWNSAMPLE_AVX2_TARGET
+    int AverageFullBlocksAvx2(const std::vector<const float*>& srcRows, int blockLon, int fullCols, float* dst) {
+        const double count = static_cast<double>(srcRows.size()) * blockLon;
+        int dstCol = 0;
+
+        // 8 cells: two independent 4-lane double accumulators, strided gathers
+        const __m128i laneOffsets = _mm_setr_epi32(0, blockLon, 2 * blockLon, 3 * blockLon);
+        const __m256d divisor = _mm256_set1_pd(count);
+        for (; dstCol + 8 <= fullCols; dstCol += 8) {
+            __m256d acc0 = _mm256_setzero_pd();
+            __m256d acc1 = _mm256_setzero_pd();
+            const __m128i base0 = _mm_add_epi32(laneOffsets, _mm_set1_epi32(dstCol * blockLon));
+            const __m128i base1 = _mm_add_epi32(base0, _mm_set1_epi32(4 * blockLon));
+            for (const float* row : srcRows) {
+                for (int c = 0; c < blockLon; ++c) {
+                    const __m128i offset = _mm_set1_epi32(c);
+                    __m128 v0 = _mm_i32gather_ps(row, _mm_add_epi32(base0, offset), 4);
+                    __m128 v1 = _mm_i32gather_ps(row, _mm_add_epi32(base1, offset), 4);
+                    acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(v0));
+                    acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(v1));
+                }
+            }
+            _mm_storeu_ps(dst + dstCol, _mm256_cvtpd_ps(_mm256_div_pd(acc0, divisor)));
+            _mm_storeu_ps(dst + dstCol + 4, _mm256_cvtpd_ps(_mm256_div_pd(acc1, divisor)));
+        }
+        return dstCol;
+    }
+#endif
+
+#if defined(DEPTH_DOWNSAMPLE_AVX2_DISPATCH)
+    bool CpuHasAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+        __cpuid(info, 1);
+        const bool osxsave = (info[2] & (1 << 27)) != 0;
+        if (!osxsave || (_xgetbv(0) & 0x6) != 0x6) return false;   // OS saves YMM state
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+
+    // Checked once per process
+    bool UseAvx2() {
+        static const bool available = CpuHasAvx2();
+        return available;
+    }
+#elif defined(DEPTH_DOWNSAMPLE_AVX2)
+    bool UseAvx2() { return true; }
+#endif
+
+    // Cells [0, fullCols) cover whole blocks; returns the first cell left to AverageCell
+    int AverageFullBlocks(const std::vector<const float*>& srcRows, int blockLon, int fullCols, float* dst) {
+#if defined(DEPTH_DOWNSAMPLE_AVX2)
+        if (UseAvx2()) {
+            return AverageFullBlocksAvx2(srcRows, blockLon, fullCols, dst);
+        }
+#endif
+        const double count = static_cast<double>(srcRows.size()) * blockLon;
+        int dstCol = 0;
+
+#if defined(DEPTH_DOWNSAMPLE_NEON)
+        // 4 cells: two 2-lane double accumulators
+        const float64x2_t divisor = vdupq_n_f64(count);
+        for (; dstCol + 4 <= fullCols; dstCol += 4) {
+            float64x2_t acc0 = vdupq_n_f64(0.0);
+            float64x2_t acc1 = vdupq_n_f64(0.0);
+            const int b = dstCol * blockLon;
+            for (const float* row : srcRows) {
+                for (int c = 0; c < blockLon; ++c) {
+                    float32x2_t v0 = vld1_dup_f32(row + b + c);
+                    v0 = vld1_lane_f32(row + b + blockLon + c, v0, 1);
+                    float32x2_t v1 = vld1_dup_f32(row + b + 2 * blockLon + c);
+                    v1 = vld1_lane_f32(row + b + 3 * blockLon + c, v1, 1);
+                    acc0 = vaddq_f64(acc0, vcvt_f64_f32(v0));
+                    acc1 = vaddq_f64(acc1, vcvt_f64_f32(v1));
+                }
+            }
+            vst1_f32(dst + dstCol, vcvt_f32_f64(vdivq_f64(acc0, divisor)));
+            vst1_f32(dst + dstCol + 2, vcvt_f32_f64(vdivq_f64(acc1, divisor)));
+        }
+#else
+        // 4 cells: independent accumulators (no loop-carried dependency between cells)
+        for (; dstCol + 4 <= fullCols; dstCol += 4) {
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            const int b = dstCol * blockLon;
+            for (const float* row : srcRows) {
+                const float* r0 = row + b;
+                const float* r1 = r0 + blockLon;
+                const float* r2 = r1 + blockLon;
+                const float* r3 = r2 + blockLon;
+                for (int c = 0; c < blockLon; ++c) {
+                    s0 += r0[c];
+                    s1 += r1[c];
+                    s2 += r2[c];
+                    s3 += r3[c];
+                }
+            }
+            dst[dstCol] = static_cast<float>(s0 / count);
+            dst[dstCol + 1] = static_cast<float>(s1 / count);
+            dst[dstCol + 2] = static_cast<float>(s2 / count);
+            dst[dstCol + 3] = static_cast<float>(s3 / count);
+        }
+#endif
+        return dstCol;
+    }
+
+}  // namespace
+
+const char* DownsampleSimdName() {
+#if defined(DEPTH_DOWNSAMPLE_AVX2)
+    return UseAvx2() ? "AVX2" : "portable";
+#elif defined(DEPTH_DOWNSAMPLE_NEON)
+    return "NEON";
+#else
+    return "portable";
+#endif
+}
+
+void AverageDepthBlockRow(
+    const std::vector<const float*>& srcRows,
+    int srcCols,
+    int blockLon,
+    int dstCols,
+    float* dst,
+    DownsampleKernel kernel)
+{
+    int dstCol = 0;
+    if (kernel == DownsampleKernel::SIMD && !srcRows.empty()) {
+        const int fullCols = std::min(dstCols, srcCols / blockLon);
+        dstCol = AverageFullBlocks(srcRows, blockLon, fullCols, dst);
+    }
+    // Remainder and clipped edge blocks
+    for (; dstCol < dstCols; ++dstCol) {
+        dst[dstCol] = AverageCell(srcRows, srcCols, blockLon, dstCol);
+    }
+}
+
+namespace {
+
+    int ResolveThreadCount(int numThreads, int maxRows) {
+        if (numThreads <= 0) {
+            numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+        }
+        return std::max(1, std::min(numThreads, maxRows));
+    }
+
+    // Begin of block t when rows are split into blocks
+    int BlockBegin(int rows, int t, int blocks) {
+        return static_cast<int>(static_cast<long long>(rows) * t / blocks);
+    }
+
+}  // namespace
+
+RowBlockWorkers::RowBlockWorkers(int numThreads, int maxRows) {
+    const int count = ResolveThreadCount(numThreads, maxRows);
+    for (int block = 1; block < count; ++block) {
+        threads_.emplace_back(&RowBlockWorkers::WorkerLoop, this, block);
+    }
+}
+
+RowBlockWorkers::~RowBlockWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    start_.notify_all();
+    for (auto& t : threads_) {
+        t.join();
+    }
+}
+
+void RowBlockWorkers::Run(int rows, const std::function<void(int, int)>& fn) {
+    const int blocks = std::max(1, std::min(ThreadCount(), rows));
+    if (blocks == 1) {
+        fn(0, rows);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        job_ = &fn;
+        jobRows_ = rows;
+        jobBlocks_ = blocks;
+        pending_ = static_cast<int>(threads_.size());
+        ++generation_;
+    }
+    start_.notify_all();
+
+    fn(0, BlockBegin(rows, 1, blocks));
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ == 0; });
+    job_ = nullptr;
+}
+
+void RowBlockWorkers::WorkerLoop(int block) {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+        if (stop_) {
+            return;
+        }
+        seen = generation_;
+        const std::function<void(int, int)>* job = job_;
+        const int rows = jobRows_;
+        const int blocks = jobBlocks_;
+
+        lock.unlock();
+        if (block < blocks) {
+            (*job)(BlockBegin(rows, block, blocks), BlockBegin(rows, block + 1, blocks));
+        }
+        lock.lock();
+
+        if (--pending_ == 0) {
+            done_.notify_one();
+        }
+    }
+}
+
+void ParallelRowBlocks(
+    int rows,
+    int numThreads,
+    const std::function<void(int, int)>& fn)
+{
+    numThreads = ResolveThreadCount(numThreads, rows);
+    if (numThreads == 1) {
+        fn(0, rows);
+        return;
+    }
+    RowBlockWorkers(numThreads).Run(rows, fn);
+}
+
+std::vector<std::vector<float>> DownsampleDepthGrid(
+    const std::vector<std::vector<float>>& src,
+    int dstRows,
+    int dstCols,
+    int blockLat,
+    int blockLon,
+    int numThreads,
+    DownsampleKernel kernel)
+{
+    const int srcRows = static_cast<int>(src.size());
+    const int srcCols = src.empty() ? 0 : static_cast<int>(src[0].size());
+
+    // Threads only pay off on large rasters
+    const size_t MIN_PARALLEL_PIXELS = 1u << 20;
+    if (numThreads <= 0 && static_cast<size_t>(srcRows) * srcCols < MIN_PARALLEL_PIXELS) {
+        numThreads = 1;
+    }
+
+    std::vector<std::vector<float>> dst(dstRows, std::vector<float>(dstCols, 0.0f));
+    ParallelRowBlocks(dstRows, numThreads, [&](int begin, int end) {
+        std::vector<const float*> blockRows;
+        for (int dstRow = begin; dstRow < end; ++dstRow) {
+            // Source range covered by this output row (end is exclusive)
+            const int srcRowStart = dstRow * blockLat;
+            const int srcRowEnd = std::min(srcRowStart + blockLat, srcRows);
+
+            blockRows.clear();
+            for (int r = srcRowStart; r < srcRowEnd; ++r) {
+                blockRows.push_back(src[r].data());
+            }
+            AverageDepthBlockRow(blockRows, srcCols, blockLon, dstCols, dst[dstRow].data(), kernel);
+        }
+    });
+    return dst;
+}
+
+std::vector<std::vector<float>> DownsampleStrips(
+    int srcRows,
+    int srcCols,
+    const GridResolution& res,
+    const std::function<void(int, int, std::vector<float>&)>& readRows,
+    size_t stripPixels)
+{
+    const bool perRow = !res.rowBlockLon.empty();
+
+    // Whole output rows per strip
+    const int rowsPerStrip = static_cast<int>(std::max<size_t>(1,
+        stripPixels / (static_cast<size_t>(res.blockLat) * static_cast<size_t>(std::max(1, srcCols)))));
+
+    RowBlockWorkers workers(0, std::min(rowsPerStrip, res.rows));
+
+    std::vector<std::vector<float>> downsampled(res.rows, std::vector<float>(res.cols, 0.0f));
+    std::vector<float> strip;
+    for (int firstDst = 0; firstDst < res.rows; firstDst += rowsPerStrip) {
+        const int endDst = std::min(firstDst + rowsPerStrip, res.rows);
+        const int stripStart = firstDst * res.blockLat;
+        const int stripEnd = std::min(endDst * res.blockLat, srcRows);
+        readRows(stripStart, stripEnd - stripStart, strip);
+
+        // Output rows of the strip in parallel
+        workers.Run(endDst - firstDst, [&](int begin, int end) {
+            std::vector<const float*> blockRows;
+            for (int dstRow = firstDst + begin; dstRow < firstDst + end; ++dstRow) {
+                const int srcRowStart = dstRow * res.blockLat;
+                const int srcRowEnd = std::min(srcRowStart + res.blockLat, srcRows);
+
+                blockRows.clear();
+                for (int r = srcRowStart; r < srcRowEnd; ++r) {
+                    blockRows.push_back(strip.data() + static_cast<size_t>(r - stripStart) * srcCols);
+                }
+                AverageDepthBlockRow(blockRows, srcCols,
+                    perRow ? res.rowBlockLon[dstRow] : res.blockLon,
+                    perRow ? res.rowCols[dstRow] : res.cols,
+                    downsampled[dstRow].data());
+            }
+        });
+    }
+    return downsampled;
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+#include "../types/grid_types.h"
+#include <climits>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ===== Depth Block Averaging =====
+// Kernels behind GridBuilder::DownsampleWindow. Output cell
+// c of a row is the mean of the blockLon-wide column block c over the given
+// source rows; blocks past srcCols are clipped and empty blocks give 0.
+//
+// Every cell is summed in double in row-then-column order, so the SIMD
+// kernel (independent output cells per vector lane) is bit-identical to the
+// scalar loop. AVX2 (x86-64, chosen at run time when the CPU has it, or
+// always with DOWNSAMPLE_AVX2) and NEON (AArch64) use intrinsics; otherwise
+// a 4-cell interleaved loop the compiler can vectorise.
+enum class DownsampleKernel : uint8_t {
+    SCALAR,   // One cell at a time (reference)
+    SIMD      // Several cells per iteration
+};
+
+// "AVX2", "NEON" or "portable": what DownsampleKernel::SIMD runs on this CPU
+const char* DownsampleSimdName();
+
+// One output row from the source rows of its block
+void AverageDepthBlockRow(
+    const std::vector<const float*>& srcRows,
+    int srcCols,
+    int blockLon,
+    int dstCols,
+    float* dst,
+    DownsampleKernel kernel = DownsampleKernel::SIMD
+);
+
+// ===== Row Block Workers =====
+// Threads started once and reused by every Run, for callers that split
+// many consecutive jobs (e.g. one per GEBCO strip). Run(rows, fn) calls
+// fn(begin, end) over contiguous blocks of [0, rows), one per thread (the
+// calling thread takes the first), and returns when all blocks are done.
+class RowBlockWorkers {
+public:
+    // numThreads <= 0: hardware concurrency; never more than maxRows threads
+    explicit RowBlockWorkers(int numThreads, int maxRows = INT_MAX);
+    ~RowBlockWorkers();
+
+    RowBlockWorkers(const RowBlockWorkers&) = delete;
+    RowBlockWorkers& operator=(const RowBlockWorkers&) = delete;
+
+    int ThreadCount() const { return static_cast<int>(threads_.size()) + 1; }
+
+    void Run(int rows, const std::function<void(int, int)>& fn);
+
+private:
+    std::vector<std::thread> threads_;   // Blocks 1..N-1 (caller runs block 0)
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const std::function<void(int, int)>* job_ = nullptr;
+    int jobRows_ = 0;
+    int jobBlocks_ = 0;
+    int pending_ = 0;
+    uint64_t generation_ = 0;
+    bool stop_ = false;
+
+    void WorkerLoop(int block);
+};
+
+// fn(begin, end) over contiguous blocks of [0, rows), one per thread
+// (numThreads <= 0: hardware concurrency); threads live for this call only
+void ParallelRowBlocks(
+    int rows,
+    int numThreads,
+    const std::function<void(int, int)>& fn
+);
+
+// dstRows x dstCols block averages of src (arguments already validated).
+// numThreads <= 0 picks hardware concurrency for large inputs, 1 otherwise.
+std::vector<std::vector<float>> DownsampleDepthGrid(
+    const std::vector<std::vector<float>>& src,
+    int dstRows,
+    int dstCols,
+    int blockLat,
+    int blockLon,
+    int numThreads = 0,
+    DownsampleKernel kernel = DownsampleKernel::SIMD
+);
+
+// Streaming DownsampleDepthGrid over a srcRows x srcCols raster that is
+// never held whole: readRows(first, count, strip) fills count source rows
+// (row-major, srcCols wide) per strip of whole blockLat rows, about
+// stripPixels pixels each, and the strip is averaged straight into the
+// res.rows x res.cols output (per-row blockLon/cols when res.rowBlockLon is
+// set). Worker threads are started once for all strips. Cells match
+// DownsampleDepthGrid bit for bit.
+std::vector<std::vector<float>> DownsampleStrips(
+    int srcRows,
+    int srcCols,
+    const GridResolution& res,
+    const std::function<void(int, int, std::vector<float>&)>& readRows,
+    size_t stripPixels = 4u * 1024u * 1024u
+);
\ No newline at end of file
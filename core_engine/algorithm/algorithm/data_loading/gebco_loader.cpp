@@ -1,10 +1,14 @@
 #include "gebco_loader.h"
+#include <algorithm>
 #include <iostream>
 #include <cmath>
+#include <cstring>
 
 GebcoLoader::GebcoLoader(const std::string& filepath)
     : filepath(filepath), dataset(nullptr), band(nullptr),
-    rasterWidth(0), rasterHeight(0) {
+    rasterWidth(0), rasterHeight(0),
+    tileWidth(1), tileHeight(1),
+    tileCacheMaxBytes(DEFAULT_TILE_CACHE_BYTES), tileCacheBytes(0) {
     for (int i = 0; i < 6; ++i) {
         geoTransform[i] = 0.0;
 		invGeoTransform[i] = 0.0;
@@ -52,10 +56,12 @@ bool GebcoLoader::Open() {
         Close();
         return false;
     }
+    InitDepthTiles();
     return true;
 }
 
 void GebcoLoader::Close() {
+    ClearDepthTiles();
     if (dataset) {
         GDALClose(dataset);
         dataset = nullptr;
@@ -110,9 +116,16 @@ bool GebcoLoader::ExpandROIWithPixelMargin(const BoundingBox& baseROI,int margin
     pixelWindow.rightCol += marginPixel;
     pixelWindow.bottomRow += marginPixel;
 
-    // Step 3: clamp bounds
-    pixelWindow.leftCol = std::clamp(pixelWindow.leftCol, 0, rasterWidth - 1);
-    pixelWindow.rightCol = std::clamp(pixelWindow.rightCol, 0, rasterWidth - 1);
+    // Step 3: clamp bounds (columns wrap across the antimeridian on a global raster)
+    if (IsGlobal() && pixelWindow.width() < rasterWidth) {
+        int shift = static_cast<int>(std::floor(static_cast<double>(pixelWindow.leftCol) / rasterWidth)) * rasterWidth;
+        pixelWindow.leftCol -= shift;    // leftCol in [0, width), rightCol may exceed the raster
+        pixelWindow.rightCol -= shift;
+    }
+    else {
+        pixelWindow.leftCol = std::clamp(pixelWindow.leftCol, 0, rasterWidth - 1);
+        pixelWindow.rightCol = std::clamp(pixelWindow.rightCol, 0, rasterWidth - 1);
+    }
     pixelWindow.topRow = std::clamp(pixelWindow.topRow, 0, rasterHeight - 1);
     pixelWindow.bottomRow = std::clamp(pixelWindow.bottomRow, 0, rasterHeight - 1);
 
@@ -170,46 +183,309 @@ bool GebcoLoader::ExtractROI(
 // #endif 
     
 	// Step 2: Read Data with RasterIO()
+    if (!ReadWindow(pixelWindow, depths)) {
+        return false;
+    }
+
+	// Step 4: Stroe geographic resolution
+    latStepGeo = std::abs(geoTransform[5]);
+    lonStepGeo = std::abs(geoTransform[1]);
+
+    return true;
+}
+
+bool GebcoLoader::ReadWindow(
+    const PixelWindow& pixelWindow,
+    std::vector<std::vector<float>>& depths
+    ) const {
+    int width = pixelWindow.width();
+    int height = pixelWindow.height();
+
+    std::vector<float> buffer;
+    if (!ReadWindowRows(pixelWindow, 0, height, buffer)) {
+        return false;
+    }
+
+    // 1D buffer -> 2D depths matrix
+    depths.assign(height, std::vector<float>(width));
+    for (int r = 0; r < height; ++r) {
+        std::memcpy(depths[r].data(), buffer.data() + static_cast<size_t>(r) * width,
+            sizeof(float) * width);
+    }
+    return true;
+}
+
+bool GebcoLoader::ReadWindowRows(
+    const PixelWindow& pixelWindow,
+    int firstRow,
+    int rowCount,
+    std::vector<float>& rows
+    ) const {
+    if (!IsOpen()) return false;
+
+    int width = pixelWindow.width();
+    if (width <= 0 || rowCount <= 0 || firstRow < 0 || firstRow + rowCount > pixelWindow.height()) return false;
+
+    // Wrapped columns are read as separate pieces, each straight into its
+    // column range of the output (line stride = window width)
+    rows.resize(static_cast<size_t>(width) * rowCount);
+    std::lock_guard<std::mutex> lock(rasterMutex);
+    int outCol = 0;
+    for (int col = pixelWindow.leftCol; col <= pixelWindow.rightCol; ) {
+        int srcCol = ((col % rasterWidth) + rasterWidth) % rasterWidth;
+        int pieceWidth = std::min(pixelWindow.rightCol - col + 1, rasterWidth - srcCol);
+
+        CPLErr err = band->RasterIO(
+            GF_Read,
+            srcCol, pixelWindow.topRow + firstRow,
+            pieceWidth, rowCount,
+            rows.data() + outCol,
+            pieceWidth, rowCount,
+            GDT_Float32,
+            sizeof(float), static_cast<GSpacing>(sizeof(float)) * width
+        );
+
+        if (err != CE_None) {
+            std::cerr << "[ERROR] Failed to read raster data" << std::endl;
+            return false;
+        }
+
+        col += pieceWidth;
+        outCol += pieceWidth;
+    }
+    return true;
+}
+
+bool GebcoLoader::ReadWindowAveraged(
+    const PixelWindow& pixelWindow,
+    int outRows,
+    int outCols,
+    std::vector<float>& averaged
+    ) const {
+    if (!IsOpen()) return false;
+
     int width = pixelWindow.width();
     int height = pixelWindow.height();
-    std::vector<float> buffer(width * height);
+    if (width <= 0 || height <= 0 || outRows <= 0 || outCols <= 0) return false;
+    if (pixelWindow.leftCol < 0 || pixelWindow.rightCol >= rasterWidth) return false;   // wrapped
+
+    GDALRasterIOExtraArg extraArg;
+    INIT_RASTERIO_EXTRA_ARG(extraArg);
+    extraArg.eResampleAlg = GRIORA_Average;
+
+    averaged.resize(static_cast<size_t>(outRows) * outCols);
+    std::unique_lock<std::mutex> lock(rasterMutex);
     CPLErr err = band->RasterIO(
         GF_Read,
         pixelWindow.leftCol, pixelWindow.topRow,
         width, height,
-        buffer.data(),
-        width, height,
+        averaged.data(),
+        outCols, outRows,
         GDT_Float32,
-        0, 0
+        0, 0,
+        &extraArg
     );
+    lock.unlock();
 
     if (err != CE_None) {
-        std::cerr << "[ERROR] Failed to read raster data" << std::endl;
+        std::cerr << "[ERROR] Failed to read averaged raster data" << std::endl;
         return false;
     }
+    return true;
+}
 
-	// Step 3: Convert 1D buffer to 2D depths matrix
-    depths.assign(height, std::vector<float>(width));
-    for (int r = 0; r < height; ++r) { 
-        std::memcpy(depths[r].data(), buffer.data() + r * width, sizeof(float) * width);
+bool GebcoLoader::BuildOverviews(const std::vector<int>& factors) {
+    if (!IsOpen() || factors.empty()) return false;
+
+    std::cout << "[GebcoLoader] Building " << factors.size() << " overview levels for "
+              << filepath << " (one-time)..." << std::endl;
+    int bandList[1] = { 1 };
+    CPLErr err;
+    {
+        std::lock_guard<std::mutex> lock(rasterMutex);
+        err = dataset->BuildOverviews(
+            "AVERAGE",
+            static_cast<int>(factors.size()), factors.data(),
+            1, bandList,
+            nullptr, nullptr
+        );
+    }
+    if (err != CE_None) {
+        std::cerr << "[ERROR] Failed to build GEBCO overviews" << std::endl;
+        return false;
     }
 
-	// Step 4: Stroe geographic resolution
-    latStepGeo = std::abs(geoTransform[5]);
-    lonStepGeo = std::abs(geoTransform[1]);
+    // Reopen so the band sees the new overview sidecar
+    Close();
+    return Open();
+}
 
-    return true;
+int GebcoLoader::GetOverviewCount() const {
+    std::lock_guard<std::mutex> lock(rasterMutex);
+    return band ? band->GetOverviewCount() : 0;
 }
 
+BoundingBox GebcoLoader::WindowBounds(const PixelWindow& pixelWindow) const {
+    double westLon, northLat, eastLon, southLat;
+    PixelCornerToGeo(pixelWindow.leftCol, pixelWindow.topRow, westLon, northLat);
+    PixelCornerToGeo(pixelWindow.rightCol + 1, pixelWindow.bottomRow + 1, eastLon, southLat);
+    return BoundingBox(southLat, northLat, westLon, eastLon);
+}
 
-float GebcoLoader::GetDepthAt(double lon, double lat) const {
-    if (!IsOpen()) return 0.0f;
-    double px, py; GeoToPixelCont(lon, lat, px, py);
-    const int col = static_cast<int>(std::floor(px));
-    const int row = static_cast<int>(std::floor(py));
-    if (col < 0 || col >= rasterWidth || row < 0 || row >= rasterHeight) return 0.0f;
+bool GebcoLoader::ExpandROI(
+    const BoundingBox& baseROI,
+    int pixelMargin,
+    BoundingBox& expandedROI,
+    PixelWindow* pixelWindowOut
+    ) const {
+    PixelWindow pixelWindow;
+    if (!ExpandROIWithPixelMargin(baseROI, pixelMargin, pixelWindow, expandedROI)) {
+        return false;
+    }
+    if (pixelWindowOut) {
+        *pixelWindowOut = pixelWindow;
+    }
+    return true;
+}
 
+float GebcoLoader::GetDepthAt(double lon, double lat) const {
     float depth = 0.0f;
-    band->RasterIO(GF_Read, col, row, 1, 1, &depth, 1, 1, GDT_Float32, 0, 0);
+    GetDepthsAt(&lon, &lat, 1, &depth);
     return depth;
+}
+
+bool GebcoLoader::GetDepthsAt(const double* lons, const double* lats, size_t count, float* depths) const {
+    std::fill(depths, depths + count, 0.0f);
+    if (!IsOpen()) return false;
+
+    const bool global = IsGlobal();
+    const int tilesPerRow = (rasterWidth + tileWidth - 1) / tileWidth;
+
+    // Pixel of every point, ordered by tile so each tile is fetched once
+    std::vector<int> cols(count), rows(count);
+    std::vector<std::pair<int64_t, size_t>> order;
+    order.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        double px, py; GeoToPixelCont(lons[i], lats[i], px, py);
+        int col = static_cast<int>(std::floor(px));
+        const int row = static_cast<int>(std::floor(py));
+        if (global) col = ((col % rasterWidth) + rasterWidth) % rasterWidth;
+        if (col < 0 || col >= rasterWidth || row < 0 || row >= rasterHeight) continue;   // Stays 0
+
+        cols[i] = col;
+        rows[i] = row;
+        order.emplace_back(static_cast<int64_t>(row / tileHeight) * tilesPerRow + col / tileWidth, i);
+    }
+    std::sort(order.begin(), order.end());
+
+    std::lock_guard<std::mutex> lock(depthTileMutex);
+    for (size_t g = 0; g < order.size();) {
+        const int64_t key = order[g].first;
+        const int tileCol = static_cast<int>(key % tilesPerRow);
+        const int tileRow = static_cast<int>(key / tilesPerRow);
+        const DepthTile* tile = FetchDepthTile(tileCol, tileRow);
+        if (!tile) return false;
+
+        const int col0 = tileCol * tileWidth;
+        const int row0 = tileRow * tileHeight;
+        for (; g < order.size() && order[g].first == key; ++g) {
+            const size_t i = order[g].second;
+            depths[i] = tile->data[static_cast<size_t>(rows[i] - row0) * tile->width + (cols[i] - col0)];
+        }
+    }
+    return true;
+}
+
+bool GebcoLoader::GetDepthsAt(const std::vector<GeoCoordinate>& points, std::vector<float>& depths) const {
+    std::vector<double> lons(points.size()), lats(points.size());
+    for (size_t i = 0; i < points.size(); ++i) {
+        lons[i] = points[i].longitude;
+        lats[i] = points[i].latitude;
+    }
+    depths.resize(points.size());
+    return GetDepthsAt(lons.data(), lats.data(), points.size(), depths.data());
+}
+
+void GebcoLoader::SetBlockCacheBytes(size_t maxBytes) {
+    std::lock_guard<std::mutex> lock(depthTileMutex);
+    tileCacheMaxBytes = maxBytes;
+    while (tileCacheBytes > tileCacheMaxBytes && !depthTiles.empty()) {
+        tileCacheBytes -= depthTiles.back().data.size() * sizeof(float);
+        depthTileIndex.erase(depthTiles.back().key);
+        depthTiles.pop_back();
+    }
+}
+
+void GebcoLoader::InitDepthTiles() {
+    ClearDepthTiles();
+
+    int blockX = 0, blockY = 0;
+    band->GetBlockSize(&blockX, &blockY);
+    tileWidth = std::max(1, std::min(blockX, rasterWidth));
+    tileHeight = std::max(1, std::min(blockY, rasterHeight));
+
+    // Unchunked files report whole scanlines (or the whole raster) as one
+    // block: read narrower pieces, GDAL's own block cache still serves them
+    if (static_cast<int64_t>(tileWidth) * tileHeight > MAX_TILE_PIXELS) {
+        tileWidth = std::min(tileWidth, 1024);
+        tileHeight = static_cast<int>(std::max<int64_t>(1,
+            std::min<int64_t>(tileHeight, MAX_TILE_PIXELS / tileWidth)));
+    }
+}
+
+void GebcoLoader::ClearDepthTiles() {
+    std::lock_guard<std::mutex> lock(depthTileMutex);
+    depthTiles.clear();
+    depthTileIndex.clear();
+    tileCacheBytes = 0;
+}
+
+const GebcoLoader::DepthTile* GebcoLoader::FetchDepthTile(int tileCol, int tileRow) const {
+    const int tilesPerRow = (rasterWidth + tileWidth - 1) / tileWidth;
+    const int64_t key = static_cast<int64_t>(tileRow) * tilesPerRow + tileCol;
+
+    auto found = depthTileIndex.find(key);
+    if (found != depthTileIndex.end()) {
+        depthTiles.splice(depthTiles.begin(), depthTiles, found->second);   // Mark most recently used
+        return &depthTiles.front();
+    }
+
+    const int col0 = tileCol * tileWidth;
+    const int row0 = tileRow * tileHeight;
+    const int width = std::min(tileWidth, rasterWidth - col0);
+    const int height = std::min(tileHeight, rasterHeight - row0);
+
+    DepthTile tile;
+    tile.key = key;
+    tile.width = width;
+    tile.data.resize(static_cast<size_t>(width) * height);
+    CPLErr err;
+    {
+        std::lock_guard<std::mutex> lock(rasterMutex);
+        err = band->RasterIO(
+            GF_Read,
+            col0, row0,
+            width, height,
+            tile.data.data(),
+            width, height,
+            GDT_Float32,
+            0, 0
+        );
+    }
+    if (err != CE_None) {
+        std::cerr << "[ERROR] Failed to read depth block" << std::endl;
+        return nullptr;
+    }
+
+    tileCacheBytes += tile.data.size() * sizeof(float);
+    depthTiles.push_front(std::move(tile));
+    depthTileIndex[key] = depthTiles.begin();
+
+    // Least recently used first, never the tile just read
+    while (tileCacheBytes > tileCacheMaxBytes && depthTiles.size() > 1) {
+        tileCacheBytes -= depthTiles.back().data.size() * sizeof(float);
+        depthTileIndex.erase(depthTiles.back().key);
+        depthTiles.pop_back();
+    }
+    return &depthTiles.front();
 }
\ No newline at end of file
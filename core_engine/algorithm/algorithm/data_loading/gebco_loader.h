@@ -1,6 +1,12 @@
 #pragma once
 #include "../types/geo_types.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <gdal_priv.h>
 
@@ -12,6 +18,10 @@ struct PixelWindow {
     int height() const { return bottomRow - topRow + 1; }
 };
 
+// Reads (ReadWindow*, GetDepth*) may run on several threads at once: the
+// raster is accessed under one lock, so a depth query during a grid build
+// or tile load never touches the GDAL dataset concurrently. Open, Close and
+// BuildOverviews replace the dataset and must not overlap any read.
 class GebcoLoader {
 private:
     std::string filepath;
@@ -23,6 +33,35 @@ private:
     int rasterWidth;
     int rasterHeight;
 
+    // ===== Decoded Block Cache (GetDepthAt / GetDepthsAt) =====
+    // Tiles follow the GDAL block layout of the band (capped at
+    // MAX_TILE_PIXELS), clipped at the raster edges.
+    struct DepthTile {
+        int64_t key;               // tileRow * tilesPerRow + tileCol
+        int width;
+        std::vector<float> data;   // width x height, row-major
+    };
+
+    static constexpr int64_t MAX_TILE_PIXELS = 1 << 20;
+    static constexpr size_t DEFAULT_TILE_CACHE_BYTES = 64u * 1024u * 1024u;
+
+    int tileWidth;
+    int tileHeight;
+    size_t tileCacheMaxBytes;
+    mutable size_t tileCacheBytes;
+    mutable std::list<DepthTile> depthTiles;   // Most recently used first
+    mutable std::unordered_map<int64_t, std::list<DepthTile>::iterator> depthTileIndex;
+    mutable std::mutex depthTileMutex;
+
+    // GDAL datasets are not thread-safe: every RasterIO/BuildOverviews on
+    // the band goes through this lock (taken after depthTileMutex)
+    mutable std::mutex rasterMutex;
+
+    // Cached or freshly read tile (caller holds depthTileMutex); nullptr on read error
+    const DepthTile* FetchDepthTile(int tileCol, int tileRow) const;
+    void InitDepthTiles();
+    void ClearDepthTiles();
+
     bool InitInverseGeoTransform();
 
     void GeoToPixelCont(double lon, double lat, double& pixelX, double& pixelY) const;
@@ -54,8 +93,67 @@ public:
         BoundingBox& expandedROI
     ) const;
 
+    // Pixel-snapped, margin-expanded ROI that ExtractROI would read (no raster I/O)
+    bool ExpandROI(
+        const BoundingBox& baseROI,
+        int pixelMargin,
+        BoundingBox& expandedROI,
+        PixelWindow* pixelWindowOut = nullptr
+    ) const;
+
+    // Raw pixel window read (inclusive window, clamped by the caller).
+    // Columns outside the raster wrap around on a global raster (two reads).
+    bool ReadWindow(
+        const PixelWindow& pixelWindow,
+        std::vector<std::vector<float>>& depths
+    ) const;
+
+    // Rows [firstRow, firstRow + rowCount) of the window (relative to its top),
+    // row-major, pixelWindow.width() floats per row. Lets callers stream a
+    // large window in strips instead of holding it at full resolution.
+    bool ReadWindowRows(
+        const PixelWindow& pixelWindow,
+        int firstRow,
+        int rowCount,
+        std::vector<float>& rows
+    ) const;
+    BoundingBox WindowBounds(const PixelWindow& pixelWindow) const;
+
+    // Block averages of the window computed by GDAL at read time: RasterIO
+    // with GRIORA_Average into an outCols x outRows buffer (row-major). GDAL
+    // reads from the closest finer overview when the dataset has any, so few
+    // full-resolution pixels are touched. The window must not wrap around
+    // the antimeridian; returns false then (use ReadWindowRows instead).
+    bool ReadWindowAveraged(
+        const PixelWindow& pixelWindow,
+        int outRows,
+        int outCols,
+        std::vector<float>& averaged
+    ) const;
+
+    // Builds averaged overviews (external .ovr sidecar next to the GEBCO
+    // file for a read-only dataset) once; later opens pick them up.
+    bool BuildOverviews(const std::vector<int>& factors = { 2, 4, 8, 16, 32, 64 });
+    int GetOverviewCount() const;
+
     float GetDepthAt(double lon, double lat) const;
 
+    // Depths at many points (e.g. every sample of a route). Points are grouped
+    // by GDAL block and each block is read once, then kept in an LRU of
+    // decoded blocks shared with GetDepthAt. Points outside the raster get 0
+    // like GetDepthAt. Returns false if the file is not open or a read fails.
+    bool GetDepthsAt(const double* lons, const double* lats, size_t count, float* depths) const;
+    bool GetDepthsAt(const std::vector<GeoCoordinate>& points, std::vector<float>& depths) const;
+
+    // Decoded block budget (the block being read is always kept)
+    void SetBlockCacheBytes(size_t maxBytes);
+    size_t BlockCacheBytes() const { return tileCacheMaxBytes; }
+
+    // Raster spans 360 degrees of longitude: pixel columns wrap around
+    bool IsGlobal() const {
+        return rasterWidth > 0 && std::abs(std::abs(geoTransform[1]) * rasterWidth - 360.0) < 1e-6;
+    }
+
     int GetWidth() const { return rasterWidth; }
     int GetHeight() const { return rasterHeight; }
 };
\ No newline at end of file
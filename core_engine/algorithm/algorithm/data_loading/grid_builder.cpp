@@ -1,39 +1,115 @@
 #include "grid_builder.h"
+#include "depth_downsample.h"
+#include "polygon_clip.h"
+#include <algorithm>
 #include <iostream>
+#include <mutex>
 #include <gdal_priv.h>
 #include <gdal_alg.h>
 
+namespace {
+
+    // GDAL drivers stay registered while any builder (including the copies
+    // held by tiled grids) is alive; the last one tears them down
+    std::mutex gdalUsersMutex;
+    int gdalUsers = 0;
+
+    void AcquireGdal() {
+        std::lock_guard<std::mutex> lock(gdalUsersMutex);
+        if (gdalUsers++ == 0) {
+            GDALAllRegister();
+        }
+    }
+
+    void ReleaseGdal() {
+        std::lock_guard<std::mutex> lock(gdalUsersMutex);
+        if (--gdalUsers == 0) {
+            GDALDestroyDriverManager();
+        }
+    }
+
+}  // namespace
+
 GridBuilder::GridBuilder()
-    : bathymetryLoaded_(false), coastlineLoaded_(false) {
-    GDALAllRegister();
+    : bathymetryLoaded_(false), coastlineLoaded_(false), shallowDepthM_(15.0)
+    , tiledMemoryBudget_(256u * 1024u * 1024u), gdalDecimation_(false)
+    , coastlineSimplifyCells_(0.0) {
+    AcquireGdal();
+}
+
+GridBuilder::GridBuilder(const GridBuilder& other)
+    : gebcoLoader_(other.gebcoLoader_), gshhsLoader_(other.gshhsLoader_)
+    , bathymetryLoaded_(other.bathymetryLoaded_), coastlineLoaded_(other.coastlineLoaded_)
+    , shallowDepthM_(other.shallowDepthM_), tiledMemoryBudget_(other.tiledMemoryBudget_)
+    , gdalDecimation_(other.gdalDecimation_), coastlineSimplifyCells_(other.coastlineSimplifyCells_) {
+    AcquireGdal();
 }
 
 GridBuilder::~GridBuilder() {
     gebcoLoader_.reset();
     gshhsLoader_.reset();
-    GDALDestroyDriverManager();
+    ReleaseGdal();
 }
 
 bool GridBuilder::LoadBathymetryData(const std::string& path) {
-    gebcoLoader_ = std::make_unique<GebcoLoader>(path);
+    gebcoLoader_ = std::make_shared<GebcoLoader>(path);
     bathymetryLoaded_ = gebcoLoader_->Open();
     return bathymetryLoaded_;
 }
 
+bool GridBuilder::BuildBathymetryOverviews() {
+    if (!bathymetryLoaded_) {
+        return false;
+    }
+    bool built = gebcoLoader_->BuildOverviews();
+    bathymetryLoaded_ = gebcoLoader_->IsOpen();   // Reopened after a successful build
+    return built && bathymetryLoaded_ && gebcoLoader_->GetOverviewCount() > 0;
+}
+
 bool GridBuilder::LoadCoastlineData(const std::string& path) {
-    gshhsLoader_ = std::make_unique<GshhsLoader>(path);
+    gshhsLoader_ = std::make_shared<GshhsLoader>(path);
     coastlineLoaded_ = gshhsLoader_->Open();
     return coastlineLoaded_;
 }
 
-BoundingBox GridBuilder::CalculateBaseROI(const std::vector<GeoCoordinate>& waypoints) {
+BoundingBox GridBuilder::CalculateBaseROI(const std::vector<GeoCoordinate>& waypoints) const {
     return BoundingBox::FromWaypoints(waypoints);
 }
 
+int GridBuilder::CalculatePixelMargin(
+    const BoundingBox& baseROI,
+    double targetCellSizeKm,
+    int marginCells) const
+{
+    auto [blockLat, blockLon] = GridResolution::CalculateBlockSize(
+        baseROI, targetCellSizeKm
+    );
+    return std::max(blockLat, blockLon) * marginCells;
+}
+
+BoundingBox GridBuilder::CalculateExpandedROI(
+    const std::vector<GeoCoordinate>& waypoints,
+    double targetCellSizeKm,
+    int marginCells) const
+{
+    if (!bathymetryLoaded_) {
+        throw std::runtime_error("Data not loaded");
+    }
+
+    BoundingBox baseROI = CalculateBaseROI(waypoints);
+    BoundingBox expandedROI;
+    if (!gebcoLoader_->ExpandROI(baseROI,
+            CalculatePixelMargin(baseROI, targetCellSizeKm, marginCells), expandedROI)) {
+        throw std::runtime_error("Invalid ROI window");
+    }
+    return expandedROI;
+}
+
 NavigableGrid GridBuilder::BuildNavigableGrid(
     const std::vector<GeoCoordinate>& waypoints,
     double targetCellSizeKm,
-    int marginCells)
+    int marginCells,
+    bool equalDistance)
 {
     if (!bathymetryLoaded_ || !coastlineLoaded_) {
         throw std::runtime_error("Data not loaded");
@@ -48,33 +124,36 @@ NavigableGrid GridBuilder::BuildNavigableGrid(
 //         << "], lon: [" << baseROI.minLon << ", " << baseROI.maxLon << "]\n";
 // #endif
 
-    // Step 2: Calculate block size
-    auto [blockLat, blockLon] = GridResolution::CalculateBlockSize(
-        baseROI, targetCellSizeKm
-    );
-
-    // Step 3: Calculate pixel margin
-    int pixelMargin = std::max(blockLat, blockLon) * marginCells;
-
-// #ifdef _DEBUG
-//     std::cout << "  - Margin: " << marginCells << " cells x "
-//         << std::max(blockLat, blockLon) << " pixels/cell = "
-//         << pixelMargin << " pixels\n";
-// #endif
+    // Step 2-3: Calculate block size and pixel margin
+    int pixelMargin = CalculatePixelMargin(baseROI, targetCellSizeKm, marginCells);
 
-    // Step 4: Extract GEBCO data
-    std::vector<std::vector<float>> depths;
-    double latStepGeo, lonStepGeo;
+    // Step 4: GEBCO pixel window (read in blockLat strips while downsampling)
+    PixelWindow window;
     BoundingBox expandedROI;
-    
-    if (!gebcoLoader_->ExtractROI(baseROI, depths, latStepGeo, lonStepGeo, 
-                                   pixelMargin, expandedROI)) {
+    if (!gebcoLoader_->ExpandROI(baseROI, pixelMargin, expandedROI, &window)) {
         throw std::runtime_error("Failed to extract GEBCO data");
     }
 
+    // Too large for a flat grid: build tiles lazily instead of clamping the size
+    {
+        auto [blockLat, blockLon] = GridResolution::CalculateBlockSize(expandedROI, targetCellSizeKm);
+        int rows = window.height() / blockLat;
+        int cols = window.width() / blockLon;
+        if (rows > GridResolution::MAX_GRID_SIZE || cols > GridResolution::MAX_GRID_SIZE) {
+            std::cout << "[GridBuilder] " << rows << "x" << cols
+                      << " cells exceeds " << GridResolution::MAX_GRID_SIZE
+                      << ", building tiled grid" << std::endl;
+            if (equalDistance) {
+                std::cout << "[GridBuilder] Equal-distance layout not supported for tiled grids" << std::endl;
+            }
+            return BuildTiledGrid(window, blockLat, blockLon);
+        }
+    }
+
 // #ifdef _DEBUG
-//     std::cout << "  - GEBCO: " << depths.size() << "x"
-//         << (depths.empty() ? 0 : depths[0].size()) << "\n";
+//     std::cout << "  - Margin: " << marginCells << " cells x "
+//         << std::max(blockLat, blockLon) << " pixels/cell = "
+//         << pixelMargin << " pixels\n";
 // #endif
 
     // Step 5: Extract GSHHS polygons
@@ -84,20 +163,25 @@ NavigableGrid GridBuilder::BuildNavigableGrid(
 //     std::cout << "  - GSHHS: " << polygons.size() << " polygons\n";
 // #endif
 
+    if (equalDistance) {
+        NavigableGrid grid = BuildEqualDistanceGrid(expandedROI, window, polygons, targetCellSizeKm);
+        BuildSearchLayers(grid);
+        return grid;
+    }
+
     // Step 6: Calculate grid resolution
     auto gridRes = GridResolution::Calculate(
         expandedROI,
-        static_cast<int>(depths.size()),
-        static_cast<int>(depths.empty() ? 0 : depths[0].size()),
+        window.height(),
+        window.width(),
         targetCellSizeKm
     );
 
     // Step 7: Create grid
     NavigableGrid grid(expandedROI, gridRes.rows, gridRes.cols);
 
-    // Step 8: Downsample depths
-    auto downsampled = DownsampleDepths(depths, gridRes.rows, gridRes.cols, 
-                                        gridRes.blockLat, gridRes.blockLon);
+    // Step 8: Downsample depths (streamed: one strip of GEBCO rows at a time)
+    auto downsampled = DownsampleWindow(window, gridRes);
 
     // Step 9: Rasterize GSHHS
     auto landMask = RasterizeGSHHS_GDAL(polygons, grid);
@@ -105,83 +189,208 @@ NavigableGrid GridBuilder::BuildNavigableGrid(
     // Step 10: Apply masks
     BuildMask(grid, downsampled, landMask);
 
+    // Step 11: Search layers
+    BuildSearchLayers(grid);
+
     return grid;
 }
 
-// ========== 여기서부터 기존 navigable_grid.cpp 코드를 복사 ==========
+NavigableGrid GridBuilder::BuildEqualDistanceGrid(
+    const BoundingBox& expandedROI,
+    const PixelWindow& window,
+    const std::vector<GSHHSPolygonRef>& polygons,
+    double targetCellSizeKm)
+{
+    if (window.width() <= 0 || window.height() <= 0) {
+        throw std::runtime_error("BuildEqualDistanceGrid: empty GEBCO window");
+    }
+
+    auto res = GridResolution::CalculateEqualDistance(expandedROI, window.height(), window.width(), targetCellSizeKm);
+
+    // Per-row downsampling: row r averages blockLat x rowBlockLon[r] pixels
+    // (same edge clipping as DownsampleDepthGrid); padding cells stay 0
+    auto downsampled = DownsampleWindow(window, res);
+
+    // Coastlines are rasterised once at the finest row's resolution; a cell is
+    // land if any fine cell its longitude span overlaps is land (ALL_TOUCHED)
+    NavigableGrid fine(expandedROI, res.rows, res.cols);
+    auto fineMask = RasterizeGSHHS_GDAL(polygons, fine);
+
+    std::vector<std::vector<bool>> landMask(res.rows, std::vector<bool>(res.cols, false));
+    for (int r = 0; r < res.rows; ++r) {
+        const int64_t rowCols = res.rowCols[r];
+        for (int c = 0; c < rowCols; ++c) {
+            int first = static_cast<int>(c * res.cols / rowCols);
+            int last = static_cast<int>(((c + 1) * int64_t(res.cols) + rowCols - 1) / rowCols) - 1;
+            last = std::min(last, res.cols - 1);
+            for (int f = first; f <= last && !landMask[r][c]; ++f) {
+                landMask[r][c] = fineMask[r][f];
+            }
+        }
+    }
+
+    NavigableGrid grid(expandedROI, res.rows, res.cols);
+    BuildMask(grid, downsampled, landMask);
+
+    for (int r = 0; r < res.rows; ++r) {
+        for (int c = res.rowCols[r]; c < res.cols; ++c) {
+            grid.SetCellType(r, c, CellType::UNKNOWN);
+        }
+    }
+    grid.SetRowLayout(res.rowCols);
+
+    size_t activeCells = 0;
+    for (int n : res.rowCols) activeCells += n;
+    std::cout << "[GridBuilder] Equal-distance grid: " << res.rows << " rows, "
+              << *std::min_element(res.rowCols.begin(), res.rowCols.end()) << ".."
+              << res.cols << " cols/row, "
+              << activeCells << " cells (" << res.rows << "x" << res.cols << " storage)" << std::endl;
+    return grid;
+}
+
+void GridBuilder::BuildSearchLayers(NavigableGrid& grid) {
+    // Neighbour mask layer for the search engines
+    grid.BuildNeighborMasks();
+
+    // Distance fields (snapping, distance from coast); 8 bytes per cell,
+    // skipped on very large grids where the snapper falls back to its local search
+    const size_t MAX_DISTANCE_FIELD_CELLS = 16u * 1024u * 1024u;
+    if (static_cast<size_t>(grid.Rows()) * static_cast<size_t>(grid.Cols()) <= MAX_DISTANCE_FIELD_CELLS) {
+        grid.BuildDistanceFields();
+    }
+
+    // Connected components: unreachable legs are rejected before searching
+    grid.BuildComponents();
+}
 
-std::vector<std::vector<float>> GridBuilder::DownsampleDepths(
-    const std::vector<std::vector<float>>& originalDepths,
-    int targetRows,
-    int targetCols,
+NavigableGrid GridBuilder::BuildTiledGrid(
+    const PixelWindow& pixelWindow,
     int blockLat,
     int blockLon)
 {
-    // --- Basic validation ---
-    if (originalDepths.empty() || originalDepths[0].empty())
-        throw std::runtime_error("DownsampleDepths: empty input depths");
-    if (blockLat <= 0 || blockLon <= 0)
-        throw std::invalid_argument("DownsampleDepths: blockLat/blockLon must be positive");
-
-    const int srcRows = static_cast<int>(originalDepths.size());
-    const int srcCols = static_cast<int>(originalDepths[0].size());
+    int rows = pixelWindow.height() / blockLat;
+    int cols = pixelWindow.width() / blockLon;
+
+    PixelWindow window = pixelWindow;
+    window.bottomRow = window.topRow + rows * blockLat - 1;
+    window.rightCol = window.leftCol + cols * blockLon - 1;
+    BoundingBox bounds = gebcoLoader_->WindowBounds(window);
+
+    // Tiles load through a copy sharing the GEBCO/GSHHS sources: copies of
+    // the grid (caches, replanning) may outlive this builder
+    auto source = std::make_shared<GridBuilder>(*this);
+    GridTileLoader loader = [source, window, blockLat, blockLon](
+        int firstRow, int firstCol, int tileRows, int tileCols, std::vector<uint8_t>& cells)
+    {
+        PixelWindow tileWindow{
+            window.leftCol + firstCol * blockLon,
+            window.topRow + firstRow * blockLat,
+            window.leftCol + (firstCol + tileCols) * blockLon - 1,
+            window.topRow + (firstRow + tileRows) * blockLat - 1
+        };
+        NavigableGrid tile = source->BuildGridForWindow(tileWindow, blockLat, blockLon);
+
+        cells.resize(static_cast<size_t>(tileRows) * tileCols);
+        for (int r = 0; r < tileRows; ++r) {
+            for (int c = 0; c < tileCols; ++c) {
+                cells[static_cast<size_t>(r) * tileCols + c] =
+                    static_cast<uint8_t>(tile.GetCellType(r, c));
+            }
+        }
+    };
 
-    // --- Calculate recommended targetRows/Cols based on block (always downsample) ---
-    const int expectedRows = std::max(1, srcRows / blockLat);
-    const int expectedCols = std::max(1, srcCols / blockLon);
+    return NavigableGrid::Tiled(bounds, rows, cols, TILE_SIZE, tiledMemoryBudget_, std::move(loader));
+}
 
-    // If requested targetRows/Cols are different, adjust (clamp) to block-based values
-    if (targetRows != expectedRows || targetCols != expectedCols) {
-        std::cout << "[Downsample] Adjust grid size to block-aligned:"
-            << " requested " << targetRows << "x" << targetCols
-            << " -> " << expectedRows << "x" << expectedCols << "\n";
-        targetRows = expectedRows;
-        targetCols = expectedCols;
+NavigableGrid GridBuilder::BuildGridForWindow(
+    const PixelWindow& pixelWindow,
+    int blockLat,
+    int blockLon,
+    std::vector<float>* depthsOut)
+{
+    if (!bathymetryLoaded_ || !coastlineLoaded_) {
+        throw std::runtime_error("Data not loaded");
+    }
+    if (blockLat <= 0 || blockLon <= 0) {
+        throw std::invalid_argument("BuildGridForWindow: blockLat/blockLon must be positive");
     }
 
-    // Prevent upsampling: if block is larger than source but target is larger, throw exception
-    if (targetRows > srcRows || targetCols > srcCols) {
-        throw std::runtime_error("DownsampleDepths: upsampling detected; grid exceeds source pixels");
+    // Trim to whole blocks so the grid bounds match its cells exactly
+    int rows = pixelWindow.height() / blockLat;
+    int cols = pixelWindow.width() / blockLon;
+    if (rows <= 0 || cols <= 0) {
+        throw std::invalid_argument("BuildGridForWindow: window smaller than one block");
     }
+    PixelWindow window = pixelWindow;
+    window.bottomRow = window.topRow + rows * blockLat - 1;
+    window.rightCol = window.leftCol + cols * blockLon - 1;
 
-    std::vector<std::vector<float>> downsampled(
-        targetRows, std::vector<float>(targetCols, 0.0f)
-    );
+    BoundingBox bounds = gebcoLoader_->WindowBounds(window);
+    auto polygons = gshhsLoader_->ExtractROI(bounds);
 
-// #ifdef _DEBUG
-//     std::cout << "[Downsampling] " << srcRows << "x" << srcCols
-//         << " -> " << targetRows << "x" << targetCols << "\n";
-// #endif
+    GridResolution res{};
+    res.blockLat = blockLat;
+    res.blockLon = blockLon;
+    res.rows = rows;
+    res.cols = cols;
 
-    for (int dstRow = 0; dstRow < targetRows; ++dstRow) {
-        // Source range covered by this output row (row start/end, end is exclusive)
-        const int srcRowStart = dstRow * blockLat;
-        const int srcRowEnd = std::min(srcRowStart + blockLat, srcRows);
+    NavigableGrid grid(bounds, rows, cols);
+    auto downsampled = DownsampleWindow(window, res);
+    auto landMask = RasterizeGSHHS_GDAL(polygons, grid);
+    BuildMask(grid, downsampled, landMask);
 
-        for (int dstCol = 0; dstCol < targetCols; ++dstCol) {
-            const int srcColStart = dstCol * blockLon;
-            const int srcColEnd = std::min(srcColStart + blockLon, srcCols);
+    if (depthsOut) {
+        depthsOut->resize(static_cast<size_t>(rows) * cols);
+        for (int r = 0; r < rows; ++r) {
+            std::copy(downsampled[r].begin(), downsampled[r].end(),
+                depthsOut->begin() + static_cast<size_t>(r) * cols);
+        }
+    }
+    return grid;
+}
 
-            double sum = 0.0;
-            int count = 0;
+// ========== 여기서부터 기존 navigable_grid.cpp 코드를 복사 ==========
 
-            // Average of blockLat × blockLon (including edge clipping)
-            for (int r = srcRowStart; r < srcRowEnd; ++r) {
-                const auto& row = originalDepths[r];
-                for (int c = srcColStart; c < srcColEnd; ++c) {
-                    sum += row[c];
-                    ++count;
-                }
+std::vector<std::vector<float>> GridBuilder::DownsampleWindow(
+    const PixelWindow& window,
+    const GridResolution& res)
+{
+    if (res.blockLat <= 0 || res.blockLon <= 0 || res.rows <= 0 || res.cols <= 0)
+        throw std::invalid_argument("DownsampleWindow: invalid grid resolution");
+
+    const int srcRows = window.height();
+    const int srcCols = window.width();
+    const bool perRow = !res.rowBlockLon.empty();
+
+    // GDAL-side averaging (overviews if present): whole blocks only, one block size
+    if (gdalDecimation_ && !perRow &&
+        res.rows * res.blockLat <= srcRows && res.cols * res.blockLon <= srcCols) {
+        PixelWindow blocks = window;
+        blocks.bottomRow = window.topRow + res.rows * res.blockLat - 1;
+        blocks.rightCol = window.leftCol + res.cols * res.blockLon - 1;
+
+        std::vector<float> averaged;
+        if (gebcoLoader_->ReadWindowAveraged(blocks, res.rows, res.cols, averaged)) {
+            std::vector<std::vector<float>> downsampled(res.rows);
+            for (int r = 0; r < res.rows; ++r) {
+                downsampled[r].assign(averaged.begin() + static_cast<size_t>(r) * res.cols,
+                                      averaged.begin() + static_cast<size_t>(r + 1) * res.cols);
             }
-
-            downsampled[dstRow][dstCol] = (count > 0) ? static_cast<float>(sum / count) : 0.0f;
+            return downsampled;
         }
+        // Wrapped window or read error: strip path below
     }
-    return downsampled;
+
+    // Strips of whole blockLat rows averaged as they are read
+    return DownsampleStrips(srcRows, srcCols, res, [&](int first, int count, std::vector<float>& strip) {
+        if (!gebcoLoader_->ReadWindowRows(window, first, count, strip)) {
+            throw std::runtime_error("Failed to read GEBCO window");
+        }
+    });
 }
 
 std::vector<std::vector<bool>> GridBuilder::RasterizeGSHHS_GDAL(
-    const std::vector<GSHHSPolygon>& polygons,
+    const std::vector<GSHHSPolygonRef>& polygons,
     const NavigableGrid& grid)
 {
     int rows = grid.Rows();
@@ -234,17 +443,33 @@ std::vector<std::vector<bool>> GridBuilder::RasterizeGSHHS_GDAL(
         return {};
     }
 
-    // 4) Convert GSHHS polygons to OGR Features and insert into layer
+    // 4) Convert GSHHS polygons to OGR Features and insert into layer.
+    // Rings are clipped to the grid plus two cells first: continent-sized
+    // rings shrink to the part over the ROI, and the edges the clipper adds
+    // along the clip box lie outside the raster (ALL_TOUCHED never sees them)
+    const double cellLonDeg = geoBounds.Width() / cols;
+    const double cellLatDeg = geoBounds.Height() / rows;
+    const BoundingBox clipBox(
+        geoBounds.minLat - 2.0 * cellLatDeg, geoBounds.maxLat + 2.0 * cellLatDeg,
+        geoBounds.minLon - 2.0 * cellLonDeg, geoBounds.maxLon + 2.0 * cellLonDeg);
+
     int landCount = 0;
-    for (const auto& gshhsPoly : polygons) {
+    for (const auto& ref : polygons) {
+        const GSHHSPolygon& gshhsPoly = *ref.polygon;
         if (gshhsPoly.level != 1) continue;  // level 1 = land
         if (gshhsPoly.points.size() < 3) continue;  // Less than a triangle is invalid
 
+        std::vector<GeoCoordinate> clipped = ClipRingToBox(gshhsPoly.points, ref.lonShift, clipBox);
+        if (coastlineSimplifyCells_ > 0.0) {
+            clipped = SimplifyRingCells(clipped, cellLonDeg, cellLatDeg, coastlineSimplifyCells_);
+        }
+        if (clipped.size() < 3) continue;  // Outside the grid
+
         OGRFeature* feature = OGRFeature::CreateFeature(layer->GetLayerDefn());
         OGRPolygon ogrPoly;
         OGRLinearRing ring;
 
-        for (const auto& pt : gshhsPoly.points) {
+        for (const auto& pt : clipped) {
             ring.addPoint(pt.longitude, pt.latitude);
         }
         ring.closeRings();
@@ -357,7 +582,7 @@ void GridBuilder::BuildMask(
             if (depth >= 0.0f) {
                 grid.SetCellType(r, c, CellType::LAND);
             }
-            else if (depth > -15.0f) {
+            else if (depth > -static_cast<float>(shallowDepthM_)) {
                 grid.SetCellType(r, c, CellType::SHALLOW);
             }
             else {
@@ -388,6 +613,15 @@ void GridBuilder::BuildMask(
 //         << gshhsOverwrites << " cells corrected)...\n";
 // #endif
 
+    // Step 3: Keep the depths (int16 dm) so other drafts can reclassify
+    // SHALLOW/NAVIGABLE without a rebuild (NavigableGrid::ApplyDepthThreshold)
+    std::vector<float> flat(static_cast<size_t>(grid.Rows()) * grid.Cols());
+    for (int r = 0; r < grid.Rows(); ++r) {
+        std::copy(downsampledDepths[r].begin(), downsampledDepths[r].begin() + grid.Cols(),
+            flat.begin() + static_cast<size_t>(r) * grid.Cols());
+    }
+    grid.SetDepths(flat);
+
     PrintStatistics(grid);
 }
 
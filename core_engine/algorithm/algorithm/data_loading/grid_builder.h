@@ -10,6 +10,10 @@
 class GridBuilder {
 public:
     GridBuilder();
+    // Shares the loaded GEBCO/GSHHS sources and copies the settings; tiled
+    // grids keep such a copy so their tile loader outlives this builder
+    GridBuilder(const GridBuilder& other);
+    GridBuilder& operator=(const GridBuilder&) = delete;
     ~GridBuilder();
 
     // Data loading
@@ -19,31 +23,118 @@ public:
     bool IsBathymetryLoaded() const { return bathymetryLoaded_; }
     bool IsCoastlineLoaded() const { return coastlineLoaded_; }
     
-    // Main build function
+    // Main build function. equalDistance picks the longitude block size per
+    // row (GeoIndexMapper::SetRowLayout) so cells stay close to
+    // targetCellSizeKm wide at every latitude; ignored for tiled grids.
     NavigableGrid BuildNavigableGrid(
         const std::vector<GeoCoordinate>& waypoints,
         double targetCellSizeKm = 1.0,
-        int marginCells = 3
+        int marginCells = 3,
+        bool equalDistance = false
+    );
+
+    // Grid over a GEBCO pixel window with a fixed block size (offline tiles).
+    // The window is trimmed to whole blocks; no search layers are built.
+    // depthsOut receives the downsampled depths (m), row-major, if non-null.
+    NavigableGrid BuildGridForWindow(
+        const PixelWindow& pixelWindow,
+        int blockLat,
+        int blockLon,
+        std::vector<float>* depthsOut = nullptr
     );
 
+    // Neighbour masks and distance fields used by the search/snapping
+    static void BuildSearchLayers(NavigableGrid& grid);
+
+    int BathymetryWidth() const { return gebcoLoader_ ? gebcoLoader_->GetWidth() : 0; }
+    int BathymetryHeight() const { return gebcoLoader_ ? gebcoLoader_->GetHeight() : 0; }
+    // GEBCO depth at each point in one batched, block-cached read (under-keel checks)
+    bool SampleDepths(const std::vector<GeoCoordinate>& points, std::vector<float>& depths) const {
+        return bathymetryLoaded_ && gebcoLoader_->GetDepthsAt(points, depths);
+    }
+    BoundingBox BathymetryWindowBounds(const PixelWindow& pixelWindow) const {
+        return gebcoLoader_->WindowBounds(pixelWindow);
+    }
+
+    // Expanded ROI BuildNavigableGrid would use for the same arguments (no raster I/O)
+    BoundingBox CalculateExpandedROI(
+        const std::vector<GeoCoordinate>& waypoints,
+        double targetCellSizeKm = 1.0,
+        int marginCells = 3
+    ) const;
+
+    // Tiled grids (ROIs beyond GridResolution::MAX_GRID_SIZE cells per side)
+    void SetTiledMemoryBudget(size_t bytes) { tiledMemoryBudget_ = bytes; }
+    size_t TiledMemoryBudget() const { return tiledMemoryBudget_; }
+
+    // GSHHS polygons intersecting the ROI, shifted into ROI longitudes (empty if not loaded)
+    std::vector<GSHHSPolygonRef> ExtractCoastline(const BoundingBox& roi) const {
+        return gshhsLoader_ ? gshhsLoader_->ExtractROI(roi) : std::vector<GSHHSPolygonRef>();
+    }
+
+    // Let GDAL average GEBCO blocks at read time (RasterIO + GRIORA_Average,
+    // from overviews when present) instead of DownsampleWindow's own
+    // averaging. Regular grids only; equal-distance and wrapped windows keep
+    // the streaming path. Overview levels make cell depths approximate.
+    void SetGdalDecimation(bool enabled) { gdalDecimation_ = enabled; }
+    bool GdalDecimation() const { return gdalDecimation_; }
+
+    // One-time averaged overview sidecar for the loaded GEBCO file
+    bool BuildBathymetryOverviews();
+
+    // Douglas-Peucker tolerance (in cells) for coastline rings after they
+    // are clipped to the grid; 0 (default) rasterises the clipped rings as is
+    void SetCoastlineSimplification(double toleranceCells) { coastlineSimplifyCells_ = toleranceCells; }
+    double CoastlineSimplification() const { return coastlineSimplifyCells_; }
+
+    // Cells shallower than this depth (m) become SHALLOW
+    void SetShallowDepthM(double depthM) { shallowDepthM_ = depthM; }
+    double ShallowDepthM() const { return shallowDepthM_; }
+
 private:
-    std::unique_ptr<GebcoLoader> gebcoLoader_;
-    std::unique_ptr<GshhsLoader> gshhsLoader_;
+    std::shared_ptr<GebcoLoader> gebcoLoader_;
+    std::shared_ptr<GshhsLoader> gshhsLoader_;
 
     bool bathymetryLoaded_;
     bool coastlineLoaded_;
+    double shallowDepthM_;
+    size_t tiledMemoryBudget_;
+    bool gdalDecimation_;
+    double coastlineSimplifyCells_;
+
+    static constexpr int TILE_SIZE = 512;   // Cells per tile side (tiled grids)
 
     // Helper functions (기존 navigable_grid.cpp의 로직들)
-    BoundingBox CalculateBaseROI(const std::vector<GeoCoordinate>& waypoints);
+    BoundingBox CalculateBaseROI(const std::vector<GeoCoordinate>& waypoints) const;
+    // Tiles are built from GEBCO/GSHHS on first access; the grid must not
+    // outlive this builder
+    NavigableGrid BuildTiledGrid(
+        const PixelWindow& pixelWindow,
+        int blockLat,
+        int blockLon
+    );
+
+    NavigableGrid BuildEqualDistanceGrid(
+        const BoundingBox& expandedROI,
+        const PixelWindow& window,
+        const std::vector<GSHHSPolygonRef>& polygons,
+        double targetCellSizeKm
+    );
+
+    int CalculatePixelMargin(const BoundingBox& baseROI, double targetCellSizeKm, int marginCells) const;
 
-    std::vector<std::vector<float>> DownsampleDepths(
-        const std::vector<std::vector<float>>& originalDepths,
-        int targetRows, int targetCols,
-        int blockLat, int blockLon
+    // Block averages of a GEBCO window via DownsampleStrips: strips of whole
+    // blockLat rows are read and averaged straight into the res.rows x
+    // res.cols output (per-row blockLon when res.rowBlockLon is set), so the
+    // window is never held at full resolution. Same edge clipping and
+    // summation order as DownsampleDepthGrid.
+    std::vector<std::vector<float>> DownsampleWindow(
+        const PixelWindow& window,
+        const GridResolution& res
     );
 
     std::vector<std::vector<bool>> RasterizeGSHHS_GDAL(
-        const std::vector<GSHHSPolygon>& polygons,
+        const std::vector<GSHHSPolygonRef>& polygons,
         const NavigableGrid& grid
     );
 
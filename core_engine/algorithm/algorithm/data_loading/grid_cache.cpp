@@ -0,0 +1,118 @@
+#include "grid_cache.h"
+#include <cmath>
+
+GridCache::GridCache(size_t maxBytes)
+    : maxBytes_(maxBytes), bytes_(0) {
+}
+
+GridCache::Key GridCache::MakeKey(
+    const BoundingBox& roi,
+    double cellSizeKm,
+    double shallowDepthM,
+    bool equalDistance)
+{
+    // GEBCO pixels are 1/240 degree; expanded ROIs are snapped to them
+    auto quantise = [](double deg) {
+        return static_cast<int64_t>(std::llround(deg * 240.0));
+    };
+
+    Key key;
+    key.minLat = quantise(roi.minLat);
+    key.maxLat = quantise(roi.maxLat);
+    key.minLon = quantise(roi.minLon);
+    key.maxLon = quantise(roi.maxLon);
+    key.cellSizeMm = static_cast<int64_t>(std::llround(cellSizeKm * 1.0e6));
+    key.shallowDepthMm = static_cast<int64_t>(std::llround(shallowDepthM * 1.0e3));
+    key.equalDistance = equalDistance;
+    return key;
+}
+
+std::shared_ptr<const NavigableGrid> GridCache::Find(
+    const BoundingBox& expandedROI,
+    double cellSizeKm,
+    double shallowDepthM,
+    bool equalDistance)
+{
+    Key key = MakeKey(expandedROI, cellSizeKm, shallowDepthM, equalDistance);
+
+    auto best = entries_.end();
+    bool exact = false;
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->key == key) {
+            best = it;
+            exact = true;
+            break;
+        }
+        if (it->key.SameResolution(key) && it->key.Contains(key)) {
+            if (best == entries_.end() || it->key.Area() < best->key.Area()) {
+                best = it;
+            }
+        }
+    }
+
+    if (best == entries_.end()) {
+        ++stats_.misses;
+        return nullptr;
+    }
+
+    if (exact) ++stats_.hits;
+    else       ++stats_.containmentHits;
+
+    entries_.splice(entries_.begin(), entries_, best);   // Mark most recently used
+    return entries_.front().grid;
+}
+
+void GridCache::Insert(
+    const BoundingBox& expandedROI,
+    double cellSizeKm,
+    double shallowDepthM,
+    std::shared_ptr<const NavigableGrid> grid,
+    bool equalDistance)
+{
+    if (!grid || maxBytes_ == 0) {
+        return;
+    }
+
+    Key key = MakeKey(expandedROI, cellSizeKm, shallowDepthM, equalDistance);
+    for (auto it = entries_.begin(); it != entries_.end(); ++it) {
+        if (it->key == key) {
+            bytes_ -= it->bytes;
+            entries_.erase(it);
+            break;
+        }
+    }
+
+    size_t bytes = grid->MemoryBytes();
+    if (bytes > maxBytes_) {
+        return;   // Would evict everything and still not fit
+    }
+
+    entries_.push_front(Entry{ key, std::move(grid), bytes });
+    bytes_ += bytes;
+    EvictToFit();
+}
+
+void GridCache::EvictToFit() {
+    while (bytes_ > maxBytes_ && !entries_.empty()) {
+        bytes_ -= entries_.back().bytes;
+        entries_.pop_back();
+        ++stats_.evictions;
+    }
+}
+
+void GridCache::SetMaxBytes(size_t maxBytes) {
+    maxBytes_ = maxBytes;
+    EvictToFit();
+}
+
+void GridCache::Clear() {
+    entries_.clear();
+    bytes_ = 0;
+}
+
+GridCacheStats GridCache::Stats() const {
+    GridCacheStats stats = stats_;
+    stats.entries = entries_.size();
+    stats.bytes = bytes_;
+    return stats;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+#pragma once
+#include "../types/geo_types.h"
+#include "../types/grid_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+
+// ===== Grid Cache Statistics =====
+struct GridCacheStats {
+    size_t hits;              // Exact key matches
+    size_t containmentHits;   // Reused a larger cached grid containing the ROI
+    size_t misses;
+    size_t evictions;
+    size_t entries;
+    size_t bytes;
+
+    GridCacheStats()
+        : hits(0), containmentHits(0), misses(0)
+        , evictions(0), entries(0), bytes(0) {
+    }
+};
+
+// ===== LRU Cache of Built Navigable Grids =====
+// Keyed by the expanded ROI quantised to GEBCO pixels (15 arc-second),
+// the cell size, the shallow depth threshold and the row layout. A lookup that misses the
+// exact key reuses the smallest cached grid (same cell size / threshold)
+// whose bounds contain the requested ROI. Entries are evicted least
+// recently used first once the total MemoryBytes() exceeds maxBytes.
+class GridCache {
+public:
+    explicit GridCache(size_t maxBytes = DEFAULT_MAX_BYTES);
+
+    static constexpr size_t DEFAULT_MAX_BYTES = 512u * 1024u * 1024u;
+
+    std::shared_ptr<const NavigableGrid> Find(
+        const BoundingBox& expandedROI,
+        double cellSizeKm,
+        double shallowDepthM,
+        bool equalDistance = false
+    );
+
+    void Insert(
+        const BoundingBox& expandedROI,
+        double cellSizeKm,
+        double shallowDepthM,
+        std::shared_ptr<const NavigableGrid> grid,
+        bool equalDistance = false
+    );
+
+    void SetMaxBytes(size_t maxBytes);   // 0 disables caching
+    size_t MaxBytes() const { return maxBytes_; }
+
+    void Clear();
+    GridCacheStats Stats() const;
+
+private:
+    struct Key {
+        int64_t minLat, maxLat, minLon, maxLon;   // 1/240 degree units
+        int64_t cellSizeMm;
+        int64_t shallowDepthMm;
+        bool equalDistance;                       // Row layout (GeoIndexMapper::SetRowLayout)
+
+        bool operator==(const Key& other) const {
+            return minLat == other.minLat && maxLat == other.maxLat
+                && minLon == other.minLon && maxLon == other.maxLon
+                && SameResolution(other);
+        }
+
+        bool SameResolution(const Key& other) const {
+            return cellSizeMm == other.cellSizeMm && shallowDepthMm == other.shallowDepthMm
+                && equalDistance == other.equalDistance;
+        }
+
+        bool Contains(const Key& other) const {
+            return minLat <= other.minLat && maxLat >= other.maxLat
+                && minLon <= other.minLon && maxLon >= other.maxLon;
+        }
+
+        int64_t Area() const { return (maxLat - minLat) * (maxLon - minLon); }
+    };
+
+    struct Entry {
+        Key key;
+        std::shared_ptr<const NavigableGrid> grid;
+        size_t bytes;
+    };
+
+    static Key MakeKey(const BoundingBox& roi, double cellSizeKm, double shallowDepthM, bool equalDistance);
+    void EvictToFit();
+
+    std::list<Entry> entries_;   // Most recently used first
+    size_t maxBytes_;
+    size_t bytes_;
+    GridCacheStats stats_;
+};
\ No newline at end of file
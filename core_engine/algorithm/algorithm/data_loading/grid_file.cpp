@@ -0,0 +1,303 @@
+#include "grid_file.h"
+#include "mapped_file.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+    constexpr uint64_t SECTION_ALIGN = 64;
+
+    uint64_t AlignUp(uint64_t offset) {
+        return (offset + SECTION_ALIGN - 1) / SECTION_ALIGN * SECTION_ALIGN;
+    }
+
+    constexpr uint64_t FNV_OFFSET = 14695981039346656037ull;
+    constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+    // Lays out the sections at aligned offsets and checksums the payload
+    // as it is written (every section starts on a word boundary)
+    struct SectionWriter {
+        std::ofstream& out;
+        uint64_t pos;
+        uint64_t hash = FNV_OFFSET;
+        uint8_t partial[8] = {};
+        size_t partialBytes = 0;
+
+        void Append(const void* data, size_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < bytes; ++i) {
+                partial[partialBytes++] = p[i];
+                if (partialBytes == sizeof(uint64_t)) {
+                    uint64_t word;
+                    std::memcpy(&word, partial, sizeof(word));
+                    hash = (hash ^ word) * FNV_PRIME;
+                    partialBytes = 0;
+                }
+            }
+            pos += bytes;
+        }
+
+        void Pad(uint64_t to) {
+            static const uint8_t zeros[SECTION_ALIGN] = {};
+            Append(zeros, static_cast<size_t>(to - pos));
+        }
+
+        uint64_t Write(const void* data, size_t bytes) {
+            Pad(AlignUp(pos));
+            uint64_t offset = pos;
+            Append(data, bytes);
+            return offset;
+        }
+
+        void Finish() { Pad(AlignUp(pos)); }
+    };
+
+    bool SectionFits(uint64_t offset, uint64_t bytes, uint64_t fileBytes, bool required) {
+        if (offset == 0) {
+            return !required;
+        }
+        return offset % 8 == 0 && offset >= sizeof(GridFileHeader)
+            && offset <= fileBytes && bytes <= fileBytes - offset;
+    }
+
+}  // namespace
+
+uint64_t GridFile::Checksum(const uint8_t* data, size_t bytes) {
+    uint64_t hash = FNV_OFFSET;
+    size_t words = bytes / sizeof(uint64_t);
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        std::memcpy(&word, data + i * sizeof(uint64_t), sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    for (size_t i = words * sizeof(uint64_t); i < bytes; ++i) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+// ===== Save =====
+bool GridFile::Save(
+    const NavigableGrid& grid,
+    const std::string& path,
+    const GridFileInfo& info)
+{
+    if (grid.IsTiled()) {
+        std::cerr << "[GridFile] Error: Tiled grids cannot be saved" << std::endl;
+        return false;
+    }
+    const int rows = grid.Rows();
+    const int cols = grid.Cols();
+    const size_t count = static_cast<size_t>(rows) * static_cast<size_t>(cols);
+    if (count == 0) {
+        std::cerr << "[GridFile] Error: Empty grid" << std::endl;
+        return false;
+    }
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            std::cerr << "[GridFile] Error: Cannot create " << tmpPath << std::endl;
+            return false;
+        }
+
+        GridFileHeader header{};
+        std::memcpy(header.magic, GridFileFormat::MAGIC, sizeof(header.magic));
+        header.version = GridFileFormat::VERSION;
+        header.headerBytes = sizeof(GridFileHeader);
+        header.minLat = grid.Bounds().minLat;
+        header.maxLat = grid.Bounds().maxLat;
+        header.minLon = grid.Bounds().minLon;
+        header.maxLon = grid.Bounds().maxLon;
+        header.cellSizeKm = info.cellSizeKm;
+        header.shallowDepthM = info.shallowDepthM;
+        header.rows = rows;
+        header.cols = cols;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));   // Rewritten below
+
+        SectionWriter writer{ out, sizeof(GridFileHeader) };
+
+        // Cells (always BYTE on disk) and navigability words
+        std::vector<uint8_t> bytes(count);
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                bytes[static_cast<size_t>(r) * cols + c] = static_cast<uint8_t>(grid.GetCellType(r, c));
+            }
+        }
+        header.cellsOffset = writer.Write(bytes.data(), count);
+        // Always row-major on disk; BLOCKED_8X8 grids are reordered here
+        std::vector<uint64_t> navWords;
+        const uint64_t* navBits = grid.NavigabilityBits();
+        if (!navBits) {
+            navWords.assign((count + 63) / 64, 0);
+            for (size_t i = 0; i < count; ++i) {
+                if (bytes[i] == static_cast<uint8_t>(CellType::NAVIGABLE)) {
+                    navWords[i >> 6] |= uint64_t(1) << (i & 63);
+                }
+            }
+            navBits = navWords.data();
+        }
+        header.navBitsOffset = writer.Write(navBits, (count + 63) / 64 * sizeof(uint64_t));
+
+        if (grid.HasNeighborMasks()) {
+            for (int r = 0; r < rows; ++r) {
+                for (int c = 0; c < cols; ++c) {
+                    bytes[static_cast<size_t>(r) * cols + c] = grid.NeighborMask(r, c);
+                }
+            }
+            header.neighborMasksOffset = writer.Write(bytes.data(), count);
+        }
+
+        if (grid.HasDistanceFields()) {
+            std::vector<int32_t> field(count);
+            auto writeField = [&](GridCoordinate (NavigableGrid::*nearest)(int, int) const) {
+                for (int r = 0; r < rows; ++r) {
+                    for (int c = 0; c < cols; ++c) {
+                        GridCoordinate n = (grid.*nearest)(r, c);
+                        field[static_cast<size_t>(r) * cols + c] =
+                            n.row < 0 ? -1 : static_cast<int32_t>(n.row * cols + n.col);
+                    }
+                }
+                return writer.Write(field.data(), count * sizeof(int32_t));
+            };
+            header.nearestNavigableOffset = writeField(&NavigableGrid::NearestNavigableCell);
+            header.nearestCoastOffset = writeField(&NavigableGrid::NearestCoastCell);
+        }
+
+        if (grid.HasDepths()) {
+            std::vector<int16_t> depthDm(count);
+            for (int r = 0; r < rows; ++r) {
+                for (int c = 0; c < cols; ++c) {
+                    depthDm[static_cast<size_t>(r) * cols + c] =
+                        static_cast<int16_t>(std::lround(grid.DepthM(r, c) * 10.0f));
+                }
+            }
+            header.depthsOffset = writer.Write(depthDm.data(), count * sizeof(int16_t));
+        }
+
+        if (grid.IsEqualDistance()) {
+            std::vector<int32_t> rowCols(rows);
+            for (int r = 0; r < rows; ++r) {
+                rowCols[r] = grid.RowCols(r);
+            }
+            header.rowColsOffset = writer.Write(rowCols.data(), rowCols.size() * sizeof(int32_t));
+        }
+
+        writer.Finish();
+        header.fileBytes = writer.pos;
+        header.checksum = writer.hash;
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.flush();
+        if (!out) {
+            std::cerr << "[GridFile] Error: Write failed for " << tmpPath << std::endl;
+            return false;
+        }
+    }
+
+#ifdef _WIN32
+    std::remove(path.c_str());   // rename() does not replace on Windows
+#endif
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "[GridFile] Error: Cannot rename " << tmpPath << " to " << path << std::endl;
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+
+    std::cout << "[GridFile] Saved " << rows << "x" << cols << " grid to " << path << std::endl;
+    return true;
+}
+
+// ===== Load / Map =====
+bool GridFile::Load(
+    const std::string& path,
+    NavigableGrid& grid,
+    GridFileInfo* info)
+{
+    NavigableGrid mapped;
+    if (!Map(path, mapped, info, true)) {
+        return false;
+    }
+    mapped.MakeWritable();   // Releases the mapping
+    grid = std::move(mapped);
+    return true;
+}
+
+bool GridFile::Map(
+    const std::string& path,
+    NavigableGrid& grid,
+    GridFileInfo* info,
+    bool verifyChecksum)
+{
+    auto file = std::make_shared<MappedFile>();
+    if (!file->Open(path)) {
+        return false;
+    }
+    const uint8_t* data = file->Data();
+    const uint64_t size = file->Size();
+
+    GridFileHeader header;
+    if (size < sizeof(GridFileHeader)) {
+        std::cerr << "[GridFile] Error: Invalid grid file " << path << std::endl;
+        return false;
+    }
+    std::memcpy(&header, data, sizeof(header));
+
+    const uint64_t count = static_cast<uint64_t>(header.rows) * static_cast<uint64_t>(header.cols);
+    bool valid = std::memcmp(header.magic, GridFileFormat::MAGIC, sizeof(header.magic)) == 0
+        && header.version == GridFileFormat::VERSION
+        && header.headerBytes == sizeof(GridFileHeader)
+        && header.fileBytes == size
+        && header.rows > 0 && header.cols > 0
+        && SectionFits(header.cellsOffset, count, size, true)
+        && SectionFits(header.navBitsOffset, (count + 63) / 64 * sizeof(uint64_t), size, true)
+        && SectionFits(header.neighborMasksOffset, count, size, false)
+        && SectionFits(header.nearestNavigableOffset, count * sizeof(int32_t), size, false)
+        && SectionFits(header.nearestCoastOffset, count * sizeof(int32_t), size, false)
+        && SectionFits(header.depthsOffset, count * sizeof(int16_t), size, false)
+        && SectionFits(header.rowColsOffset, static_cast<uint64_t>(header.rows) * sizeof(int32_t), size, false);
+    if (!valid) {
+        std::cerr << "[GridFile] Error: Invalid grid file " << path << std::endl;
+        return false;
+    }
+
+    if (verifyChecksum &&
+        Checksum(data + sizeof(GridFileHeader), size - sizeof(GridFileHeader)) != header.checksum) {
+        std::cerr << "[GridFile] Error: Checksum mismatch in " << path << std::endl;
+        return false;
+    }
+
+    auto at = [data](uint64_t offset) { return offset ? data + offset : nullptr; };
+
+    GridLayerView layers;
+    layers.cells = at(header.cellsOffset);
+    layers.navBits = reinterpret_cast<const uint64_t*>(at(header.navBitsOffset));
+    layers.neighborMasks = at(header.neighborMasksOffset);
+    layers.nearestNavigable = reinterpret_cast<const int32_t*>(at(header.nearestNavigableOffset));
+    layers.nearestCoast = reinterpret_cast<const int32_t*>(at(header.nearestCoastOffset));
+    layers.depthDm = reinterpret_cast<const int16_t*>(at(header.depthsOffset));
+    layers.owner = file;
+
+    std::vector<int> rowCols;
+    if (header.rowColsOffset) {
+        const int32_t* stored = reinterpret_cast<const int32_t*>(data + header.rowColsOffset);
+        rowCols.assign(stored, stored + header.rows);
+    }
+
+    BoundingBox bounds(header.minLat, header.maxLat, header.minLon, header.maxLon);
+    grid = NavigableGrid::ReadOnly(bounds, header.rows, header.cols, std::move(layers), rowCols);
+    if (info) {
+        *info = GridFileInfo(header.cellSizeKm, header.shallowDepthM);
+    }
+
+    std::cout << "[GridFile] Mapped " << path << " (" << header.rows << "x" << header.cols
+              << ", " << (size >> 20) << " MB)" << std::endl;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+#include "../types/geo_types.h"
+#include "../types/grid_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// ===== Grid File Format (little-endian) =====
+// [GridFileHeader]
+// sections at 64-byte aligned offsets (offset 0 = not stored):
+//   cells             rows x cols CellType bytes, row-major
+//   navBits           (rows x cols + 63) / 64 uint64 words (bit i = cell i NAVIGABLE)
+//   neighborMasks     rows x cols bytes (optional)
+//   nearestNavigable  rows x cols int32 cell indices, -1 = none (optional)
+//   nearestCoast      rows x cols int32 cell indices, -1 = none (optional)
+//   depths            rows x cols int16 depths in dm (optional, NavigableGrid depth layer)
+//   rowCols           rows int32 cells per row (equal-distance grids only)
+// checksum: FNV-1a over the 64-bit words following the header
+namespace GridFileFormat {
+    constexpr char MAGIC[8] = { 'L', 'N', 'K', 'N', 'G', 'R', 'I', 'D' };
+    constexpr uint32_t VERSION = 2;   // 2: depth layer stored as int16 dm
+}
+
+#pragma pack(push, 1)
+struct GridFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerBytes;     // sizeof(GridFileHeader)
+    double minLat;
+    double maxLat;
+    double minLon;
+    double maxLon;
+    double cellSizeKm;        // Build parameters (0 = unknown)
+    double shallowDepthM;
+    int32_t rows;
+    int32_t cols;
+    uint64_t cellsOffset;
+    uint64_t navBitsOffset;
+    uint64_t neighborMasksOffset;
+    uint64_t nearestNavigableOffset;
+    uint64_t nearestCoastOffset;
+    uint64_t depthsOffset;
+    uint64_t rowColsOffset;
+    uint64_t fileBytes;
+    uint64_t checksum;
+};
+#pragma pack(pop)
+
+// ===== Build Parameters Stored With a Grid =====
+struct GridFileInfo {
+    double cellSizeKm;
+    double shallowDepthM;
+
+    GridFileInfo() : cellSizeKm(0.0), shallowDepthM(0.0) {}
+    GridFileInfo(double cellSizeKm, double shallowDepthM)
+        : cellSizeKm(cellSizeKm), shallowDepthM(shallowDepthM) {
+    }
+};
+
+// ===== NavigableGrid Persistence =====
+// Grids for recurring lanes are saved once and shared between processes.
+// Map() is zero copy: the returned grid reads the file's pages in place.
+class GridFile {
+public:
+    // Writes to path + ".tmp" and renames, so concurrent readers never see
+    // a partial file. Tiled grids are not supported.
+    static bool Save(
+        const NavigableGrid& grid,
+        const std::string& path,
+        const GridFileInfo& info = GridFileInfo()
+    );
+
+    // Owned, writable copy; the checksum is always verified
+    static bool Load(
+        const std::string& path,
+        NavigableGrid& grid,
+        GridFileInfo* info = nullptr
+    );
+
+    // Read-only grid over the mapped file (NavigableGrid::ReadOnly).
+    // Verifying the checksum reads every page.
+    static bool Map(
+        const std::string& path,
+        NavigableGrid& grid,
+        GridFileInfo* info = nullptr,
+        bool verifyChecksum = false
+    );
+
+    static uint64_t Checksum(const uint8_t* data, size_t bytes);
+};
\ No newline at end of file
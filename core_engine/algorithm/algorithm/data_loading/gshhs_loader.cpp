@@ -1,4 +1,5 @@
 ﻿#include "gshhs_loader.h"
+#include <algorithm>
 #include <iostream>
 
 GshhsLoader::GshhsLoader(const std::string& filepath)
@@ -37,6 +38,7 @@ void GshhsLoader::Close() {
         dataset = nullptr;
     }
     polygons.clear();
+    index.Clear();
 }
 
 bool GshhsLoader::ParseShapefile() {
@@ -65,6 +67,7 @@ bool GshhsLoader::ParseShapefile() {
                 for (int i = 0; i < ring->getNumPoints(); ++i) {
                     poly.points.emplace_back(ring->getY(i), ring->getX(i));
                 }
+                poly.UpdateBounds();
 
                 polygons.push_back(std::move(poly));
             }
@@ -73,36 +76,62 @@ bool GshhsLoader::ParseShapefile() {
         OGRFeature::DestroyFeature(feature);
     }
 
+    std::vector<BoundingBox> bounds;
+    bounds.reserve(polygons.size());
+    for (const auto& poly : polygons) {
+        bounds.push_back(poly.bounds);
+    }
+    index.Build(bounds);
+
     return !polygons.empty();
 }
 
-std::vector<GSHHSPolygon> GshhsLoader::ExtractROI(const BoundingBox& roi) const {
-    std::vector<GSHHSPolygon> result;
-    result.reserve(polygons.size());
-
-    for (const auto& poly : polygons) {
-        if (poly.Intersects(roi)) {
-            result.push_back(poly);
+std::vector<GSHHSPolygonRef> GshhsLoader::ExtractROI(const BoundingBox& roi) const {
+    // ROI across the antimeridian uses continuous longitudes (e.g. 120 ~ 240):
+    // query with the ROI shifted by ±360 as well and return the polygon in ROI longitudes
+    const double shifts[3] = { 0.0, 360.0, -360.0 };
+    std::vector<std::pair<uint32_t, int>> hits;   // (polygon, shift slot)
+    std::vector<uint32_t> found;
+    for (int s = 0; s < 3; ++s) {
+        BoundingBox shifted(roi.minLat, roi.maxLat, roi.minLon - shifts[s], roi.maxLon - shifts[s]);
+        found.clear();
+        index.Query(shifted, found);
+        for (uint32_t i : found) {
+            if (!polygons[i].points.empty()) {
+                hits.emplace_back(i, s);
+            }
         }
     }
+    std::sort(hits.begin(), hits.end());
+
+    std::vector<GSHHSPolygonRef> result;
+    result.reserve(hits.size());
+    for (const auto& [i, s] : hits) {
+        result.push_back({ &polygons[i], shifts[s] });
+    }
 
     //std::cout << "[INFO] Extracted " << result.size() << " polygons in ROI" << std::endl;
     return result;
 }
 
-bool GSHHSPolygon::Intersects(const BoundingBox& roi) const {
-    if (points.empty()) return false;
-
-    double minLat = points[0].latitude, maxLat = points[0].latitude;
-    double minLon = points[0].longitude, maxLon = points[0].longitude;
+void GSHHSPolygon::UpdateBounds() {
+    if (points.empty()) {
+        bounds = BoundingBox();
+        return;
+    }
 
+    bounds = BoundingBox(points[0].latitude, points[0].latitude, points[0].longitude, points[0].longitude);
     for (const auto& pt : points) {
-        minLat = std::min(minLat, pt.latitude);
-        maxLat = std::max(maxLat, pt.latitude);
-        minLon = std::min(minLon, pt.longitude);
-        maxLon = std::max(maxLon, pt.longitude);
+        bounds.minLat = std::min(bounds.minLat, pt.latitude);
+        bounds.maxLat = std::max(bounds.maxLat, pt.latitude);
+        bounds.minLon = std::min(bounds.minLon, pt.longitude);
+        bounds.maxLon = std::max(bounds.maxLon, pt.longitude);
     }
+}
+
+bool GSHHSPolygon::Intersects(const BoundingBox& roi) const {
+    if (points.empty()) return false;
 
-    return !(maxLat < roi.minLat || minLat > roi.maxLat ||
-        maxLon < roi.minLon || minLon > roi.maxLon);
+    return !(bounds.maxLat < roi.minLat || bounds.minLat > roi.maxLat ||
+        bounds.maxLon < roi.minLon || bounds.minLon > roi.maxLon);
 }
\ No newline at end of file
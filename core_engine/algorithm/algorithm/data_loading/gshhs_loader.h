@@ -1,5 +1,6 @@
 #pragma once
 #include "../types/geo_types.h"
+#include "packed_rtree.h"
 #include <vector>
 #include <string>
 #include <gdal_priv.h>
@@ -10,15 +11,26 @@
 struct GSHHSPolygon {
     std::vector<GeoCoordinate> points;
     int level;  // 1=land, 2=lake, 3=island_in_lake, 4=pond_in_island
+    BoundingBox bounds;  // Of points; precomputed at load (UpdateBounds)
 
+    void UpdateBounds();
     bool Intersects(const BoundingBox& roi) const;
 };
 
+// Polygon returned by GshhsLoader::ExtractROI without copying its points:
+// the loader's polygon with longitudes shifted by lonShift (0 or +-360)
+// into the ROI's continuous range. Valid while the loader stays open.
+struct GSHHSPolygonRef {
+    const GSHHSPolygon* polygon;
+    double lonShift;
+};
+
 class GshhsLoader {
 private:
     std::string filepath;
     GDALDataset* dataset;
     std::vector<GSHHSPolygon> polygons;
+    PackedRTree index;   // Over polygon bounds, built at Open()
 
     bool ParseShapefile();
 
@@ -30,7 +42,8 @@ public:
     void Close();
     bool IsOpen() const { return dataset != nullptr; }
 
-    std::vector<GSHHSPolygon> ExtractROI(const BoundingBox& roi) const;
+    // Polygons whose bounds intersect the ROI (R-tree lookup), in polygon order
+    std::vector<GSHHSPolygonRef> ExtractROI(const BoundingBox& roi) const;
 
     size_t GetPolygonCount() const { return polygons.size(); }
 };
\ No newline at end of file
@@ -0,0 +1,34 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// ===== Read-Only Memory-Mapped File =====
+// mmap on POSIX, MapViewOfFile on Windows. Not copyable; hold it in a
+// shared_ptr when several objects read from the mapping.
+class MappedFile {
+public:
+    MappedFile();
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // False (with a message) if the file is missing, empty or cannot be mapped
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return data_ != nullptr; }
+
+    const uint8_t* Data() const { return data_; }
+    size_t Size() const { return size_; }
+
+private:
+    const uint8_t* data_;
+    size_t size_;
+#ifdef _WIN32
+    void* fileHandle_;
+    void* mappingHandle_;
+#else
+    int fd_;
+#endif
+};
\ No newline at end of file
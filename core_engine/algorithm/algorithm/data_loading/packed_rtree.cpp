@@ -0,0 +1,99 @@
+#include "packed_rtree.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+PackedRTree::PackedRTree()
+    : itemCount_(0) {
+}
+
+void PackedRTree::Clear() {
+    itemCount_ = 0;
+    nodes_.clear();
+    items_.clear();
+    levelStart_.clear();
+}
+
+void PackedRTree::Build(const std::vector<BoundingBox>& boxes) {
+    Clear();
+    itemCount_ = boxes.size();
+    if (boxes.empty()) {
+        return;
+    }
+
+    auto centreLon = [&](uint32_t i) { return boxes[i].minLon + boxes[i].maxLon; };
+    auto centreLat = [&](uint32_t i) { return boxes[i].minLat + boxes[i].maxLat; };
+
+    // STR: ceil(sqrt(leaves)) slices of whole leaves, sorted by longitude,
+    // then each slice by latitude
+    items_.resize(boxes.size());
+    std::iota(items_.begin(), items_.end(), 0u);
+    std::sort(items_.begin(), items_.end(), [&](uint32_t a, uint32_t b) {
+        return centreLon(a) < centreLon(b);
+    });
+
+    const size_t leafCount = (boxes.size() + NODE_CAPACITY - 1) / NODE_CAPACITY;
+    const size_t sliceCount = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(leafCount))));
+    const size_t sliceItems = ((leafCount + sliceCount - 1) / sliceCount) * NODE_CAPACITY;
+    for (size_t begin = 0; begin < items_.size(); begin += sliceItems) {
+        size_t end = std::min(begin + sliceItems, items_.size());
+        std::sort(items_.begin() + begin, items_.begin() + end, [&](uint32_t a, uint32_t b) {
+            return centreLat(a) < centreLat(b);
+        });
+    }
+
+    nodes_.reserve(boxes.size() + boxes.size() / (NODE_CAPACITY - 1) + 1);
+    for (uint32_t i : items_) {
+        nodes_.push_back(boxes[i]);
+    }
+
+    // Parent levels: node j covers children [j * NODE_CAPACITY, (j + 1) * NODE_CAPACITY)
+    levelStart_.push_back(0);
+    size_t levelBegin = 0;
+    size_t levelEnd = nodes_.size();
+    while (levelEnd - levelBegin > 1) {
+        levelStart_.push_back(levelEnd);
+        for (size_t child = levelBegin; child < levelEnd; child += NODE_CAPACITY) {
+            BoundingBox box = nodes_[child];
+            size_t last = std::min(child + NODE_CAPACITY, levelEnd);
+            for (size_t c = child + 1; c < last; ++c) {
+                box.minLat = std::min(box.minLat, nodes_[c].minLat);
+                box.maxLat = std::max(box.maxLat, nodes_[c].maxLat);
+                box.minLon = std::min(box.minLon, nodes_[c].minLon);
+                box.maxLon = std::max(box.maxLon, nodes_[c].maxLon);
+            }
+            nodes_.push_back(box);
+        }
+        levelBegin = levelEnd;
+        levelEnd = nodes_.size();
+    }
+    levelStart_.push_back(nodes_.size());
+}
+
+void PackedRTree::Query(const BoundingBox& box, std::vector<uint32_t>& out) const {
+    if (nodes_.empty()) {
+        return;
+    }
+
+    // (level, node index within the level); the root is the single top node
+    std::vector<std::pair<int, size_t>> stack;
+    stack.emplace_back(static_cast<int>(levelStart_.size()) - 2, 0);
+    while (!stack.empty()) {
+        auto [level, index] = stack.back();
+        stack.pop_back();
+        if (!Overlaps(nodes_[levelStart_[level] + index], box)) {
+            continue;
+        }
+        if (level == 0) {
+            out.push_back(items_[index]);
+            continue;
+        }
+
+        const size_t childCount = levelStart_[level] - levelStart_[level - 1];
+        const size_t first = index * NODE_CAPACITY;
+        const size_t last = std::min(first + NODE_CAPACITY, childCount);
+        for (size_t child = first; child < last; ++child) {
+            stack.emplace_back(level - 1, child);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#pragma once
+#include "../types/geo_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===== Packed STR R-Tree over Bounding Boxes =====
+// Static index built once (Sort-Tile-Recursive): items are sorted by box
+// centre longitude into vertical slices, each slice by centre latitude,
+// and packed NODE_CAPACITY to a leaf. Upper levels group consecutive
+// nodes of the level below, so the whole tree is one flat array of boxes
+// with no child pointers.
+class PackedRTree {
+public:
+    static constexpr int NODE_CAPACITY = 16;
+
+    PackedRTree();
+
+    void Build(const std::vector<BoundingBox>& boxes);
+    void Clear();
+
+    // Appends the indices (into the Build input) of every box intersecting
+    // box, boundaries included; order is tree order, not index order
+    void Query(const BoundingBox& box, std::vector<uint32_t>& out) const;
+
+    size_t Size() const { return itemCount_; }
+    bool Empty() const { return itemCount_ == 0; }
+
+private:
+    size_t itemCount_;
+    std::vector<BoundingBox> nodes_;     // Level 0 (items in STR order), then each parent level; root last
+    std::vector<uint32_t> items_;        // Build input index of each level-0 entry
+    std::vector<size_t> levelStart_;     // First node of each level, plus nodes_.size()
+
+    static bool Overlaps(const BoundingBox& a, const BoundingBox& b) {
+        return !(a.maxLat < b.minLat || a.minLat > b.maxLat ||
+            a.maxLon < b.minLon || a.minLon > b.maxLon);
+    }
+};
\ No newline at end of file
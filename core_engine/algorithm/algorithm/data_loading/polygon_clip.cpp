@@ -0,0 +1,147 @@
+#include "polygon_clip.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+
+namespace {
+
+    // One Sutherland-Hodgman pass: keep the side of an axis-aligned line
+    // where inside(p) holds, adding the crossing point of each edge that
+    // enters or leaves it
+    template <typename Inside, typename Crossing>
+    void ClipPass(
+        const std::vector<GeoCoordinate>& in,
+        std::vector<GeoCoordinate>& out,
+        Inside inside,
+        Crossing crossing)
+    {
+        out.clear();
+        if (in.empty()) {
+            return;
+        }
+        GeoCoordinate prev = in.back();
+        bool prevInside = inside(prev);
+        for (const GeoCoordinate& cur : in) {
+            bool curInside = inside(cur);
+            if (curInside != prevInside) {
+                out.push_back(crossing(prev, cur));
+            }
+            if (curInside) {
+                out.push_back(cur);
+            }
+            prev = cur;
+            prevInside = curInside;
+        }
+    }
+
+    GeoCoordinate CrossLongitude(const GeoCoordinate& a, const GeoCoordinate& b, double lon) {
+        double t = (lon - a.longitude) / (b.longitude - a.longitude);
+        return GeoCoordinate(a.latitude + t * (b.latitude - a.latitude), lon);
+    }
+
+    GeoCoordinate CrossLatitude(const GeoCoordinate& a, const GeoCoordinate& b, double lat) {
+        double t = (lat - a.latitude) / (b.latitude - a.latitude);
+        return GeoCoordinate(lat, a.longitude + t * (b.longitude - a.longitude));
+    }
+
+    // Squared distance from p to segment a-b, coordinates already in cells
+    double SegmentDistance2(double px, double py, double ax, double ay, double bx, double by) {
+        double ux = bx - ax, uy = by - ay;
+        double vx = px - ax, vy = py - ay;
+        double len2 = ux * ux + uy * uy;
+        double t = (len2 > 0.0) ? std::clamp((ux * vx + uy * vy) / len2, 0.0, 1.0) : 0.0;
+        double dx = vx - t * ux, dy = vy - t * uy;
+        return dx * dx + dy * dy;
+    }
+
+}  // namespace
+
+std::vector<GeoCoordinate> ClipRingToBox(
+    const std::vector<GeoCoordinate>& ring,
+    double lonShift,
+    const BoundingBox& box)
+{
+    std::vector<GeoCoordinate> current;
+    current.reserve(ring.size());
+    bool allInside = true;
+    for (const GeoCoordinate& pt : ring) {
+        current.emplace_back(pt.latitude, pt.longitude + lonShift);
+        const GeoCoordinate& p = current.back();
+        allInside = allInside && p.latitude >= box.minLat && p.latitude <= box.maxLat
+            && p.longitude >= box.minLon && p.longitude <= box.maxLon;
+    }
+    if (allInside) {
+        return current;
+    }
+
+    std::vector<GeoCoordinate> next;
+    next.reserve(current.size());
+    ClipPass(current, next,
+        [&](const GeoCoordinate& p) { return p.longitude >= box.minLon; },
+        [&](const GeoCoordinate& a, const GeoCoordinate& b) { return CrossLongitude(a, b, box.minLon); });
+    ClipPass(next, current,
+        [&](const GeoCoordinate& p) { return p.longitude <= box.maxLon; },
+        [&](const GeoCoordinate& a, const GeoCoordinate& b) { return CrossLongitude(a, b, box.maxLon); });
+    ClipPass(current, next,
+        [&](const GeoCoordinate& p) { return p.latitude >= box.minLat; },
+        [&](const GeoCoordinate& a, const GeoCoordinate& b) { return CrossLatitude(a, b, box.minLat); });
+    ClipPass(next, current,
+        [&](const GeoCoordinate& p) { return p.latitude <= box.maxLat; },
+        [&](const GeoCoordinate& a, const GeoCoordinate& b) { return CrossLatitude(a, b, box.maxLat); });
+    return current;
+}
+
+std::vector<GeoCoordinate> SimplifyRingCells(
+    const std::vector<GeoCoordinate>& ring,
+    double cellLonDeg,
+    double cellLatDeg,
+    double toleranceCells)
+{
+    size_t n = ring.size();
+    if (toleranceCells <= 0.0 || cellLonDeg <= 0.0 || cellLatDeg <= 0.0 || n <= 4) {
+        return ring;
+    }
+
+    // Cell units: one unit = one cell in each direction
+    std::vector<double> xs(n), ys(n);
+    for (size_t i = 0; i < n; ++i) {
+        xs[i] = ring[i].longitude / cellLonDeg;
+        ys[i] = ring[i].latitude / cellLatDeg;
+    }
+    const double tolerance2 = toleranceCells * toleranceCells;
+
+    // Split the ring at vertex 0 and the vertex farthest from it
+    size_t far = 0;
+    double farDist = -1.0;
+    for (size_t i = 1; i < n; ++i) {
+        double d = SegmentDistance2(xs[i], ys[i], xs[0], ys[0], xs[0], ys[0]);
+        if (d > farDist) { farDist = d; far = i; }
+    }
+
+    std::vector<uint8_t> keep(n, 0);
+    keep[0] = keep[far] = 1;
+    std::vector<std::pair<size_t, size_t>> stack = { { 0, far }, { far, n } };   // n wraps to 0
+    while (!stack.empty()) {
+        auto [i, j] = stack.back();
+        stack.pop_back();
+        const size_t b = j % n;
+        size_t worst = i;
+        double worstDist = tolerance2;
+        for (size_t k = i + 1; k < j; ++k) {
+            double d = SegmentDistance2(xs[k], ys[k], xs[i], ys[i], xs[b], ys[b]);
+            if (d > worstDist) { worstDist = d; worst = k; }
+        }
+        if (worst != i) {
+            keep[worst] = 1;
+            stack.push_back({ i, worst });
+            stack.push_back({ worst, j });
+        }
+    }
+
+    std::vector<GeoCoordinate> out;
+    for (size_t i = 0; i < n; ++i) {
+        if (keep[i]) out.push_back(ring[i]);
+    }
+    return (out.size() >= 3) ? out : ring;
+}
\ No newline at end of file
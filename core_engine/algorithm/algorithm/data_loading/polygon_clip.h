@@ -0,0 +1,28 @@
+#pragma once
+#include "../types/geo_types.h"
+#include <vector>
+
+// ===== Coastline Ring Preparation (before rasterisation) =====
+// Rings are GSHHS exterior rings in lat/lon, open or closed (a repeated
+// closing point is harmless).
+
+// Sutherland-Hodgman clip of a ring, longitudes shifted by lonShift first,
+// against box. Concave rings come out as one ring whose pieces are joined
+// by edges along the box sides, so clip against a box a little larger than
+// the raster: those edges then never touch a cell. Rings entirely inside
+// are only shifted; rings missing the box come back empty.
+std::vector<GeoCoordinate> ClipRingToBox(
+    const std::vector<GeoCoordinate>& ring,
+    double lonShift,
+    const BoundingBox& box
+);
+
+// Douglas-Peucker on a closed ring with the tolerance in grid cells
+// (cellLonDeg x cellLatDeg), so coarse grids drop more vertices. Returns
+// the ring unchanged when fewer than 3 vertices would remain.
+std::vector<GeoCoordinate> SimplifyRingCells(
+    const std::vector<GeoCoordinate>& ring,
+    double cellLonDeg,
+    double cellLatDeg,
+    double toleranceCells
+);
\ No newline at end of file
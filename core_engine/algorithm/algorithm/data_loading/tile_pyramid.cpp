@@ -0,0 +1,377 @@
+#include "tile_pyramid.h"
+#include "grid_builder.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <limits>
+
+namespace {
+
+    size_t TilePayloadBytes(uint32_t tileSize) {
+        size_t cells = static_cast<size_t>(tileSize) * tileSize;
+        return cells * (sizeof(uint8_t) + sizeof(int16_t));
+    }
+
+    int16_t QuantiseDepth(float depthM) {
+        float clamped = std::clamp(depthM,
+            static_cast<float>(std::numeric_limits<int16_t>::min()),
+            static_cast<float>(std::numeric_limits<int16_t>::max()));
+        return static_cast<int16_t>(std::lround(clamped));
+    }
+
+}  // namespace
+
+TilePyramid::TilePyramid()
+    : data_(nullptr), size_(0)
+{
+}
+
+TilePyramid::~TilePyramid() {
+    Close();
+}
+
+// ===== Offline Build =====
+bool TilePyramid::Build(
+    GridBuilder& builder,
+    const std::string& path,
+    const std::vector<double>& levelsKm,
+    int tileSize)
+{
+    if (!builder.IsBathymetryLoaded() || !builder.IsCoastlineLoaded()) {
+        std::cerr << "[TilePyramid] Error: GEBCO/GSHHS data not loaded" << std::endl;
+        return false;
+    }
+    if (levelsKm.empty() || tileSize <= 0) {
+        std::cerr << "[TilePyramid] Error: No levels or invalid tile size" << std::endl;
+        return false;
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "[TilePyramid] Error: Cannot create " << path << std::endl;
+        return false;
+    }
+
+    const int srcWidth = builder.BathymetryWidth();
+    const int srcHeight = builder.BathymetryHeight();
+    PixelWindow full{ 0, 0, srcWidth - 1, srcHeight - 1 };
+    BoundingBox world = builder.BathymetryWindowBounds(full);
+    const double pixDegLat = world.Height() / srcHeight;
+    const double pixDegLon = world.Width() / srcWidth;
+
+    // Header and level table
+    PyramidFileHeader header{};
+    std::memcpy(header.magic, PyramidFormat::MAGIC, sizeof(header.magic));
+    header.version = PyramidFormat::VERSION;
+    header.levelCount = static_cast<uint32_t>(levelsKm.size());
+    header.tileSize = static_cast<uint32_t>(tileSize);
+    header.shallowDepthM = static_cast<float>(builder.ShallowDepthM());
+
+    std::vector<PyramidLevelHeader> levels(levelsKm.size());
+    std::vector<int> blocks(levelsKm.size());
+    uint64_t offset = sizeof(PyramidFileHeader) + levels.size() * sizeof(PyramidLevelHeader);
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        int block = std::max(1, static_cast<int>(std::round(levelsKm[i] / GEBCOConstants::KM_PER_PIXEL_LAT)));
+        // Nearest block dividing the raster width, so a global level wraps
+        // seamlessly across the antimeridian
+        for (int d = 0; d < block; ++d) {
+            if (srcWidth % (block - d) == 0) { block -= d; break; }
+            if (srcWidth % (block + d) == 0) { block += d; break; }
+        }
+        PyramidLevelHeader& lv = levels[i];
+        lv.cellSizeKm = levelsKm[i];
+        lv.originLat = world.maxLat;
+        lv.originLon = world.minLon;
+        lv.cellDegLat = pixDegLat * block;
+        lv.cellDegLon = pixDegLon * block;
+        lv.rows = srcHeight / block;
+        lv.cols = srcWidth / block;
+        lv.tilesY = (lv.rows + tileSize - 1) / tileSize;
+        lv.tilesX = (lv.cols + tileSize - 1) / tileSize;
+        lv.tileTableOffset = offset;
+        offset += static_cast<uint64_t>(lv.tilesY) * lv.tilesX * sizeof(uint64_t);
+        blocks[i] = block;
+    }
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(levels.data()), levels.size() * sizeof(PyramidLevelHeader));
+
+    // Placeholder tile tables, filled in once the tiles are written
+    std::vector<std::vector<uint64_t>> tables(levels.size());
+    for (size_t i = 0; i < levels.size(); ++i) {
+        tables[i].assign(static_cast<size_t>(levels[i].tilesY) * levels[i].tilesX, 0);
+        out.write(reinterpret_cast<const char*>(tables[i].data()), tables[i].size() * sizeof(uint64_t));
+    }
+
+    const size_t tileCells = static_cast<size_t>(tileSize) * tileSize;
+    std::vector<uint8_t> types(tileCells);
+    std::vector<int16_t> depths16(tileCells);
+    std::vector<float> depths;
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        const PyramidLevelHeader& lv = levels[i];
+        const int block = blocks[i];
+        size_t storedTiles = 0;
+
+        std::cout << "[TilePyramid] Level " << i << " (" << lv.cellSizeKm << " km): "
+                  << lv.rows << "x" << lv.cols << " cells, "
+                  << lv.tilesY << "x" << lv.tilesX << " tiles" << std::endl;
+
+        for (int ty = 0; ty < lv.tilesY; ++ty) {
+            for (int tx = 0; tx < lv.tilesX; ++tx) {
+                const int r0 = ty * tileSize;
+                const int c0 = tx * tileSize;
+                const int tileRows = std::min(tileSize, lv.rows - r0);
+                const int tileCols = std::min(tileSize, lv.cols - c0);
+
+                PixelWindow window{
+                    c0 * block, r0 * block,
+                    (c0 + tileCols) * block - 1, (r0 + tileRows) * block - 1
+                };
+                NavigableGrid tile = builder.BuildGridForWindow(window, block, block, &depths);
+
+                std::fill(types.begin(), types.end(), static_cast<uint8_t>(CellType::LAND));
+                std::fill(depths16.begin(), depths16.end(), int16_t(0));
+                bool allLand = true;
+                for (int r = 0; r < tileRows; ++r) {
+                    for (int c = 0; c < tileCols; ++c) {
+                        CellType type = tile.GetCellType(r, c);
+                        size_t idx = static_cast<size_t>(r) * tileSize + c;
+                        types[idx] = static_cast<uint8_t>(type);
+                        depths16[idx] = QuantiseDepth(depths[static_cast<size_t>(r) * tileCols + c]);
+                        allLand = allLand && type == CellType::LAND;
+                    }
+                }
+                if (allLand) {
+                    continue;
+                }
+
+                tables[i][static_cast<size_t>(ty) * lv.tilesX + tx] = static_cast<uint64_t>(out.tellp());
+                out.write(reinterpret_cast<const char*>(types.data()), types.size());
+                out.write(reinterpret_cast<const char*>(depths16.data()), depths16.size() * sizeof(int16_t));
+                ++storedTiles;
+            }
+        }
+
+        std::cout << "  - stored " << storedTiles << " tiles, "
+                  << (tables[i].size() - storedTiles) << " all-land" << std::endl;
+    }
+
+    for (size_t i = 0; i < levels.size(); ++i) {
+        out.seekp(static_cast<std::streamoff>(levels[i].tileTableOffset));
+        out.write(reinterpret_cast<const char*>(tables[i].data()), tables[i].size() * sizeof(uint64_t));
+    }
+
+    if (!out) {
+        std::cerr << "[TilePyramid] Error: Write failed for " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ===== Memory Mapping =====
+bool TilePyramid::Open(const std::string& path) {
+    Close();
+
+    if (!file_.Open(path)) {
+        return false;
+    }
+    data_ = file_.Data();
+    size_ = file_.Size();
+
+    if (!Validate()) {
+        std::cerr << "[TilePyramid] Error: Invalid pyramid file " << path << std::endl;
+        Close();
+        return false;
+    }
+
+    std::cout << "[TilePyramid] Mapped " << path << " (" << LevelCount() << " levels, "
+              << (size_ >> 20) << " MB)" << std::endl;
+    return true;
+}
+
+void TilePyramid::Close() {
+    file_.Close();
+    data_ = nullptr;
+    size_ = 0;
+}
+
+bool TilePyramid::Validate() const {
+    if (size_ < sizeof(PyramidFileHeader)) {
+        return false;
+    }
+    const PyramidFileHeader& header = Header();
+    if (std::memcmp(header.magic, PyramidFormat::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != PyramidFormat::VERSION ||
+        header.tileSize == 0) {
+        return false;
+    }
+
+    uint64_t levelsEnd = sizeof(PyramidFileHeader)
+        + static_cast<uint64_t>(header.levelCount) * sizeof(PyramidLevelHeader);
+    if (levelsEnd > size_) {
+        return false;
+    }
+
+    const size_t payload = TilePayloadBytes(header.tileSize);
+    for (int i = 0; i < LevelCount(); ++i) {
+        const PyramidLevelHeader& lv = Level(i);
+        if (lv.rows <= 0 || lv.cols <= 0 || lv.tilesY <= 0 || lv.tilesX <= 0) {
+            return false;
+        }
+        uint64_t tiles = static_cast<uint64_t>(lv.tilesY) * lv.tilesX;
+        if (lv.tileTableOffset + tiles * sizeof(uint64_t) > size_) {
+            return false;
+        }
+        const uint64_t* table = reinterpret_cast<const uint64_t*>(data_ + lv.tileTableOffset);
+        for (uint64_t t = 0; t < tiles; ++t) {
+            if (table[t] != 0 && table[t] + payload > size_) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+int TilePyramid::LevelCount() const {
+    return data_ ? static_cast<int>(Header().levelCount) : 0;
+}
+
+const PyramidLevelHeader& TilePyramid::Level(int level) const {
+    return reinterpret_cast<const PyramidLevelHeader*>(data_ + sizeof(PyramidFileHeader))[level];
+}
+
+double TilePyramid::ShallowDepthM() const {
+    return data_ ? static_cast<double>(Header().shallowDepthM) : 0.0;
+}
+
+int TilePyramid::FindLevel(double cellSizeKm) const {
+    int best = -1;
+    double bestDiff = 0.0;
+    for (int i = 0; i < LevelCount(); ++i) {
+        double diff = std::abs(Level(i).cellSizeKm - cellSizeKm);
+        if (diff <= 0.1 * cellSizeKm && (best < 0 || diff < bestDiff)) {
+            best = i;
+            bestDiff = diff;
+        }
+    }
+    return best;
+}
+
+bool TilePyramid::Covers(int level, const BoundingBox& roi) const {
+    if (!IsOpen() || level < 0 || level >= LevelCount()) {
+        return false;
+    }
+
+    const PyramidLevelHeader& lv = Level(level);
+    const double minLat = lv.originLat - lv.rows * lv.cellDegLat;
+    if (roi.minLat < minLat || roi.maxLat > lv.originLat) {
+        return false;
+    }
+    // Same wrap test as AssembleGrid: a 360-degree level covers every longitude
+    const bool wrap = std::abs(lv.cols * lv.cellDegLon - 360.0) < 0.5 * lv.cellDegLon;
+    return wrap || (roi.minLon >= lv.originLon && roi.maxLon <= lv.originLon + lv.cols * lv.cellDegLon);
+}
+
+// ===== Grid Assembly =====
+bool TilePyramid::AssembleGrid(
+    int level,
+    const BoundingBox& roi,
+    double shallowDepthM,
+    NavigableGrid& grid,
+    std::vector<int16_t>* depthsOut) const
+{
+    if (!IsOpen() || level < 0 || level >= LevelCount()) {
+        return false;
+    }
+
+    const PyramidLevelHeader& lv = Level(level);
+    const int tileSize = static_cast<int>(Header().tileSize);
+    const size_t tileCells = static_cast<size_t>(tileSize) * tileSize;
+
+    // Level cells covering the ROI; columns wrap on a 360-degree level
+    const bool wrap = std::abs(lv.cols * lv.cellDegLon - 360.0) < 0.5 * lv.cellDegLon;
+    int r0 = static_cast<int>(std::floor((lv.originLat - roi.maxLat) / lv.cellDegLat));
+    int r1 = static_cast<int>(std::ceil((lv.originLat - roi.minLat) / lv.cellDegLat));
+    int c0 = static_cast<int>(std::floor((roi.minLon - lv.originLon) / lv.cellDegLon));
+    int c1 = static_cast<int>(std::ceil((roi.maxLon - lv.originLon) / lv.cellDegLon));
+    r0 = std::clamp(r0, 0, lv.rows);
+    r1 = std::clamp(r1, 0, lv.rows);
+    if (wrap && c1 - c0 < lv.cols) {
+        int shift = static_cast<int>(std::floor(static_cast<double>(c0) / lv.cols)) * lv.cols;
+        c0 -= shift;   // c0 in [0, cols), c1 may pass the antimeridian
+        c1 -= shift;
+    }
+    else {
+        c0 = std::clamp(c0, 0, lv.cols);
+        c1 = std::clamp(c1, 0, lv.cols);
+    }
+    if (r1 <= r0 || c1 <= c0) {
+        return false;
+    }
+
+    const int rows = r1 - r0;
+    const int cols = c1 - c0;
+    BoundingBox bounds(
+        lv.originLat - r1 * lv.cellDegLat,
+        lv.originLat - r0 * lv.cellDegLat,
+        lv.originLon + c0 * lv.cellDegLon,
+        lv.originLon + c1 * lv.cellDegLon
+    );
+    grid = NavigableGrid(bounds, rows, cols);
+    if (depthsOut) {
+        depthsOut->assign(static_cast<size_t>(rows) * cols, 0);
+    }
+
+    const bool reclassify = std::abs(shallowDepthM - ShallowDepthM()) > 1e-6;
+    const uint64_t* table = reinterpret_cast<const uint64_t*>(data_ + lv.tileTableOffset);
+
+    // Copies level columns [srcBegin, srcEnd) to grid column dstBegin onwards
+    auto copyColumns = [&](int srcBegin, int srcEnd, int dstBegin) {
+        for (int ty = r0 / tileSize; ty <= (r1 - 1) / tileSize; ++ty) {
+            for (int tx = srcBegin / tileSize; tx <= (srcEnd - 1) / tileSize; ++tx) {
+                const uint64_t offset = table[static_cast<size_t>(ty) * lv.tilesX + tx];
+                const uint8_t* types = offset ? data_ + offset : nullptr;
+                const int16_t* depths = offset
+                    ? reinterpret_cast<const int16_t*>(data_ + offset + tileCells) : nullptr;
+
+                const int rowBegin = std::max(r0, ty * tileSize);
+                const int rowEnd = std::min(r1, (ty + 1) * tileSize);
+                const int colBegin = std::max(srcBegin, tx * tileSize);
+                const int colEnd = std::min(srcEnd, (tx + 1) * tileSize);
+
+                for (int r = rowBegin; r < rowEnd; ++r) {
+                    for (int c = colBegin; c < colEnd; ++c) {
+                        const int dstCol = dstBegin + (c - srcBegin);
+                        if (!types) {
+                            grid.SetCellType(r - r0, dstCol, CellType::LAND);
+                            continue;
+                        }
+
+                        size_t idx = static_cast<size_t>(r - ty * tileSize) * tileSize + (c - tx * tileSize);
+                        CellType type = static_cast<CellType>(types[idx]);
+                        if (reclassify && type != CellType::LAND) {
+                            type = depths[idx] > -shallowDepthM ? CellType::SHALLOW : CellType::NAVIGABLE;
+                        }
+                        grid.SetCellType(r - r0, dstCol, type);
+                        if (depthsOut) {
+                            (*depthsOut)[static_cast<size_t>(r - r0) * cols + dstCol] = depths[idx];
+                        }
+                    }
+                }
+            }
+        }
+    };
+
+    // Split at the antimeridian (level column 0)
+    for (int c = c0; c < c1; ) {
+        int srcCol = c % lv.cols;
+        int width = std::min(c1 - c, lv.cols - srcCol);
+        copyColumns(srcCol, srcCol + width, c - c0);
+        c += width;
+    }
+    return true;
+}
\ No newline at end of file
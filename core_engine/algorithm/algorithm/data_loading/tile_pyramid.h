@@ -0,0 +1,100 @@
+#pragma once
+#include "gebco_loader.h"
+#include "mapped_file.h"
+#include "../types/geo_types.h"
+#include "../types/grid_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class GridBuilder;
+
+// ===== Tile Pyramid File Format (little-endian) =====
+// [PyramidFileHeader]
+// [PyramidLevelHeader x levelCount]
+// per level: uint64 tile offsets [tilesY x tilesX] (0 = all-LAND tile, not stored)
+// per tile:  tileSize^2 CellType bytes, then tileSize^2 int16 depths (m), row-major;
+//            cells past the level edge are LAND
+// Each level is a global equal-angle grid aligned to GEBCO pixels
+// (one cell = block x block pixels).
+namespace PyramidFormat {
+    constexpr char MAGIC[8] = { 'L', 'N', 'K', 'P', 'Y', 'R', 'M', 'D' };
+    constexpr uint32_t VERSION = 1;
+}
+
+#pragma pack(push, 1)
+struct PyramidFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t levelCount;
+    uint32_t tileSize;        // Cells per tile side
+    float shallowDepthM;      // Threshold used for the stored cell types
+};
+
+struct PyramidLevelHeader {
+    double cellSizeKm;        // Nominal cell size (latitude direction)
+    double originLat;         // North edge
+    double originLon;         // West edge
+    double cellDegLat;
+    double cellDegLon;
+    int32_t rows;
+    int32_t cols;
+    int32_t tilesY;
+    int32_t tilesX;
+    uint64_t tileTableOffset;
+};
+#pragma pack(pop)
+
+// ===== Memory-Mapped Navigability/Depth Pyramid =====
+class TilePyramid {
+public:
+    TilePyramid();
+    ~TilePyramid();
+
+    TilePyramid(const TilePyramid&) = delete;
+    TilePyramid& operator=(const TilePyramid&) = delete;
+
+    // Offline build from a GridBuilder with GEBCO/GSHHS loaded
+    static bool Build(
+        GridBuilder& builder,
+        const std::string& path,
+        const std::vector<double>& levelsKm,
+        int tileSize = 128
+    );
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return data_ != nullptr; }
+
+    int LevelCount() const;
+    const PyramidLevelHeader& Level(int level) const;
+    double ShallowDepthM() const;
+
+    // Closest level within 10% of cellSizeKm, or -1
+    int FindLevel(double cellSizeKm) const;
+
+    // The level has cells for the whole roi (AssembleGrid would not clip it)
+    bool Covers(int level, const BoundingBox& roi) const;
+
+    // Copies the level cells covering roi into a new grid (no search layers).
+    // Non-LAND cells are reclassified from the stored depth when shallowDepthM
+    // differs from the file's threshold.
+    bool AssembleGrid(
+        int level,
+        const BoundingBox& roi,
+        double shallowDepthM,
+        NavigableGrid& grid,
+        std::vector<int16_t>* depthsOut = nullptr
+    ) const;
+
+private:
+    MappedFile file_;
+    const uint8_t* data_;   // file_.Data() while open
+    size_t size_;
+
+    const PyramidFileHeader& Header() const {
+        return *reinterpret_cast<const PyramidFileHeader*>(data_);
+    }
+    bool Validate() const;
+};
\ No newline at end of file
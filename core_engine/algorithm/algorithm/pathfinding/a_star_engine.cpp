@@ -1,161 +1,269 @@
 #include "a_star_engine.h"
 #include "path_utils.h"
 #include <queue>
-#include <map>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
 #include <algorithm>
 #include <limits>
 #include <iostream>
 
-PathSearchResult AStarEngine::Search(
-    const NavigableGrid& grid,
-    const GridCoordinate& start,
-    const GridCoordinate& goal,
-    const IRoutePlanner& planner)
-{
+namespace {
     // ================================================================
-    // 1. Validate start and goal
+    // Per-cell search state, keyed by NavigableGrid::CellIndex
     // ================================================================
-    if (!IsValidAndNavigable(grid, start) || !IsValidAndNavigable(grid, goal)) {
-        std::cerr << "[AStarEngine] Error: Start or Goal position is not navigable." << std::endl;
-        return PathSearchResult();
-    }
-    
-    if (start == goal) {
-        PathSearchResult result;
-        result.path = { start };
-        result.total_cost = 0.0;
-        result.total_time_hours = 0.0;
-        return result;
-    }
-    
-    // ================================================================
-    // 2. Initialize A* data structures
-    // ================================================================
-    std::map<GridCoordinate, double> g_scores;
-    g_scores[start] = 0.0;
+
+    // Grids up to this many cell indices get flat arrays (13 bytes/cell);
+    // larger ones fall back to a hash map over the visited cells only.
+    constexpr size_t DENSE_STATE_MAX_CELLS = size_t(1) << 23;
+
+    constexpr uint64_t NO_PARENT = std::numeric_limits<uint64_t>::max();
+
+    // Flat arrays indexed by cell index: neighbours of a BLOCKED_8X8 grid stay
+    // on the same cache lines as the cell itself.
+    class DenseCellStates {
+    public:
+        explicit DenseCellStates(size_t count)
+            : g_(count, std::numeric_limits<double>::infinity())
+            , parent_(count, NO_PARENT32)
+            , closed_(count, 0)
+        {}
+
+        bool IsClosed(uint64_t idx) const { return closed_[idx] != 0; }
+        void Close(uint64_t idx) { closed_[idx] = 1; }
+        double G(uint64_t idx) const { return g_[idx]; }
+
+        void Update(uint64_t idx, double g, uint64_t parent) {
+            g_[idx] = g;
+            parent_[idx] = static_cast<uint32_t>(parent);
+        }
+
+        uint64_t Parent(uint64_t idx) const {
+            return parent_[idx] == NO_PARENT32 ? NO_PARENT : parent_[idx];
+        }
+
+    private:
+        static constexpr uint32_t NO_PARENT32 = std::numeric_limits<uint32_t>::max();
+
+        std::vector<double> g_;
+        std::vector<uint32_t> parent_;
+        std::vector<uint8_t> closed_;
+    };
+
+    // Hash map over visited cells (very large or tiled grids)
+    class HashedCellStates {
+    public:
+        bool IsClosed(uint64_t idx) const {
+            auto it = states_.find(idx);
+            return it != states_.end() && it->second.closed;
+        }
+
+        void Close(uint64_t idx) { states_[idx].closed = true; }
+
+        double G(uint64_t idx) const {
+            auto it = states_.find(idx);
+            return it != states_.end() ? it->second.g : std::numeric_limits<double>::infinity();
+        }
+
+        void Update(uint64_t idx, double g, uint64_t parent) {
+            State& state = states_[idx];
+            state.g = g;
+            state.parent = parent;
+        }
+
+        uint64_t Parent(uint64_t idx) const {
+            auto it = states_.find(idx);
+            return it != states_.end() ? it->second.parent : NO_PARENT;
+        }
+
+    private:
+        struct State {
+            double g = std::numeric_limits<double>::infinity();
+            uint64_t parent = NO_PARENT;
+            bool closed = false;
+        };
+
+        std::unordered_map<uint64_t, State> states_;
+    };
+
+    template <typename CellStates>
+    PathSearchResult SearchWithStates(
+        CellStates& states,
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal,
+        const IRoutePlanner& planner,
+        double upperBound)
+    {
+        // ================================================================
+        // 2. Initialize A* data structures
+        // ================================================================
+        SearchStats stats;
+        const uint64_t start_idx = grid.CellIndex(start);
+        const uint64_t goal_idx = grid.CellIndex(goal);
+        states.Update(start_idx, 0.0, NO_PARENT);
     
-    std::map<GridCoordinate, GridCoordinate> parents;
-    std::map<GridCoordinate, bool> closed_list;
-    std::priority_queue<PathNode, std::vector<PathNode>, ComparePathNode> open_list;
+        std::priority_queue<PathNode, std::vector<PathNode>, ComparePathNode> open_list;
     
-    // ================================================================
-    // 3. Initialize start node
-    // ================================================================
-    double initial_h = planner.ComputeHeuristic(start, goal);
-    PathNode start_node(start, 0.0, initial_h, GridCoordinate(-1, -1), 0.0);
-    open_list.push(start_node);
+        // ================================================================
+        // 3. Initialize start node
+        // ================================================================
+        double initial_h = planner.ComputeHeuristic(start, goal);
+        PathNode start_node(start, 0.0, initial_h, GridCoordinate(-1, -1), 0.0);
+        open_list.push(start_node);
+        ++stats.nodes_pushed;
     
-    // ================================================================
-    // 4. A* main loop
-    // ================================================================
-    while (!open_list.empty()) {
-        PathNode current = open_list.top();
-        open_list.pop();
+        // ================================================================
+        // 4. A* main loop
+        // ================================================================
+        while (!open_list.empty()) {
+            PathNode current = open_list.top();
+            open_list.pop();
         
-        GridCoordinate current_pos = current.pos;
+            GridCoordinate current_pos = current.pos;
+            const uint64_t current_idx = grid.CellIndex(current_pos);
         
-        // Skip if already processed
-        if (closed_list.count(current_pos)) {
-            continue;
-        }
-        
-        // Check if goal reached
-        if (current_pos == goal) {
-            // Reconstruct path
-            std::vector<GridCoordinate> path;
-            GridCoordinate p = goal;
-            
-            while (parents.count(p)) {
-                path.push_back(p);
-                p = parents[p];
+            // Skip if already processed
+            if (states.IsClosed(current_idx)) {
+                continue;
             }
-            path.push_back(start);
-            std::reverse(path.begin(), path.end());
+        
+            // Check if goal reached
+            if (current_idx == goal_idx) {
+                // Reconstruct path
+                std::vector<GridCoordinate> path;
+                for (uint64_t p = goal_idx; p != NO_PARENT; p = states.Parent(p)) {
+                    path.push_back(grid.CellAt(static_cast<size_t>(p)));
+                }
+                std::reverse(path.begin(), path.end());
             
-            // Create result
-            PathSearchResult result;
-            result.path = path;
-            result.total_cost = current.g_cost;
-            result.total_time_hours = current.accumulated_time_hours;
+                // Create result
+                PathSearchResult result;
+                result.path = path;
+                result.total_cost = current.g_cost;
+                result.total_time_hours = current.accumulated_time_hours;
+                result.stats = stats;
             
-            return result;
-        }
+                return result;
+            }
         
-        // Mark as closed
-        closed_list[current_pos] = true;
+            // Mark as closed
+            states.Close(current_idx);
+            ++stats.nodes_expanded;
         
-        double accumulated_time_hours = current.accumulated_time_hours;
+            double accumulated_time_hours = current.accumulated_time_hours;
         
-        // ================================================================
-        // 5. Expand neighbors (8 directions)
-        // ================================================================
-        for (int i = 0; i < 8; ++i) {
-            int new_row = current_pos.row + DX_8DIR[i];
-            int new_col = current_pos.col + DY_8DIR[i];
-            GridCoordinate neighbor_pos(new_row, new_col);
+            // ================================================================
+            // 5. Expand navigable neighbors (set bits of the neighbour mask)
+            // ================================================================
+            uint8_t neighbors = grid.NeighborMask(current_pos.row, current_pos.col);
+            while (neighbors) {
+                int i = PopNeighbor(neighbors);
+                GridCoordinate neighbor_pos = grid.Neighbor(current_pos.row, current_pos.col, i);
+                const uint64_t neighbor_idx = grid.CellIndex(neighbor_pos);
             
-            // Check basic validity
-            if (!IsValidAndNavigable(grid, neighbor_pos)) {
-                continue;
-            }
+                // Skip if already processed
+                if (states.IsClosed(neighbor_idx)) {
+                    continue;
+                }
             
-            // Skip if already processed
-            if (closed_list.count(neighbor_pos)) {
-                continue;
-            }
+                // Check transition validity (angle check, etc.)
+                if (!planner.IsValidTransition(current, neighbor_pos)) {
+                    continue;
+                }
             
-            // Check transition validity (angle check, etc.)
-            if (!planner.IsValidTransition(current, neighbor_pos)) {
-                continue;
-            }
+                // Compute heuristic
+                double h_cost = planner.ComputeHeuristic(neighbor_pos, goal);
             
-            // Compute edge cost
-            EdgeCostResult edge = planner.ComputeEdgeCost(
-                current_pos,
-                neighbor_pos,
-                accumulated_time_hours
-            );
+                // Edge cost >= 0: prune before the (expensive) edge evaluation
+                if (current.g_cost + h_cost > upperBound) {
+                    ++stats.nodes_pruned;
+                    continue;
+                }
             
-            double travel_cost = edge.cost;
-            double time_hours_delta = edge.deltaTimeHours;
-            double new_g_cost = current.g_cost + travel_cost;
+                // Compute edge cost
+                EdgeCostResult edge = planner.ComputeEdgeCost(
+                    current_pos,
+                    neighbor_pos,
+                    accumulated_time_hours
+                );
+                ++stats.edge_evaluations;
             
-            // Check if this is a better path
-            double current_best_g = g_scores.count(neighbor_pos) 
-                ? g_scores[neighbor_pos] 
-                : std::numeric_limits<double>::infinity();
+                double travel_cost = edge.cost;
+                double time_hours_delta = edge.deltaTimeHours;
+                double new_g_cost = current.g_cost + travel_cost;
             
-            if (new_g_cost < current_best_g) {
-                // Update g_score and parent
-                g_scores[neighbor_pos] = new_g_cost;
-                parents[neighbor_pos] = current_pos;
+                // Check if this is a better path
+                if (new_g_cost < states.G(neighbor_idx)) {
+                    // Cannot beat the known feasible path
+                    if (new_g_cost + h_cost > upperBound) {
+                        ++stats.nodes_pruned;
+                        continue;
+                    }
                 
-                // Compute heuristic
-                double h_cost = planner.ComputeHeuristic(neighbor_pos, goal);
+                    // Update g_score and parent
+                    states.Update(neighbor_idx, new_g_cost, current_idx);
                 
-                // Compute accumulated time
-                double neighbor_time_hours = accumulated_time_hours + time_hours_delta;
+                    // Compute accumulated time
+                    double neighbor_time_hours = accumulated_time_hours + time_hours_delta;
                 
-                // Create and push neighbor node
-                PathNode neighbor_node(
-                    neighbor_pos,
-                    new_g_cost,
-                    h_cost,
-                    current_pos,
-                    neighbor_time_hours
-                );
+                    // Create and push neighbor node
+                    PathNode neighbor_node(
+                        neighbor_pos,
+                        new_g_cost,
+                        h_cost,
+                        current_pos,
+                        neighbor_time_hours
+                    );
                 
-                open_list.push(neighbor_node);
+                    open_list.push(neighbor_node);
+                    ++stats.nodes_pushed;
+                }
             }
         }
-    }
     
+        // ================================================================
+        // 6. Path not found
+        // ================================================================
+        std::cerr << "[AStarEngine] Error: Path not found from (" 
+                  << start.row << ", " << start.col << ") to (" 
+                  << goal.row << ", " << goal.col << ")" << std::endl;
+    
+        PathSearchResult result;
+        result.stats = stats;
+        return result;
+    }
+}
+
+PathSearchResult AStarEngine::Search(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal,
+    const IRoutePlanner& planner,
+    double upperBound)
+{
     // ================================================================
-    // 6. Path not found
+    // 1. Validate start and goal
     // ================================================================
-    std::cerr << "[AStarEngine] Error: Path not found from (" 
-              << start.row << ", " << start.col << ") to (" 
-              << goal.row << ", " << goal.col << ")" << std::endl;
+    if (!IsValidAndNavigable(grid, start) || !IsValidAndNavigable(grid, goal)) {
+        std::cerr << "[AStarEngine] Error: Start or Goal position is not navigable." << std::endl;
+        return PathSearchResult();
+    }
     
-    return PathSearchResult();
+    if (start == goal) {
+        PathSearchResult result;
+        result.path = { start };
+        result.total_cost = 0.0;
+        result.total_time_hours = 0.0;
+        return result;
+    }
+    
+    // g / parent / closed are keyed by cell index (not by coordinate)
+    size_t cellCount = grid.CellIndexCount();
+    if (cellCount <= DENSE_STATE_MAX_CELLS) {
+        DenseCellStates states(cellCount);
+        return SearchWithStates(states, grid, start, goal, planner, upperBound);
+    }
+    HashedCellStates states;
+    return SearchWithStates(states, grid, start, goal, planner, upperBound);
 }
\ No newline at end of file
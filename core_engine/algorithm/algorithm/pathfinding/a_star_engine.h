@@ -3,6 +3,7 @@
 #include "path_types.h"
 #include "route_planner.h"
 #include "../types/grid_types.h"
+#include <limits>
 
 /**
  * @class AStarEngine
@@ -20,12 +21,15 @@ public:
      * @param start Start grid coordinate
      * @param goal Goal grid coordinate
      * @param planner Strategy for cost/heuristic computation
+     * @param upperBound Known cost of a feasible path; nodes with f > upperBound
+     *                   are never pushed (infinity = no bound)
      * @return PathSearchResult with path and total cost
      */
     static PathSearchResult Search(
         const NavigableGrid& grid,
         const GridCoordinate& start,
         const GridCoordinate& goal,
-        const IRoutePlanner& planner
+        const IRoutePlanner& planner,
+        double upperBound = std::numeric_limits<double>::infinity()
     );
 };
\ No newline at end of file
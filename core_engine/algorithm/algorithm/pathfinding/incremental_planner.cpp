@@ -0,0 +1,545 @@
+#include "incremental_planner.h"
+#include "path_utils.h"
+#include "../utils/geo_calculations.h"
+#include "../utils/time_calculator.h"
+#include "../utils/fuel_calculator.h"
+#include "../utils/weather_interpolation.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <unordered_set>
+
+namespace {
+    constexpr double INF = std::numeric_limits<double>::infinity();
+}
+
+IncrementalRoutePlanner::StateInfo::StateInfo()
+    : g(INF)
+    , rhs(INF)
+    , key(INF, INF)
+    , inQueue(false)
+{
+}
+
+IncrementalRoutePlanner::IncrementalRoutePlanner(
+    const NavigableGrid& grid,
+    const VoyageInfo& voyageInfo,
+    unsigned int startTimeSec,
+    const std::map<std::string, WeatherDataInput>& weatherData,
+    double shipSpeedMps)
+    : grid_(grid)
+    , costModel_(grid, voyageInfo, startTimeSec, weatherData, shipSpeedMps)
+    , voyageInfoBase_(voyageInfo)
+    , startTimeSec_(startTimeSec)
+    , shipSpeedMps_(shipSpeedMps)
+    , km_(0.0)
+    , startState_(0)
+    , start_(-1, -1)
+    , goal_(-1, -1)
+    , originGeo_(0.0, 0.0)
+    , minFuelRateKgPerHour_(0.0)
+    , hasState_(false)
+    , lastExpansions_(0)
+{
+}
+
+// ================================================================
+// IRoutePlanner Interface
+// ================================================================
+
+PathSearchResult IncrementalRoutePlanner::FindPath(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal)
+{
+    if (!IsValidAndNavigable(grid, start) || !IsValidAndNavigable(grid, goal)) {
+        std::cerr << "[IncrementalPlanner] Error: Start or Goal position is not navigable." << std::endl;
+        hasState_ = false;
+        return PathSearchResult();
+    }
+
+    // Departure times are anchored to the voyage origin
+    originGeo_ = grid.GridToGeo(start);
+
+    // Minimum fuel rate for the heuristic (ideal conditions, same as OptimizedRoutePlanner)
+    VoyageInfo vInfo = voyageInfoBase_;
+    vInfo.heading = calculateBearing(originGeo_, grid.GridToGeo(goal));
+    minFuelRateKgPerHour_ = fuelCalculator_zero(
+        startTimeSec_,
+        originGeo_.latitude,
+        originGeo_.longitude,
+        vInfo
+    );
+
+    Reset(start, goal);
+    ComputeShortestPath();
+    PathSearchResult result = ExtractPath();
+
+    if (result.IsSuccess()) {
+        std::cout << "[IncrementalPlanner] Optimized: " << result.total_cost << " kg, "
+                  << result.total_time_hours << "h (" << lastExpansions_ << " expansions)" << std::endl;
+    } else {
+        std::cerr << "[IncrementalPlanner] Path not found" << std::endl;
+    }
+
+    return result;
+}
+
+EdgeCostResult IncrementalRoutePlanner::ComputeEdgeCost(
+    const GridCoordinate& from,
+    const GridCoordinate& to,
+    double accumulatedTimeHours) const
+{
+    return costModel_.ComputeEdgeCost(from, to, accumulatedTimeHours);
+}
+
+double IncrementalRoutePlanner::ComputeHeuristic(
+    const GridCoordinate& current,
+    const GridCoordinate& goal) const
+{
+    return StateHeuristic(current, goal);
+}
+
+bool IncrementalRoutePlanner::IsValidTransition(
+    const PathNode& current_node,
+    const GridCoordinate& neighbor_pos) const
+{
+    return costModel_.IsValidTransition(current_node, neighbor_pos);
+}
+
+// ================================================================
+// Incremental Replanning
+// ================================================================
+
+void IncrementalRoutePlanner::NotifyWeatherChanged(const std::vector<WeatherChangeRegion>& regions)
+{
+    if (regions.empty()) {
+        return;
+    }
+
+    for (const auto& region : regions) {
+        if (region.global) {
+            // Layout changed: every cached edge is stale (full replan from the vessel)
+            edgeCosts_.clear();
+            if (hasState_) {
+                Reset(start_, goal_);
+            }
+            return;
+        }
+    }
+
+    if (!hasState_) {
+        edgeCosts_.clear();
+        return;
+    }
+
+    const BoundingBox& bounds = grid_.Bounds();
+    const double cellLat = grid_.CellSizeLat();
+    const double cellLon = grid_.CellSizeLon();
+
+    std::unordered_set<uint64_t> dirtyCells;
+
+    for (const auto& region : regions) {
+        // Grid rows covering the region (+1 cell: edge midpoints lie half a cell away)
+        if (region.maxLat < bounds.minLat || region.minLat > bounds.maxLat) {
+            continue;
+        }
+        int rowMin = static_cast<int>(std::floor((bounds.maxLat - region.maxLat) / cellLat)) - 1;
+        int rowMax = static_cast<int>(std::floor((bounds.maxLat - region.minLat) / cellLat)) + 1;
+        rowMin = std::clamp(rowMin, 0, grid_.Rows() - 1);
+        rowMax = std::clamp(rowMax, 0, grid_.Rows() - 1);
+
+        // Region longitudes are StartLon-relative; try the grid's 360-degree shifts
+        for (double shift : { -360.0, 0.0, 360.0 }) {
+            double lonLo = region.minLon + shift;
+            double lonHi = region.maxLon + shift;
+            if (lonHi < bounds.minLon || lonLo > bounds.maxLon) {
+                continue;
+            }
+            int colMin = static_cast<int>(std::floor((lonLo - bounds.minLon) / cellLon)) - 1;
+            int colMax = static_cast<int>(std::floor((lonHi - bounds.minLon) / cellLon)) + 1;
+            colMin = std::clamp(colMin, 0, grid_.Cols() - 1);
+            colMax = std::clamp(colMax, 0, grid_.Cols() - 1);
+
+            for (int r = rowMin; r <= rowMax; ++r) {
+                for (int c = colMin; c <= colMax; ++c) {
+                    GridCoordinate from(r, c);
+                    uint64_t cellIdx = grid_.CellIndex(r, c);
+
+                    for (int dir = 0; dir < 8; ++dir) {
+                        auto it = edgeCosts_.find(cellIdx * 8 + dir);
+                        if (it == edgeCosts_.end()) {
+                            continue;
+                        }
+
+                        // Same lookup point/time as OptimizedRoutePlanner::ComputeEdgeCost
+                        GeoCoordinate fromGeo = grid_.GridToGeo(from);
+                        GeoCoordinate toGeo = grid_.GridToGeo(r + DX_8DIR[dir], c + DY_8DIR[dir]);
+                        double midLat = (fromGeo.latitude + toGeo.latitude) / 2.0;
+                        double midLon = (fromGeo.longitude + toGeo.longitude) / 2.0;
+                        unsigned int midTimeSec = startTimeSec_ + static_cast<unsigned int>(
+                            (DepartureTimeHours(from) + it->second.deltaTimeHours / 2.0) * 3600.0);
+
+                        if (isInWeatherChangeRegion(region, midTimeSec, midLat, midLon)) {
+                            edgeCosts_.erase(it);
+                            dirtyCells.insert(cellIdx);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // States whose outgoing edges changed need their rhs recomputed
+    for (uint64_t cellIdx : dirtyCells) {
+        for (int dir = 0; dir <= NO_DIRECTION; ++dir) {
+            uint64_t state = cellIdx * 9 + dir;
+            if (states_.count(state)) {
+                UpdateVertex(state);
+            }
+        }
+    }
+
+#ifdef _DEBUG
+    std::cout << "[IncrementalPlanner] Weather update: " << dirtyCells.size()
+              << " cells invalidated" << std::endl;
+#endif
+}
+
+PathSearchResult IncrementalRoutePlanner::Replan(const GridCoordinate& vesselPos)
+{
+    if (!hasState_) {
+        std::cerr << "[IncrementalPlanner] Error: No search state to repair." << std::endl;
+        return PathSearchResult();
+    }
+
+    if (!IsValidAndNavigable(grid_, vesselPos)) {
+        std::cerr << "[IncrementalPlanner] Error: Vessel position is not navigable." << std::endl;
+        return PathSearchResult();
+    }
+
+    // Keep the vessel's current heading if it is on the last path
+    int incomingDir = NO_DIRECTION;
+    auto onPath = std::find(lastPath_.begin(), lastPath_.end(), vesselPos);
+    if (onPath != lastPath_.end() && onPath != lastPath_.begin()) {
+        const GridCoordinate& prev = *(onPath - 1);
+        for (int dir = 0; dir < 8; ++dir) {
+            if (prev.row + DX_8DIR[dir] == vesselPos.row && prev.col + DY_8DIR[dir] == vesselPos.col) {
+                incomingDir = dir;
+                break;
+            }
+        }
+    }
+
+    // D* Lite start move: key modifier absorbs the heuristic shift
+    km_ += StateHeuristic(start_, vesselPos);
+    start_ = vesselPos;
+    startState_ = MakeState(vesselPos, incomingDir);
+    UpdateVertex(startState_);
+
+    lastExpansions_ = 0;
+    ComputeShortestPath();
+    PathSearchResult result = ExtractPath();
+
+    if (result.IsSuccess()) {
+        std::cout << "[IncrementalPlanner] Replanned: " << result.total_cost << " kg, "
+                  << result.total_time_hours << "h (" << lastExpansions_ << " expansions)" << std::endl;
+    } else {
+        std::cerr << "[IncrementalPlanner] Replan: path not found" << std::endl;
+    }
+
+    return result;
+}
+
+// ================================================================
+// State helpers
+// ================================================================
+
+uint64_t IncrementalRoutePlanner::MakeState(const GridCoordinate& cell, int dir) const
+{
+    uint64_t cellIdx = grid_.CellIndex(cell);
+    return cellIdx * 9 + static_cast<uint64_t>(dir);
+}
+
+GridCoordinate IncrementalRoutePlanner::StateCell(uint64_t state) const
+{
+    return grid_.CellAt(static_cast<size_t>(state / 9));
+}
+
+int IncrementalRoutePlanner::StateDirection(uint64_t state) const
+{
+    return static_cast<int>(state % 9);
+}
+
+IncrementalRoutePlanner::StateInfo& IncrementalRoutePlanner::Info(uint64_t state)
+{
+    return states_[state];
+}
+
+double IncrementalRoutePlanner::G(uint64_t state) const
+{
+    auto it = states_.find(state);
+    return it != states_.end() ? it->second.g : INF;
+}
+
+double IncrementalRoutePlanner::Rhs(uint64_t state) const
+{
+    auto it = states_.find(state);
+    return it != states_.end() ? it->second.rhs : INF;
+}
+
+// ================================================================
+// D* Lite
+// ================================================================
+
+void IncrementalRoutePlanner::Reset(const GridCoordinate& start, const GridCoordinate& goal)
+{
+    states_.clear();
+    openList_.clear();
+    edgeCosts_.clear();
+    km_ = 0.0;
+    lastExpansions_ = 0;
+
+    start_ = start;
+    goal_ = goal;
+    startState_ = MakeState(start, NO_DIRECTION);
+
+    // Every incoming direction at the goal is a goal state
+    for (int dir = 0; dir <= NO_DIRECTION; ++dir) {
+        uint64_t goalState = MakeState(goal, dir);
+        StateInfo& info = Info(goalState);
+        info.rhs = 0.0;
+        info.key = CalculateKey(goalState);
+        info.inQueue = true;
+        openList_.insert({ info.key, goalState });
+    }
+
+    hasState_ = true;
+}
+
+IncrementalRoutePlanner::Key IncrementalRoutePlanner::CalculateKey(uint64_t state) const
+{
+    double best = std::min(G(state), Rhs(state));
+    return { best + StateHeuristic(start_, StateCell(state)) + km_, best };
+}
+
+double IncrementalRoutePlanner::StateHeuristic(
+    const GridCoordinate& from,
+    const GridCoordinate& to) const
+{
+    GeoCoordinate fromGeo = grid_.GridToGeo(from);
+    GeoCoordinate toGeo = grid_.GridToGeo(to);
+
+    double distKm = greatCircleDistance(
+        fromGeo.latitude, fromGeo.longitude,
+        toGeo.latitude, toGeo.longitude
+    );
+
+    return minFuelRateKgPerHour_ * timeCalculator(distKm, shipSpeedMps_);
+}
+
+void IncrementalRoutePlanner::UpdateVertex(uint64_t state)
+{
+    StateInfo& info = Info(state);
+
+    if (!(StateCell(state) == goal_)) {
+        std::vector<std::pair<uint64_t, double>> successors;
+        GetSuccessors(state, successors);
+
+        double best = INF;
+        for (const auto& [succ, cost] : successors) {
+            best = std::min(best, cost + G(succ));
+        }
+        info.rhs = best;
+    }
+
+    if (info.inQueue) {
+        openList_.erase({ info.key, state });
+        info.inQueue = false;
+    }
+    if (info.g != info.rhs) {
+        info.key = CalculateKey(state);
+        info.inQueue = true;
+        openList_.insert({ info.key, state });
+    }
+}
+
+void IncrementalRoutePlanner::ComputeShortestPath()
+{
+    std::vector<uint64_t> predecessors;
+
+    while (!openList_.empty() &&
+        (openList_.begin()->first < CalculateKey(startState_) ||
+         Rhs(startState_) != G(startState_)))
+    {
+        auto [kOld, state] = *openList_.begin();
+        openList_.erase(openList_.begin());
+        Info(state).inQueue = false;
+        ++lastExpansions_;
+
+        Key kNew = CalculateKey(state);
+        StateInfo& info = Info(state);
+
+        if (kOld < kNew) {
+            info.key = kNew;
+            info.inQueue = true;
+            openList_.insert({ kNew, state });
+            continue;
+        }
+
+        GetPredecessors(state, predecessors);
+
+        if (info.g > info.rhs) {
+            info.g = info.rhs;
+        } else {
+            info.g = INF;
+            UpdateVertex(state);
+        }
+
+        for (uint64_t pred : predecessors) {
+            UpdateVertex(pred);
+        }
+    }
+}
+
+bool IncrementalRoutePlanner::TransitionAllowed(
+    const GridCoordinate& cell,
+    int inDir,
+    int outDir) const
+{
+    PathNode node;
+    node.pos = cell;
+    if (inDir != NO_DIRECTION) {
+        node.parent_pos = GridCoordinate(cell.row - DX_8DIR[inDir], cell.col - DY_8DIR[inDir]);
+    }
+    GridCoordinate next(cell.row + DX_8DIR[outDir], cell.col + DY_8DIR[outDir]);
+    return costModel_.IsValidTransition(node, next);
+}
+
+void IncrementalRoutePlanner::GetSuccessors(
+    uint64_t state,
+    std::vector<std::pair<uint64_t, double>>& out)
+{
+    out.clear();
+    GridCoordinate cell = StateCell(state);
+    int inDir = StateDirection(state);
+
+    uint8_t neighbors = grid_.NeighborMask(cell.row, cell.col);
+    while (neighbors) {
+        int dir = PopNeighbor(neighbors);
+        GridCoordinate next(cell.row + DX_8DIR[dir], cell.col + DY_8DIR[dir]);
+        if (!TransitionAllowed(cell, inDir, dir)) {
+            continue;
+        }
+        out.emplace_back(MakeState(next, dir), EdgeCost(cell, dir).cost);
+    }
+}
+
+void IncrementalRoutePlanner::GetPredecessors(uint64_t state, std::vector<uint64_t>& out) const
+{
+    out.clear();
+    int outDir = StateDirection(state);
+    if (outDir == NO_DIRECTION) {
+        return;  // only the start can be entered without a direction
+    }
+
+    GridCoordinate cell = StateCell(state);
+    GridCoordinate prev(cell.row - DX_8DIR[outDir], cell.col - DY_8DIR[outDir]);
+    if (!IsValidAndNavigable(grid_, prev)) {
+        return;
+    }
+
+    for (int inDir = 0; inDir < 8; ++inDir) {
+        GridCoordinate prevPrev(prev.row - DX_8DIR[inDir], prev.col - DY_8DIR[inDir]);
+        if (!IsValidAndNavigable(grid_, prevPrev)) {
+            continue;
+        }
+        if (TransitionAllowed(prev, inDir, outDir)) {
+            out.push_back(MakeState(prev, inDir));
+        }
+    }
+
+    if (prev == start_) {
+        out.push_back(MakeState(prev, NO_DIRECTION));
+    }
+}
+
+// ================================================================
+// Edge costs
+// ================================================================
+
+const EdgeCostResult& IncrementalRoutePlanner::EdgeCost(const GridCoordinate& from, int dir)
+{
+    uint64_t cellIdx = grid_.CellIndex(from);
+    uint64_t key = cellIdx * 8 + static_cast<uint64_t>(dir);
+
+    auto it = edgeCosts_.find(key);
+    if (it != edgeCosts_.end()) {
+        return it->second;
+    }
+
+    GridCoordinate to(from.row + DX_8DIR[dir], from.col + DY_8DIR[dir]);
+    EdgeCostResult edge = costModel_.ComputeEdgeCost(from, to, DepartureTimeHours(from));
+    return edgeCosts_.emplace(key, edge).first->second;
+}
+
+double IncrementalRoutePlanner::DepartureTimeHours(const GridCoordinate& cell) const
+{
+    GeoCoordinate cellGeo = grid_.GridToGeo(cell);
+    double distKm = greatCircleDistance(
+        originGeo_.latitude, originGeo_.longitude,
+        cellGeo.latitude, cellGeo.longitude
+    );
+    return timeCalculator(distKm, shipSpeedMps_);
+}
+
+PathSearchResult IncrementalRoutePlanner::ExtractPath()
+{
+    lastPath_.clear();
+
+    if (G(startState_) == INF && !(start_ == goal_)) {
+        return PathSearchResult();
+    }
+
+    PathSearchResult result;
+    result.total_cost = 0.0;
+    result.total_time_hours = 0.0;
+    result.path.push_back(start_);
+
+    std::unordered_set<uint64_t> visited;
+    std::vector<std::pair<uint64_t, double>> successors;
+    uint64_t state = startState_;
+
+    while (!(StateCell(state) == goal_)) {
+        if (!visited.insert(state).second) {
+            std::cerr << "[IncrementalPlanner] Error: Loop detected while extracting path" << std::endl;
+            return PathSearchResult();
+        }
+
+        GetSuccessors(state, successors);
+
+        uint64_t bestState = state;
+        double bestValue = INF;
+        for (const auto& [succ, cost] : successors) {
+            double value = cost + G(succ);
+            if (value < bestValue) {
+                bestValue = value;
+                bestState = succ;
+            }
+        }
+        if (bestValue == INF) {
+            return PathSearchResult();
+        }
+
+        const EdgeCostResult& edge = EdgeCost(StateCell(state), StateDirection(bestState));
+        result.total_cost += edge.cost;
+        result.total_time_hours += edge.deltaTimeHours;
+
+        state = bestState;
+        result.path.push_back(StateCell(state));
+    }
+
+    lastPath_ = result.path;
+    return result;
+}
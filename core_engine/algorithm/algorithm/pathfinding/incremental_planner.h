@@ -0,0 +1,171 @@
+#pragma once
+
+#include "route_planner.h"
+#include "path_types.h"
+#include "optimized_planner.h"
+#include "../types/grid_types.h"
+#include "../types/voyage_types.h"
+#include "../types/weather_types.h"
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @class IncrementalRoutePlanner
+ * @brief Fuel-optimized planner that keeps its search state for replanning (D* Lite)
+ *
+ * Searches backward from the goal so that the vessel position (search start)
+ * can move and edge costs can change without restarting the search:
+ * - NotifyWeatherChanged() invalidates only the edges inside the changed
+ *   weather regions and re-queues their states
+ * - Replan() moves the start to the current vessel position and repairs
+ *   the affected part of the search tree
+ *
+ * Search states are (cell, incoming direction) so the same turn-angle rule
+ * as AStarEngine (IsValidTransition) holds on every path.
+ *
+ * Edge costs come from OptimizedRoutePlanner::ComputeEdgeCost. Because a
+ * backward search does not know the arrival time at a cell, the departure
+ * time of an edge is estimated as the great-circle sailing time from the
+ * voyage origin. The estimate is anchored to the origin, so vessel moves do
+ * not change edge costs.
+ */
+class IncrementalRoutePlanner : public IRoutePlanner {
+public:
+    /**
+     * @brief Constructor (same parameters as OptimizedRoutePlanner)
+     * @param grid Navigable grid reference (must outlive the planner)
+     * @param voyageInfo Base voyage information (draft, trim, speed)
+     * @param startTimeSec Simulation start time in seconds
+     * @param weatherData Weather data map (may be updated in place between replans)
+     * @param shipSpeedMps Ship speed in meters per second
+     */
+    IncrementalRoutePlanner(
+        const NavigableGrid& grid,
+        const VoyageInfo& voyageInfo,
+        unsigned int startTimeSec,
+        const std::map<std::string, WeatherDataInput>& weatherData,
+        double shipSpeedMps
+    );
+
+    // ================================================================
+    // IRoutePlanner Interface Implementation
+    // ================================================================
+
+    /**
+     * @brief Initial solve: resets the search state for a new start/goal
+     */
+    PathSearchResult FindPath(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal
+    ) override;
+
+    EdgeCostResult ComputeEdgeCost(
+        const GridCoordinate& from,
+        const GridCoordinate& to,
+        double accumulatedTimeHours
+    ) const override;
+
+    double ComputeHeuristic(
+        const GridCoordinate& current,
+        const GridCoordinate& goal
+    ) const override;
+
+    bool IsValidTransition(
+        const PathNode& current_node,
+        const GridCoordinate& neighbor_pos
+    ) const override;
+
+    // ================================================================
+    // Incremental Replanning
+    // ================================================================
+
+    /**
+     * @brief Invalidate edge costs inside changed weather regions
+     *
+     * Must be called after the weather map passed to the constructor has
+     * been updated. A global region resets the search (full replan).
+     */
+    void NotifyWeatherChanged(const std::vector<WeatherChangeRegion>& regions);
+
+    /**
+     * @brief Repair the search from a new vessel position
+     * @param vesselPos Current vessel cell (navigable)
+     * @return PathSearchResult from vesselPos to the goal
+     */
+    PathSearchResult Replan(const GridCoordinate& vesselPos);
+
+    bool HasState() const { return hasState_; }
+    const GridCoordinate& Start() const { return start_; }
+    const GridCoordinate& Goal() const { return goal_; }
+    const std::vector<GridCoordinate>& LastPath() const { return lastPath_; }
+
+    /// States expanded by the last FindPath()/Replan() call
+    size_t LastExpansions() const { return lastExpansions_; }
+
+private:
+    using Key = std::pair<double, double>;
+
+    struct StateInfo {
+        double g;
+        double rhs;
+        Key key;
+        bool inQueue;
+
+        StateInfo();
+    };
+
+    static constexpr int NO_DIRECTION = 8;
+
+    const NavigableGrid& grid_;
+    OptimizedRoutePlanner costModel_;
+    VoyageInfo voyageInfoBase_;
+    unsigned int startTimeSec_;
+    double shipSpeedMps_;
+
+    // Search state (state id = cell index * 9 + incoming direction)
+    std::unordered_map<uint64_t, StateInfo> states_;
+    std::set<std::pair<Key, uint64_t>> openList_;
+    double km_;
+    uint64_t startState_;
+    GridCoordinate start_;
+    GridCoordinate goal_;
+    GeoCoordinate originGeo_;
+    double minFuelRateKgPerHour_;
+    bool hasState_;
+
+    // Edge cost cache (key = cell index * 8 + direction)
+    std::unordered_map<uint64_t, EdgeCostResult> edgeCosts_;
+
+    std::vector<GridCoordinate> lastPath_;
+    size_t lastExpansions_;
+
+    // State helpers
+    uint64_t MakeState(const GridCoordinate& cell, int dir) const;
+    GridCoordinate StateCell(uint64_t state) const;
+    int StateDirection(uint64_t state) const;
+    StateInfo& Info(uint64_t state);
+    double G(uint64_t state) const;
+    double Rhs(uint64_t state) const;
+
+    // D* Lite
+    void Reset(const GridCoordinate& start, const GridCoordinate& goal);
+    Key CalculateKey(uint64_t state) const;
+    double StateHeuristic(const GridCoordinate& from, const GridCoordinate& to) const;
+    void UpdateVertex(uint64_t state);
+    void ComputeShortestPath();
+    bool TransitionAllowed(const GridCoordinate& cell, int inDir, int outDir) const;
+    void GetSuccessors(uint64_t state, std::vector<std::pair<uint64_t, double>>& out);
+    void GetPredecessors(uint64_t state, std::vector<uint64_t>& out) const;
+
+    // Edge costs
+    const EdgeCostResult& EdgeCost(const GridCoordinate& from, int dir);
+    double DepartureTimeHours(const GridCoordinate& cell) const;
+
+    PathSearchResult ExtractPath();
+};
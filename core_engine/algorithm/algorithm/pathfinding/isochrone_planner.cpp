@@ -0,0 +1,447 @@
+#include "isochrone_planner.h"
+#include "path_utils.h"
+#include "../utils/geo_calculations.h"
+#include "../utils/time_calculator.h"
+#include "../utils/fuel_calculator.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace {
+    constexpr double KM_PER_DEGREE = 111.195;
+    constexpr int CELLS_PER_STEP = 4;        // Default step length in cells
+    constexpr size_t MIN_POINTS_PER_THREAD = 8;
+
+    // Absolute difference between two headings in degrees [0, 180]
+    double HeadingDifference(double a, double b) {
+        double diff = std::fmod(a - b + 540.0, 360.0) - 180.0;
+        return std::abs(diff);
+    }
+}
+
+IsochroneRoutePlanner::IsochroneRoutePlanner(
+    const NavigableGrid& grid,
+    const VoyageInfo& voyageInfo,
+    unsigned int startTimeSec,
+    const std::map<std::string, WeatherDataInput>& weatherData,
+    double shipSpeedMps,
+    const IsochroneOptions& options)
+    : grid_(grid)
+    , costModel_(grid, voyageInfo, startTimeSec, weatherData, shipSpeedMps)
+    , voyageInfoBase_(voyageInfo)
+    , startTimeSec_(startTimeSec)
+    , weatherData_(weatherData)
+    , shipSpeedMps_(shipSpeedMps)
+    , options_(options)
+    , cellKm_(std::min(grid.CellSizeLat(), grid.CellSizeLon()) * KM_PER_DEGREE)
+    , searchThreads_(1)
+    , lastFrontCount_(0)
+    , goalGeo_(0.0, 0.0)
+    , minFuelRateKgPerHour_(0.0)
+{
+}
+
+// ================================================================
+// IRoutePlanner Interface Implementation
+// ================================================================
+
+PathSearchResult IsochroneRoutePlanner::FindPath(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal)
+{
+    lastFrontCount_ = 0;
+
+    if (!IsValidAndNavigable(grid, start) || !IsValidAndNavigable(grid, goal)) {
+        std::cerr << "[IsochronePlanner] Error: Start or Goal position is not navigable." << std::endl;
+        return PathSearchResult();
+    }
+
+    if (start == goal) {
+        PathSearchResult result;
+        result.path = { start };
+        result.total_cost = 0.0;
+        result.total_time_hours = 0.0;
+        return result;
+    }
+
+    // ================================================================
+    // 1. Search parameters
+    // ================================================================
+    GeoCoordinate startGeo = grid_.GridToGeo(start);
+    goalGeo_ = grid_.GridToGeo(goal);
+
+    VoyageInfo vInfo = voyageInfoBase_;
+    vInfo.heading = calculateBearing(startGeo, goalGeo_);
+    minFuelRateKgPerHour_ = fuelCalculator_zero(
+        startTimeSec_,
+        startGeo.latitude,
+        startGeo.longitude,
+        vInfo
+    );
+
+    double speedKmh = shipSpeedMps_ * 3.6;
+    double stepHours = (options_.timeStepHours > 0.0)
+        ? options_.timeStepHours
+        : timeCalculator(CELLS_PER_STEP * cellKm_, shipSpeedMps_);
+    double stepKm = speedKmh * stepHours;
+
+    if (stepKm <= 0.0) {
+        std::cerr << "[IsochronePlanner] Error: Invalid ship speed or time step" << std::endl;
+        return PathSearchResult();
+    }
+
+    double directKm = greatCircleDistance(
+        startGeo.latitude, startGeo.longitude,
+        goalGeo_.latitude, goalGeo_.longitude
+    );
+    int maxSteps = (options_.maxSteps > 0)
+        ? options_.maxSteps
+        : static_cast<int>(std::ceil(3.0 * directKm / stepKm)) + 10;
+
+    // ================================================================
+    // 2. Propagate fronts
+    // ================================================================
+    std::vector<std::vector<FrontPoint>> fronts;
+    FrontPoint origin;
+    origin.pos = startGeo;
+    origin.fuelKg = 0.0;
+    origin.timeHours = 0.0;
+    origin.headingDeg = -1.0;
+    origin.remainingKm = directKm;
+    origin.parent = -1;
+    fronts.push_back({ origin });
+
+    Arrival best;
+
+    for (int step = 0; step < maxSteps; ++step) {
+        const std::vector<FrontPoint>& front = fronts.back();
+        int frontIndex = static_cast<int>(fronts.size()) - 1;
+
+        size_t numThreads = std::min<size_t>(
+            static_cast<size_t>(std::max(1, searchThreads_)),
+            (front.size() + MIN_POINTS_PER_THREAD - 1) / MIN_POINTS_PER_THREAD);
+
+        std::vector<std::vector<FrontPoint>> partial(numThreads);
+        std::vector<Arrival> arrivals(numThreads);
+
+        auto expandRange = [&](size_t t) {
+            size_t begin = front.size() * t / numThreads;
+            size_t end = front.size() * (t + 1) / numThreads;
+            for (size_t i = begin; i < end; ++i) {
+                ExpandPoint(front[i], static_cast<int>(i), frontIndex,
+                    stepKm, stepHours, partial[t], arrivals[t]);
+            }
+        };
+
+        if (numThreads <= 1) {
+            expandRange(0);
+        } else {
+            std::vector<std::thread> workers;
+            workers.reserve(numThreads);
+            for (size_t t = 0; t < numThreads; ++t) {
+                workers.emplace_back(expandRange, t);
+            }
+            for (auto& worker : workers) {
+                worker.join();
+            }
+        }
+
+        // Merge arrivals and candidates
+        std::vector<FrontPoint> candidates;
+        for (size_t t = 0; t < numThreads; ++t) {
+            if (arrivals[t].valid && (!best.valid || arrivals[t].fuelKg < best.fuelKg)) {
+                best = arrivals[t];
+            }
+            candidates.insert(candidates.end(), partial[t].begin(), partial[t].end());
+        }
+
+        double bound = best.valid ? best.fuelKg : std::numeric_limits<double>::infinity();
+        std::vector<FrontPoint> next = PruneFront(candidates, startGeo, bound);
+        if (next.empty()) {
+            break;
+        }
+        fronts.push_back(std::move(next));
+    }
+
+    lastFrontCount_ = static_cast<int>(fronts.size());
+
+    if (!best.valid) {
+        std::cerr << "[IsochronePlanner] Path not found" << std::endl;
+        return PathSearchResult();
+    }
+
+    // ================================================================
+    // 3. Reconstruct track and rasterise to grid
+    // ================================================================
+    std::vector<GeoCoordinate> track = { goalGeo_ };
+    int index = best.parent;
+    for (int f = best.front; f >= 0 && index >= 0; --f) {
+        const FrontPoint& point = fronts[f][index];
+        track.push_back(point.pos);
+        index = point.parent;
+    }
+    std::reverse(track.begin(), track.end());
+
+    PathSearchResult result;
+    result.path = RasterizeTrack(track);
+    result.total_cost = best.fuelKg;
+    result.total_time_hours = best.timeHours;
+
+    std::cout << "[IsochronePlanner] Optimized: " << result.total_cost << " kg, "
+              << result.total_time_hours << "h (" << lastFrontCount_ << " fronts)" << std::endl;
+
+    return result;
+}
+
+EdgeCostResult IsochroneRoutePlanner::ComputeEdgeCost(
+    const GridCoordinate& from,
+    const GridCoordinate& to,
+    double accumulatedTimeHours) const
+{
+    return costModel_.ComputeEdgeCost(from, to, accumulatedTimeHours);
+}
+
+double IsochroneRoutePlanner::ComputeHeuristic(
+    const GridCoordinate& current,
+    const GridCoordinate& goal) const
+{
+    GeoCoordinate currentGeo = grid_.GridToGeo(current);
+    GeoCoordinate goalGeo = grid_.GridToGeo(goal);
+
+    double distKm = greatCircleDistance(
+        currentGeo.latitude, currentGeo.longitude,
+        goalGeo.latitude, goalGeo.longitude
+    );
+
+    return minFuelRateKgPerHour_ * timeCalculator(distKm, shipSpeedMps_);
+}
+
+bool IsochroneRoutePlanner::IsValidTransition(
+    const PathNode& current_node,
+    const GridCoordinate& neighbor_pos) const
+{
+    return costModel_.IsValidTransition(current_node, neighbor_pos);
+}
+
+// ================================================================
+// Front Propagation
+// ================================================================
+
+bool IsochroneRoutePlanner::IsSegmentNavigable(
+    const GeoCoordinate& from,
+    const GeoCoordinate& to) const
+{
+    double distKm = greatCircleDistance(
+        from.latitude, from.longitude,
+        to.latitude, to.longitude
+    );
+
+    // Sample every half cell so no cell along the segment is skipped
+    int samples = std::max(1, static_cast<int>(std::ceil(distKm / (0.5 * cellKm_))));
+
+    for (int i = 1; i <= samples; ++i) {
+        double t = static_cast<double>(i) / samples;
+        GeoCoordinate p(
+            from.latitude + (to.latitude - from.latitude) * t,
+            from.longitude + (to.longitude - from.longitude) * t
+        );
+
+        if (!grid_.Bounds().Contains(p)) {
+            return false;
+        }
+
+        GridCoordinate cell = grid_.GeoToGrid(p);
+        if (!grid_.IsNavigable(cell.row, cell.col)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+double IsochroneRoutePlanner::LegFuel(
+    const GeoCoordinate& from,
+    const GeoCoordinate& to,
+    double headingDeg,
+    double departHours,
+    double legHours) const
+{
+    GeoCoordinate midGeo(
+        (from.latitude + to.latitude) / 2.0,
+        (from.longitude + to.longitude) / 2.0
+    );
+
+    unsigned int midTimeSec = startTimeSec_
+        + static_cast<unsigned int>((departHours + legHours / 2.0) * 3600.0);
+
+    VoyageInfo vInfo = voyageInfoBase_;
+    vInfo.heading = headingDeg;
+
+    double fuelRateKgPerHour = fuelCalculator(
+        midTimeSec,
+        midGeo.latitude, midGeo.longitude,
+        weatherData_,
+        vInfo
+    );
+
+    return fuelRateKgPerHour * legHours;
+}
+
+void IsochroneRoutePlanner::ExpandPoint(
+    const FrontPoint& point,
+    int index,
+    int frontIndex,
+    double stepKm,
+    double stepHours,
+    std::vector<FrontPoint>& out,
+    Arrival& arrival) const
+{
+    double goalBearing = calculateBearing(point.pos, goalGeo_);
+    bool hasHeading = point.headingDeg >= 0.0;
+
+    // Final leg: goal within one step
+    if (point.remainingKm <= stepKm &&
+        (!hasHeading || HeadingDifference(goalBearing, point.headingDeg) <= MAX_ANGLE_DEGREES) &&
+        IsSegmentNavigable(point.pos, goalGeo_))
+    {
+        double legHours = timeCalculator(point.remainingKm, shipSpeedMps_);
+        double fuelKg = point.fuelKg
+            + LegFuel(point.pos, goalGeo_, goalBearing, point.timeHours, legHours);
+
+        if (!arrival.valid || fuelKg < arrival.fuelKg) {
+            arrival.fuelKg = fuelKg;
+            arrival.timeHours = point.timeHours + legHours;
+            arrival.parent = index;
+            arrival.front = frontIndex;
+            arrival.valid = true;
+        }
+    }
+
+    // Heading fan around the bearing to goal
+    double span = options_.headingSpanDeg;
+    double stepDeg = std::max(0.1, options_.headingStepDeg);
+
+    for (double offset = -span; offset <= span + 1e-9; offset += stepDeg) {
+        double heading = std::fmod(goalBearing + offset + 360.0, 360.0);
+
+        if (hasHeading && HeadingDifference(heading, point.headingDeg) > MAX_ANGLE_DEGREES) {
+            continue;
+        }
+
+        GeoCoordinate to = destinationPoint(point.pos, heading, stepKm);
+        if (!IsSegmentNavigable(point.pos, to)) {
+            continue;
+        }
+
+        FrontPoint next;
+        next.pos = to;
+        next.fuelKg = point.fuelKg + LegFuel(point.pos, to, heading, point.timeHours, stepHours);
+        next.timeHours = point.timeHours + stepHours;
+        next.headingDeg = heading;
+        next.remainingKm = greatCircleDistance(
+            to.latitude, to.longitude,
+            goalGeo_.latitude, goalGeo_.longitude
+        );
+        next.parent = index;
+
+        out.push_back(next);
+    }
+}
+
+std::vector<IsochroneRoutePlanner::FrontPoint> IsochroneRoutePlanner::PruneFront(
+    std::vector<FrontPoint>& candidates,
+    const GeoCoordinate& startGeo,
+    double bestArrivalFuel) const
+{
+    double sectorDeg = std::max(0.01, options_.sectorDeg);
+    int numSectors = static_cast<int>(std::ceil(360.0 / sectorDeg));
+    size_t keepPerSector = static_cast<size_t>(std::max(1, options_.maxPointsPerSector));
+
+    auto estimate = [this](const FrontPoint& p) {
+        return p.fuelKg + minFuelRateKgPerHour_ * timeCalculator(p.remainingKm, shipSpeedMps_);
+    };
+
+    // Group by sector, dropping points that cannot beat the best arrival
+    std::vector<std::vector<FrontPoint>> sectors(numSectors);
+    for (const auto& p : candidates) {
+        if (estimate(p) >= bestArrivalFuel) {
+            continue;
+        }
+        int sector = static_cast<int>(calculateBearing(startGeo, p.pos) / sectorDeg);
+        sectors[std::min(sector, numSectors - 1)].push_back(p);
+    }
+
+    std::vector<FrontPoint> front;
+    for (auto& sector : sectors) {
+        if (sector.empty()) {
+            continue;
+        }
+
+        // Non-dominated in (remaining distance, fuel): closer to goal or cheaper
+        std::sort(sector.begin(), sector.end(), [](const FrontPoint& a, const FrontPoint& b) {
+            if (a.remainingKm != b.remainingKm) {
+                return a.remainingKm < b.remainingKm;
+            }
+            return a.fuelKg < b.fuelKg;
+        });
+
+        std::vector<FrontPoint> kept;
+        double minFuel = std::numeric_limits<double>::infinity();
+        for (const auto& p : sector) {
+            if (p.fuelKg < minFuel) {
+                kept.push_back(p);
+                minFuel = p.fuelKg;
+            }
+        }
+
+        if (kept.size() > keepPerSector) {
+            std::partial_sort(kept.begin(), kept.begin() + keepPerSector, kept.end(),
+                [&estimate](const FrontPoint& a, const FrontPoint& b) {
+                    return estimate(a) < estimate(b);
+                });
+            kept.resize(keepPerSector);
+        }
+
+        front.insert(front.end(), kept.begin(), kept.end());
+    }
+
+    return front;
+}
+
+std::vector<GridCoordinate> IsochroneRoutePlanner::RasterizeTrack(
+    const std::vector<GeoCoordinate>& track) const
+{
+    std::vector<GridCoordinate> path;
+    if (track.empty()) {
+        return path;
+    }
+
+    path.push_back(grid_.GeoToGrid(track.front()));
+
+    for (size_t i = 1; i < track.size(); ++i) {
+        const GeoCoordinate& from = track[i - 1];
+        const GeoCoordinate& to = track[i];
+
+        double distKm = greatCircleDistance(
+            from.latitude, from.longitude,
+            to.latitude, to.longitude
+        );
+        int samples = std::max(1, static_cast<int>(std::ceil(distKm / (0.5 * cellKm_))));
+
+        for (int s = 1; s <= samples; ++s) {
+            double t = static_cast<double>(s) / samples;
+            GridCoordinate cell = grid_.GeoToGrid(GeoCoordinate(
+                from.latitude + (to.latitude - from.latitude) * t,
+                from.longitude + (to.longitude - from.longitude) * t
+            ));
+            if (!(cell == path.back())) {
+                path.push_back(cell);
+            }
+        }
+    }
+
+    return path;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "route_planner.h"
+#include "path_types.h"
+#include "optimized_planner.h"
+#include "../types/grid_types.h"
+#include "../types/voyage_types.h"
+#include "../types/weather_types.h"
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @struct IsochroneOptions
+ * @brief Tuning parameters for IsochroneRoutePlanner (0 = derived from grid/route)
+ */
+struct IsochroneOptions {
+    double timeStepHours;       // Time between fronts (0: about 4 cells per step)
+    double headingSpanDeg;      // Heading fan half-width around the bearing to goal
+    double headingStepDeg;      // Heading resolution inside the fan
+    double sectorDeg;           // Angular sector width (bearing from start) for pruning
+    int maxPointsPerSector;     // Non-dominated points kept per sector
+    int maxSteps;               // Front limit (0: 3x great-circle time)
+
+    IsochroneOptions()
+        : timeStepHours(0.0)
+        , headingSpanDeg(90.0)
+        , headingStepDeg(5.0)
+        , sectorDeg(1.0)
+        , maxPointsPerSector(3)
+        , maxSteps(0)
+    {}
+};
+
+/**
+ * @class IsochroneRoutePlanner
+ * @brief Fuel-optimized planner using the isochrone method
+ *
+ * Propagates time fronts from the start in fixed time steps instead of
+ * searching grid edges:
+ * - every front point is advanced over a fan of headings centred on the
+ *   bearing to the goal (turns limited to MAX_ANGLE_DEGREES)
+ * - fuel for each step comes from fuelCalculator at the step midpoint and
+ *   mid time, so weather is sampled at the actual passing time
+ * - steps crossing land or leaving the grid are rejected (NavigableGrid)
+ * - candidates are grouped by angular sector around the start; inside a
+ *   sector only points not dominated in (remaining distance, fuel) survive
+ *
+ * A front point within one step of the goal tries a direct final leg. The
+ * search stops when no front point can beat the best arrival (fuel so far
+ * plus ideal-weather fuel to the goal). Fronts are expanded in parallel.
+ *
+ * The resulting track is rasterised back to grid cells so the result is
+ * interchangeable with OptimizedRoutePlanner. ComputeEdgeCost and
+ * IsValidTransition delegate to OptimizedRoutePlanner.
+ */
+class IsochroneRoutePlanner : public IRoutePlanner {
+public:
+    /**
+     * @brief Constructor (same parameters as OptimizedRoutePlanner)
+     * @param grid Navigable grid reference
+     * @param voyageInfo Base voyage information (draft, trim, speed)
+     * @param startTimeSec Simulation start time in seconds
+     * @param weatherData Weather data map
+     * @param shipSpeedMps Ship speed in meters per second
+     * @param options Isochrone tuning parameters
+     */
+    IsochroneRoutePlanner(
+        const NavigableGrid& grid,
+        const VoyageInfo& voyageInfo,
+        unsigned int startTimeSec,
+        const std::map<std::string, WeatherDataInput>& weatherData,
+        double shipSpeedMps,
+        const IsochroneOptions& options = IsochroneOptions()
+    );
+
+    // ================================================================
+    // IRoutePlanner Interface Implementation
+    // ================================================================
+
+    PathSearchResult FindPath(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal
+    ) override;
+
+    EdgeCostResult ComputeEdgeCost(
+        const GridCoordinate& from,
+        const GridCoordinate& to,
+        double accumulatedTimeHours
+    ) const override;
+
+    double ComputeHeuristic(
+        const GridCoordinate& current,
+        const GridCoordinate& goal
+    ) const override;
+
+    bool IsValidTransition(
+        const PathNode& current_node,
+        const GridCoordinate& neighbor_pos
+    ) const override;
+
+    /**
+     * @brief Set worker threads used to expand each front
+     */
+    void SetSearchThreads(int numThreads) { searchThreads_ = numThreads; }
+
+    /// Number of fronts propagated by the last FindPath() call
+    int LastFrontCount() const { return lastFrontCount_; }
+
+private:
+    struct FrontPoint {
+        GeoCoordinate pos;
+        double fuelKg;
+        double timeHours;
+        double headingDeg;      // Heading of the step that reached this point (-1 at start)
+        double remainingKm;     // Great-circle distance to goal
+        int parent;             // Index in the previous front (-1 at start)
+    };
+
+    struct Arrival {
+        double fuelKg;
+        double timeHours;
+        int parent;             // Index in the front it departed from
+        int front;              // Front index it departed from
+        bool valid;
+
+        Arrival() : fuelKg(0.0), timeHours(0.0), parent(-1), front(-1), valid(false) {}
+    };
+
+    const NavigableGrid& grid_;
+    OptimizedRoutePlanner costModel_;
+    VoyageInfo voyageInfoBase_;
+    unsigned int startTimeSec_;
+    const std::map<std::string, WeatherDataInput>& weatherData_;
+    double shipSpeedMps_;
+    IsochroneOptions options_;
+    double cellKm_;             // Smaller cell edge [km], land check resolution
+    int searchThreads_;
+    int lastFrontCount_;
+
+    // Per-search parameters
+    GeoCoordinate goalGeo_;
+    double minFuelRateKgPerHour_;
+
+    /**
+     * @brief Check a straight segment against land and grid bounds
+     */
+    bool IsSegmentNavigable(const GeoCoordinate& from, const GeoCoordinate& to) const;
+
+    /**
+     * @brief Fuel [kg] for one leg at the mid point and mid time
+     */
+    double LegFuel(const GeoCoordinate& from, const GeoCoordinate& to,
+        double headingDeg, double departHours, double legHours) const;
+
+    /**
+     * @brief Advance one front point over the heading fan
+     */
+    void ExpandPoint(const FrontPoint& point, int index, int frontIndex,
+        double stepKm, double stepHours,
+        std::vector<FrontPoint>& out, Arrival& arrival) const;
+
+    /**
+     * @brief Keep non-dominated points per angular sector
+     */
+    std::vector<FrontPoint> PruneFront(std::vector<FrontPoint>& candidates,
+        const GeoCoordinate& startGeo, double bestArrivalFuel) const;
+
+    /**
+     * @brief Convert the geographic track into a grid cell path
+     */
+    std::vector<GridCoordinate> RasterizeTrack(const std::vector<GeoCoordinate>& track) const;
+};
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include "label_setting_engine.h"
+#include "path_utils.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    struct Label {
+        GridCoordinate pos;
+        double g_cost;
+        double time_hours;
+        int parent;        // Parent label index (-1 at start)
+        bool alive;
+    };
+
+    struct QueueEntry {
+        double f_cost;
+        int label;
+    };
+
+    struct CompareQueueEntry {
+        bool operator()(const QueueEntry& a, const QueueEntry& b) const {
+            return a.f_cost > b.f_cost;  // Min-heap
+        }
+    };
+
+    // a dominates b: no more fuel and no later arrival
+    bool Dominates(const Label& a, const Label& b) {
+        const double eps = 1e-9;
+        return a.g_cost <= b.g_cost + eps && a.time_hours <= b.time_hours + eps;
+    }
+
+}  // namespace
+
+PathSearchResult LabelSettingEngine::Search(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal,
+    const IRoutePlanner& planner,
+    int maxLabelsPerCell,
+    LabelSearchStats* labelStats)
+{
+    // ================================================================
+    // 1. Validate start and goal
+    // ================================================================
+    if (!IsValidAndNavigable(grid, start) || !IsValidAndNavigable(grid, goal)) {
+        std::cerr << "[LabelSettingEngine] Error: Start or Goal position is not navigable." << std::endl;
+        return PathSearchResult();
+    }
+
+    if (start == goal) {
+        PathSearchResult result;
+        result.path = { start };
+        result.total_cost = 0.0;
+        result.total_time_hours = 0.0;
+        return result;
+    }
+
+    size_t maxLabels = static_cast<size_t>(std::max(1, maxLabelsPerCell));
+
+    // ================================================================
+    // 2. Initialize label storage
+    // ================================================================
+    SearchStats stats;
+    LabelSearchStats lstats;
+
+    std::vector<Label> labels;
+    std::unordered_map<uint64_t, std::vector<int>> cellLabels;   // alive labels per cell
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, CompareQueueEntry> open_list;
+
+    auto cellIndex = [&grid](const GridCoordinate& pos) {
+        return static_cast<uint64_t>(grid.CellIndex(pos));
+    };
+
+    // Try to add a label to its cell; returns false if it was pruned
+    auto insertLabel = [&](const Label& candidate, double h_cost) {
+        std::vector<int>& bucket = cellLabels[cellIndex(candidate.pos)];
+
+        for (int id : bucket) {
+            if (Dominates(labels[id], candidate)) {
+                ++lstats.labels_dominated;
+                return false;
+            }
+        }
+
+        // Remove labels the candidate dominates
+        auto dominatedEnd = std::remove_if(bucket.begin(), bucket.end(), [&](int id) {
+            if (Dominates(candidate, labels[id])) {
+                labels[id].alive = false;
+                ++lstats.labels_dominated;
+                return true;
+            }
+            return false;
+        });
+        bucket.erase(dominatedEnd, bucket.end());
+
+        // Bounded label set: evict the most expensive label
+        if (bucket.size() >= maxLabels) {
+            auto worst = std::max_element(bucket.begin(), bucket.end(), [&](int a, int b) {
+                return labels[a].g_cost < labels[b].g_cost;
+            });
+            ++lstats.labels_evicted;
+            if (labels[*worst].g_cost <= candidate.g_cost) {
+                return false;
+            }
+            labels[*worst].alive = false;
+            bucket.erase(worst);
+        }
+
+        int id = static_cast<int>(labels.size());
+        labels.push_back(candidate);
+        bucket.push_back(id);
+        lstats.max_labels_in_cell = std::max(lstats.max_labels_in_cell, bucket.size());
+        ++lstats.labels_created;
+
+        open_list.push(QueueEntry{ candidate.g_cost + h_cost, id });
+        ++stats.nodes_pushed;
+        return true;
+    };
+
+    // ================================================================
+    // 3. Start label
+    // ================================================================
+    insertLabel(Label{ start, 0.0, 0.0, -1, true }, planner.ComputeHeuristic(start, goal));
+
+    int goalLabel = -1;
+
+    // ================================================================
+    // 4. Main loop
+    // ================================================================
+    while (!open_list.empty()) {
+        QueueEntry entry = open_list.top();
+        open_list.pop();
+
+        // Skip labels removed after they were queued
+        if (!labels[entry.label].alive) {
+            continue;
+        }
+
+        Label current = labels[entry.label];
+
+        if (current.pos == goal) {
+            goalLabel = entry.label;
+            break;
+        }
+
+        ++stats.nodes_expanded;
+
+        GridCoordinate parent_pos = (current.parent >= 0)
+            ? labels[current.parent].pos
+            : GridCoordinate(-1, -1);
+        PathNode current_node(current.pos, current.g_cost, 0.0, parent_pos, current.time_hours);
+
+        uint8_t neighbors = grid.NeighborMask(current.pos.row, current.pos.col);
+        while (neighbors) {
+            int i = PopNeighbor(neighbors);
+            GridCoordinate neighbor_pos = grid.Neighbor(current.pos.row, current.pos.col, i);
+
+            if (neighbor_pos == parent_pos) {
+                continue;
+            }
+            if (!planner.IsValidTransition(current_node, neighbor_pos)) {
+                continue;
+            }
+
+            EdgeCostResult edge = planner.ComputeEdgeCost(
+                current.pos,
+                neighbor_pos,
+                current.time_hours
+            );
+            ++stats.edge_evaluations;
+
+            Label next{
+                neighbor_pos,
+                current.g_cost + edge.cost,
+                current.time_hours + edge.deltaTimeHours,
+                entry.label,
+                true
+            };
+            insertLabel(next, planner.ComputeHeuristic(neighbor_pos, goal));
+        }
+    }
+
+    // ================================================================
+    // 5. Label statistics
+    // ================================================================
+    size_t aliveLabels = 0;
+    for (const auto& cell : cellLabels) {
+        if (!cell.second.empty()) {
+            ++lstats.cells_labelled;
+            aliveLabels += cell.second.size();
+        }
+    }
+    if (lstats.cells_labelled > 0) {
+        lstats.avg_labels_per_cell =
+            static_cast<double>(aliveLabels) / static_cast<double>(lstats.cells_labelled);
+    }
+    if (labelStats) {
+        *labelStats = lstats;
+    }
+
+    if (goalLabel < 0) {
+        std::cerr << "[LabelSettingEngine] Error: Path not found from ("
+                  << start.row << ", " << start.col << ") to ("
+                  << goal.row << ", " << goal.col << ")" << std::endl;
+        PathSearchResult result;
+        result.stats = stats;
+        return result;
+    }
+
+    // ================================================================
+    // 6. Reconstruct path from label chain
+    // ================================================================
+    std::vector<GridCoordinate> path;
+    for (int id = goalLabel; id >= 0; id = labels[id].parent) {
+        path.push_back(labels[id].pos);
+    }
+    std::reverse(path.begin(), path.end());
+
+    PathSearchResult result;
+    result.path = path;
+    result.total_cost = labels[goalLabel].g_cost;
+    result.total_time_hours = labels[goalLabel].time_hours;
+    result.stats = stats;
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "path_types.h"
+#include "route_planner.h"
+#include "../types/grid_types.h"
+#include <cstddef>
+
+// ================================================================
+// Label Statistics
+// ================================================================
+struct LabelSearchStats {
+    size_t labels_created;     // Labels accepted into a cell
+    size_t labels_dominated;   // Rejected or removed by (fuel, time) dominance
+    size_t labels_evicted;     // Dropped because the cell was full
+    size_t cells_labelled;     // Cells holding at least one label at the end
+    size_t max_labels_in_cell; // Largest label set seen in one cell
+    double avg_labels_per_cell;
+
+    LabelSearchStats()
+        : labels_created(0)
+        , labels_dominated(0)
+        , labels_evicted(0)
+        , cells_labelled(0)
+        , max_labels_in_cell(0)
+        , avg_labels_per_cell(0.0)
+    {}
+};
+
+/**
+ * @class LabelSettingEngine
+ * @brief Multi-label A* keeping Pareto-nondominated (fuel, time) labels per cell
+ *
+ * AStarEngine keeps one g-cost per cell, so an earlier but slightly more
+ * expensive arrival is discarded even when time-dependent weather would make
+ * it cheaper later on. This engine keeps up to maxLabelsPerCell labels per
+ * cell:
+ * - a new label is rejected if an existing label has both less (or equal)
+ *   fuel and an earlier (or equal) arrival
+ * - existing labels dominated by the new label are removed
+ * - when the cell is full, the label with the highest fuel is evicted
+ *
+ * Labels are expanded in f-cost order (fuel + planner heuristic). The first
+ * goal label popped is returned. maxLabelsPerCell = 1 behaves like A*.
+ */
+class LabelSettingEngine {
+public:
+    /**
+     * @brief Execute label-setting search with given strategy
+     *
+     * @param grid Navigable grid
+     * @param start Start grid coordinate
+     * @param goal Goal grid coordinate
+     * @param planner Strategy for cost/heuristic computation
+     * @param maxLabelsPerCell Label bound per cell (>= 1)
+     * @param labelStats Optional output for label statistics
+     * @return PathSearchResult with path and total cost
+     */
+    static PathSearchResult Search(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal,
+        const IRoutePlanner& planner,
+        int maxLabelsPerCell,
+        LabelSearchStats* labelStats = nullptr
+    );
+};
\ No newline at end of file
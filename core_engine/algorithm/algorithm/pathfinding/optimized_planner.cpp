@@ -1,11 +1,16 @@
 #include "optimized_planner.h"
 #include "a_star_engine.h"
+#include "parallel_a_star_engine.h"
+#include "quadtree_search_engine.h"
 #include "path_utils.h"
 #include "../types/voyage_types.h"
 #include "../utils/geo_calculations.h"
 #include "../utils/time_calculator.h"
 #include "../utils/fuel_calculator.h"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
 
 OptimizedRoutePlanner::OptimizedRoutePlanner(
     const NavigableGrid& grid,
@@ -18,6 +23,9 @@ OptimizedRoutePlanner::OptimizedRoutePlanner(
     , startTimeSec_(startTimeSec)
     , weatherData_(weatherData)
     , shipSpeedMps_(shipSpeedMps)
+    , searchThreads_(1)
+    , maxLabelsPerCell_(0)
+    , quadtree_(nullptr)
     , minFuelRateKgPerHour_(0.0)
     , goalGeo_(0.0, 0.0)
 {
@@ -53,7 +61,43 @@ PathSearchResult OptimizedRoutePlanner::FindPath(
 {
     InitializeHeuristic(start, goal);
     
-    PathSearchResult result = AStarEngine::Search(grid, start, goal, *this);
+    if (quadtree_) {
+        PathSearchResult result = QuadtreeSearchEngine::Search(*quadtree_, start, goal, *this);
+        if (result.IsSuccess()) {
+            std::cout << "[OptimizedPlanner] Optimized (quadtree): " << result.total_cost << " kg, "
+                      << result.total_time_hours << "h, " << result.stats.nodes_expanded << " leaves expanded" << std::endl;
+        } else {
+            std::cerr << "[OptimizedPlanner] Path not found" << std::endl;
+        }
+        return result;
+    }
+    
+    // Upper bound from the reference (shortest) path, if it covers this leg
+    double upperBound = ReferencePathCost(start, goal);
+    
+    PathSearchResult result;
+    if (maxLabelsPerCell_ > 0) {
+        result = LabelSettingEngine::Search(
+            grid, start, goal, *this, maxLabelsPerCell_, &lastLabelStats_);
+    } else if (searchThreads_ > 1) {
+        result = ParallelAStarEngine::Search(grid, start, goal, *this, searchThreads_, upperBound);
+    } else {
+        result = AStarEngine::Search(grid, start, goal, *this, upperBound);
+    }
+    
+    if (std::isfinite(upperBound) && maxLabelsPerCell_ <= 0) {
+        if (result.IsSuccess()) {
+            std::cout << "[OptimizedPlanner] Upper bound " << upperBound << " kg: "
+                      << result.stats.nodes_pruned << " pushes pruned, "
+                      << result.stats.edge_evaluations << " edge evaluations" << std::endl;
+        } else {
+            // Heuristic is not a strict lower bound under weather; retry unbounded
+            std::cerr << "[OptimizedPlanner] Bounded search failed, retrying without upper bound" << std::endl;
+            result = (searchThreads_ > 1)
+                ? ParallelAStarEngine::Search(grid, start, goal, *this, searchThreads_)
+                : AStarEngine::Search(grid, start, goal, *this);
+        }
+    }
     
     if (result.IsSuccess()) {
         std::cout << "[OptimizedPlanner] Optimized: " << result.total_cost << " kg, " 
@@ -65,6 +109,30 @@ PathSearchResult OptimizedRoutePlanner::FindPath(
     return result;
 }
 
+double OptimizedRoutePlanner::ReferencePathCost(
+    const GridCoordinate& start,
+    const GridCoordinate& goal) const
+{
+    auto first = std::find(referencePath_.begin(), referencePath_.end(), start);
+    if (first == referencePath_.end()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    auto last = std::find(first, referencePath_.end(), goal);
+    if (last == referencePath_.end()) {
+        return std::numeric_limits<double>::infinity();
+    }
+    
+    // Same cost model and time accumulation as the search
+    double cost = 0.0;
+    double timeHours = 0.0;
+    for (auto it = first; it != last; ++it) {
+        EdgeCostResult edge = ComputeEdgeCost(*it, *(it + 1), timeHours);
+        cost += edge.cost;
+        timeHours += edge.deltaTimeHours;
+    }
+    return cost;
+}
+
 EdgeCostResult OptimizedRoutePlanner::ComputeEdgeCost(
     const GridCoordinate& from,
     const GridCoordinate& to,
@@ -140,10 +208,10 @@ bool OptimizedRoutePlanner::IsValidTransition(
     const PathNode& current_node,
     const GridCoordinate& neighbor_pos) const
 {
-    // Calculate direction to neighbor
+    // Calculate direction to neighbor (column step re-based on equal-distance grids)
     int dx = neighbor_pos.row - current_node.pos.row;
-    int dy = neighbor_pos.col - current_node.pos.col;
+    int dy = grid_.ColumnStep(current_node.pos, neighbor_pos);
     
     // Check angle constraint
-    return AngleCheck(current_node, dx, dy);
+    return AngleCheck(grid_, current_node, dx, dy);
 }
\ No newline at end of file
@@ -2,11 +2,14 @@
 
 #include "route_planner.h"
 #include "path_types.h"
+#include "label_setting_engine.h"
 #include "../types/grid_types.h"
+#include "../types/quadtree_grid.h"
 #include "../types/voyage_types.h"
 #include "../types/weather_types.h"
 #include <map>
 #include <string>
+#include <vector>
 
 /**
  * @class OptimizedRoutePlanner
@@ -59,6 +62,42 @@ public:
         const PathNode& current_node,
         const GridCoordinate& neighbor_pos
     ) const override;
+    
+    /**
+     * @brief Set worker threads for FindPath (> 1 uses ParallelAStarEngine)
+     */
+    void SetSearchThreads(int numThreads) { searchThreads_ = numThreads; }
+    
+    /**
+     * @brief Use LabelSettingEngine with up to maxLabels (fuel, time) labels per cell
+     * @param maxLabels Label bound per cell (0 = single-label A*)
+     */
+    void SetMaxLabelsPerCell(int maxLabels) { maxLabelsPerCell_ = maxLabels; }
+    
+    /// Label statistics of the last label-setting FindPath() call
+    const LabelSearchStats& LastLabelStats() const { return lastLabelStats_; }
+    
+    /**
+     * @brief Feasible path used as fuel upper bound (e.g. the shortest route)
+     * 
+     * For each FindPath(start, goal), the part of the reference path between
+     * start and goal is costed with ComputeEdgeCost and passed to the A*
+     * engines as an upper bound. Empty path = no bound.
+     */
+    void SetReferencePath(const std::vector<GridCoordinate>& path) { referencePath_ = path; }
+    
+    /**
+     * @brief Search over quadtree leaves (QuadtreeSearchEngine) instead of cells
+     * @param tree Quadtree built from this planner's grid (nullptr = cell search);
+     *             labels, threads and the upper bound do not apply to it
+     */
+    void SetQuadtree(const QuadtreeGrid* tree) { quadtree_ = tree; }
+    
+    /**
+     * @brief Fuel of the reference sub-path from start to goal
+     * @return Cost in kg, or infinity if start/goal are not on the path in order
+     */
+    double ReferencePathCost(const GridCoordinate& start, const GridCoordinate& goal) const;
 
 private:
     const NavigableGrid& grid_;
@@ -66,6 +105,11 @@ private:
     unsigned int startTimeSec_;
     const std::map<std::string, WeatherDataInput>& weatherData_;
     double shipSpeedMps_;
+    int searchThreads_;
+    int maxLabelsPerCell_;
+    LabelSearchStats lastLabelStats_;
+    std::vector<GridCoordinate> referencePath_;
+    const QuadtreeGrid* quadtree_;
     
     // Heuristic parameters
     double minFuelRateKgPerHour_;
@@ -0,0 +1,411 @@
+#include "parallel_a_star_engine.h"
+#include "a_star_engine.h"
+#include "path_utils.h"
+#include <atomic>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+    // Outgoing nodes are sent in batches to reduce queue traffic
+    constexpr size_t BATCH_SIZE = 64;
+    constexpr int FLUSH_INTERVAL = 32;   // expansions between forced flushes
+
+    // ================================================================
+    // Expanded-node arena handles
+    // ================================================================
+    // A node names the exact expansion it was generated from (worker, slot)
+    // rather than its parent cell: HDA* re-opens cells, so a per-cell parent
+    // can be overwritten after the goal was reached through it.
+    struct NodeHandle {
+        int32_t worker = -1;
+        uint32_t slot = 0;
+
+        bool IsNull() const { return worker < 0; }
+    };
+
+    struct ArenaEntry {
+        GridCoordinate pos;
+        NodeHandle parent;
+    };
+
+    struct SearchNode {
+        PathNode node;
+        NodeHandle parent;
+    };
+
+    struct CompareSearchNode {
+        bool operator()(const SearchNode& a, const SearchNode& b) const {
+            return ComparePathNode()(a.node, b.node);
+        }
+    };
+
+    // ================================================================
+    // Lock-free MPSC queue of node batches
+    // ================================================================
+    struct NodeBatch {
+        std::vector<SearchNode> nodes;
+        NodeBatch* next = nullptr;
+    };
+
+    class NodeInbox {
+    public:
+        NodeInbox() : head_(nullptr) {}
+
+        ~NodeInbox() {
+            NodeBatch* batch = TakeAll();
+            while (batch) {
+                NodeBatch* next = batch->next;
+                delete batch;
+                batch = next;
+            }
+        }
+
+        // Any thread (Treiber push)
+        void Push(NodeBatch* batch) {
+            batch->next = head_.load(std::memory_order_relaxed);
+            while (!head_.compare_exchange_weak(
+                batch->next, batch,
+                std::memory_order_release,
+                std::memory_order_relaxed)) {
+            }
+        }
+
+        // Owner thread only: detach every pending batch at once
+        NodeBatch* TakeAll() {
+            return head_.exchange(nullptr, std::memory_order_acquire);
+        }
+
+    private:
+        std::atomic<NodeBatch*> head_;
+    };
+
+    struct Worker {
+        NodeInbox inbox;
+        std::priority_queue<SearchNode, std::vector<SearchNode>, CompareSearchNode> open_list;
+        std::unordered_map<uint64_t, double> g_costs;       // owned cells only
+        std::vector<ArenaEntry> arena;                      // append-only, nodes this worker expanded
+        std::vector<std::vector<SearchNode>> outgoing;      // per destination worker
+        SearchStats stats;
+        SearchNode best_goal;
+        bool has_goal = false;
+    };
+
+    uint64_t CellIndex(const NavigableGrid& grid, const GridCoordinate& pos) {
+        return grid.CellIndex(pos);
+    }
+
+    int OwnerOf(uint64_t cellIdx, int numThreads) {
+        // splitmix64 finalizer: spreads neighbouring cells over all workers
+        uint64_t z = cellIdx + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        return static_cast<int>(z % static_cast<uint64_t>(numThreads));
+    }
+
+    void UpdateIncumbent(std::atomic<double>& incumbent, double cost) {
+        double current = incumbent.load(std::memory_order_relaxed);
+        while (cost < current &&
+            !incumbent.compare_exchange_weak(current, cost, std::memory_order_relaxed)) {
+        }
+    }
+
+    // ================================================================
+    // Shared search context
+    // ================================================================
+    struct SearchContext {
+        const NavigableGrid& grid;
+        const GridCoordinate& goal;
+        const IRoutePlanner& planner;
+        int numThreads;
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        std::atomic<double> incumbent;
+        std::atomic<long long> work;   // active workers + in-flight batches
+
+        SearchContext(const NavigableGrid& g, const GridCoordinate& gl,
+            const IRoutePlanner& p, int n, double upperBound)
+            : grid(g), goal(gl), planner(p), numThreads(n)
+            , incumbent(upperBound)
+            , work(n)
+        {
+            for (int i = 0; i < n; ++i) {
+                workers.push_back(std::make_unique<Worker>());
+                workers.back()->outgoing.resize(n);
+            }
+        }
+
+        // Node arrives at its owner (local generation or message)
+        void Receive(Worker& self, const SearchNode& entry) {
+            const PathNode& node = entry.node;
+            if (node.f_cost >= incumbent.load(std::memory_order_relaxed)) {
+                return;
+            }
+            uint64_t idx = CellIndex(grid, node.pos);
+            auto it = self.g_costs.find(idx);
+            if (it != self.g_costs.end() && node.g_cost >= it->second) {
+                return;
+            }
+            self.g_costs[idx] = node.g_cost;
+            self.open_list.push(entry);
+        }
+
+        void Flush(Worker& self, int dest) {
+            auto& buffer = self.outgoing[dest];
+            if (buffer.empty()) {
+                return;
+            }
+            NodeBatch* batch = new NodeBatch();
+            batch->nodes.swap(buffer);
+            work.fetch_add(1, std::memory_order_acq_rel);   // count before it is visible
+            workers[dest]->inbox.Push(batch);
+        }
+
+        void FlushAll(Worker& self) {
+            for (int dest = 0; dest < numThreads; ++dest) {
+                Flush(self, dest);
+            }
+        }
+
+        void Expand(Worker& self, int selfId, const SearchNode& entry) {
+            const PathNode& current = entry.node;
+            if (current.pos == goal) {
+                UpdateIncumbent(incumbent, current.g_cost);
+                if (!self.has_goal || current.g_cost < self.best_goal.node.g_cost) {
+                    self.best_goal = entry;
+                    self.has_goal = true;
+                }
+                return;
+            }
+            ++self.stats.nodes_expanded;
+
+            // Children point at this expansion, not at the (re-openable) cell
+            NodeHandle handle{ selfId, static_cast<uint32_t>(self.arena.size()) };
+            self.arena.push_back(ArenaEntry{ current.pos, entry.parent });
+
+            uint8_t neighbors = grid.NeighborMask(current.pos.row, current.pos.col);
+            while (neighbors) {
+                int i = PopNeighbor(neighbors);
+                GridCoordinate neighbor_pos = grid.Neighbor(current.pos.row, current.pos.col, i);
+
+                if (neighbor_pos == current.parent_pos) {
+                    continue;
+                }
+                if (!planner.IsValidTransition(current, neighbor_pos)) {
+                    continue;
+                }
+
+                EdgeCostResult edge = planner.ComputeEdgeCost(
+                    current.pos,
+                    neighbor_pos,
+                    current.accumulated_time_hours
+                );
+                ++self.stats.edge_evaluations;
+
+                double new_g_cost = current.g_cost + edge.cost;
+                double h_cost = planner.ComputeHeuristic(neighbor_pos, goal);
+                if (new_g_cost + h_cost >= incumbent.load(std::memory_order_relaxed)) {
+                    ++self.stats.nodes_pruned;
+                    continue;
+                }
+
+                SearchNode neighbor_node{ PathNode(
+                    neighbor_pos,
+                    new_g_cost,
+                    h_cost,
+                    current.pos,
+                    current.accumulated_time_hours + edge.deltaTimeHours
+                ), handle };
+                ++self.stats.nodes_pushed;
+
+                int owner = OwnerOf(CellIndex(grid, neighbor_pos), numThreads);
+                if (owner == selfId) {
+                    Receive(self, neighbor_node);
+                } else {
+                    self.outgoing[owner].push_back(neighbor_node);
+                    if (self.outgoing[owner].size() >= BATCH_SIZE) {
+                        Flush(self, owner);
+                    }
+                }
+            }
+        }
+
+        void Run(int selfId) {
+            Worker& self = *workers[selfId];
+            bool active = true;
+            int sinceFlush = 0;
+
+            while (true) {
+                // 1) Drain inbox
+                NodeBatch* batch = self.inbox.TakeAll();
+                if (batch) {
+                    if (!active) {
+                        work.fetch_add(1, std::memory_order_acq_rel);   // before consuming
+                        active = true;
+                    }
+                    long long consumed = 0;
+                    while (batch) {
+                        for (const auto& node : batch->nodes) {
+                            Receive(self, node);
+                        }
+                        NodeBatch* next = batch->next;
+                        delete batch;
+                        batch = next;
+                        ++consumed;
+                    }
+                    work.fetch_sub(consumed, std::memory_order_acq_rel);
+                }
+
+                // 2) Pop the best useful local node
+                double bound = incumbent.load(std::memory_order_relaxed);
+                bool expanded = false;
+                while (!self.open_list.empty()) {
+                    SearchNode current = self.open_list.top();
+                    if (current.node.f_cost >= bound) {
+                        // Nothing left below the incumbent
+                        self.open_list = decltype(self.open_list)();
+                        break;
+                    }
+                    self.open_list.pop();
+
+                    auto it = self.g_costs.find(CellIndex(grid, current.node.pos));
+                    if (it != self.g_costs.end() && current.node.g_cost > it->second) {
+                        continue;   // stale entry
+                    }
+
+                    Expand(self, selfId, current);
+                    expanded = true;
+                    break;
+                }
+
+                if (expanded) {
+                    if (++sinceFlush >= FLUSH_INTERVAL) {
+                        FlushAll(self);
+                        sinceFlush = 0;
+                    }
+                    continue;
+                }
+
+                // 3) No local work: publish buffered nodes, then go idle
+                FlushAll(self);
+                sinceFlush = 0;
+                if (active) {
+                    work.fetch_sub(1, std::memory_order_acq_rel);
+                    active = false;
+                }
+                if (work.load(std::memory_order_acquire) == 0) {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+        }
+    };
+
+}  // namespace
+
+PathSearchResult ParallelAStarEngine::Search(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal,
+    const IRoutePlanner& planner,
+    int numThreads,
+    double upperBound)
+{
+    if (numThreads <= 1) {
+        return AStarEngine::Search(grid, start, goal, planner, upperBound);
+    }
+
+    // ================================================================
+    // 1. Validate start and goal
+    // ================================================================
+    if (!IsValidAndNavigable(grid, start) || !IsValidAndNavigable(grid, goal)) {
+        std::cerr << "[ParallelAStarEngine] Error: Start or Goal position is not navigable." << std::endl;
+        return PathSearchResult();
+    }
+
+    if (start == goal) {
+        PathSearchResult result;
+        result.path = { start };
+        result.total_cost = 0.0;
+        result.total_time_hours = 0.0;
+        return result;
+    }
+
+    // ================================================================
+    // 2. Seed the start node at its owner and run workers
+    // ================================================================
+    // Nodes are pruned at f >= incumbent; keep a path costing exactly upperBound
+    double initialIncumbent = std::isinf(upperBound)
+        ? upperBound
+        : std::nextafter(upperBound, std::numeric_limits<double>::infinity());
+    SearchContext ctx(grid, goal, planner, numThreads, initialIncumbent);
+
+    double initial_h = planner.ComputeHeuristic(start, goal);
+    PathNode start_node(start, 0.0, initial_h, GridCoordinate(-1, -1), 0.0);
+    int startOwner = OwnerOf(CellIndex(grid, start), numThreads);
+    ctx.Receive(*ctx.workers[startOwner], SearchNode{ start_node, NodeHandle() });
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (int i = 0; i < numThreads; ++i) {
+        threads.emplace_back([&ctx, i]() { ctx.Run(i); });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    // ================================================================
+    // 3. Collect best goal and statistics
+    // ================================================================
+    SearchStats stats;
+    const Worker* goalWorker = nullptr;
+    for (const auto& worker : ctx.workers) {
+        stats.nodes_expanded += worker->stats.nodes_expanded;
+        stats.nodes_pushed += worker->stats.nodes_pushed;
+        stats.edge_evaluations += worker->stats.edge_evaluations;
+        stats.nodes_pruned += worker->stats.nodes_pruned;
+        if (worker->has_goal &&
+            (!goalWorker || worker->best_goal.node.g_cost < goalWorker->best_goal.node.g_cost)) {
+            goalWorker = worker.get();
+        }
+    }
+
+    if (!goalWorker) {
+        std::cerr << "[ParallelAStarEngine] Error: Path not found from ("
+                  << start.row << ", " << start.col << ") to ("
+                  << goal.row << ", " << goal.col << ")" << std::endl;
+        PathSearchResult result;
+        result.stats = stats;
+        return result;
+    }
+
+    // ================================================================
+    // 4. Reconstruct path through the expansion arenas
+    // ================================================================
+    // The chain is the exact sequence of expansions that produced the goal
+    // node, so its cost, time and turns are the ones the search evaluated.
+    const PathNode& goalNode = goalWorker->best_goal.node;
+    std::vector<GridCoordinate> path = { goal };
+    for (NodeHandle h = goalWorker->best_goal.parent; !h.IsNull();) {
+        const ArenaEntry& entry = ctx.workers[h.worker]->arena[h.slot];
+        path.push_back(entry.pos);
+        h = entry.parent;
+    }
+    std::reverse(path.begin(), path.end());
+
+    PathSearchResult result;
+    result.path = path;
+    result.total_cost = goalNode.g_cost;
+    result.total_time_hours = goalNode.accumulated_time_hours;
+    result.stats = stats;
+    return result;
+}
\ No newline at end of file
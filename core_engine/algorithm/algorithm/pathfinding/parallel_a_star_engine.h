@@ -0,0 +1,50 @@
+#pragma once
+
+#include "path_types.h"
+#include "route_planner.h"
+#include "../types/grid_types.h"
+#include <limits>
+
+/**
+ * @class ParallelAStarEngine
+ * @brief Hash-distributed A* (HDA*) for large grids
+ *
+ * Every cell is owned by one worker thread (hash of the cell index). A worker
+ * keeps its own open list and g-values for the cells it owns, expands them, and
+ * sends generated nodes for cells owned by other workers through lock-free
+ * MPSC queues. Nodes whose f-cost is not below the best goal cost found so far
+ * are pruned. Each worker appends the nodes it expands to its own arena and
+ * generated nodes carry a (worker, slot) handle to that entry, so the path is
+ * rebuilt from the exact chain that produced the best goal even though cells
+ * may be re-opened.
+ *
+ * Termination: a shared counter holds (active workers + in-flight messages).
+ * A worker goes idle when its open list has nothing below the incumbent and its
+ * inbox is empty. The search ends when the counter reaches zero.
+ *
+ * The planner is shared by all workers, so its const methods (ComputeEdgeCost,
+ * ComputeHeuristic, IsValidTransition) must be safe to call concurrently.
+ */
+class ParallelAStarEngine {
+public:
+    /**
+     * @brief Execute HDA* search with given strategy
+     *
+     * @param grid Navigable grid
+     * @param start Start grid coordinate
+     * @param goal Goal grid coordinate
+     * @param planner Strategy for cost/heuristic computation
+     * @param numThreads Worker threads (<= 1 falls back to AStarEngine)
+     * @param upperBound Known cost of a feasible path, used as the initial
+     *                   incumbent (infinity = no bound)
+     * @return PathSearchResult with path and total cost
+     */
+    static PathSearchResult Search(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal,
+        const IRoutePlanner& planner,
+        int numThreads,
+        double upperBound = std::numeric_limits<double>::infinity()
+    );
+};
@@ -53,6 +53,23 @@ struct EdgeCostResult {
     EdgeCostResult(double c, double t) : cost(c), deltaTimeHours(t) {}
 };
 
+// ================================================================
+// Search Statistics
+// ================================================================
+struct SearchStats {
+    size_t nodes_expanded;     // Nodes popped and expanded
+    size_t nodes_pushed;       // Nodes pushed to the open list(s)
+    size_t edge_evaluations;   // ComputeEdgeCost calls
+    size_t nodes_pruned;       // Pushes skipped by the upper bound
+    
+    SearchStats()
+        : nodes_expanded(0)
+        , nodes_pushed(0)
+        , edge_evaluations(0)
+        , nodes_pruned(0)
+    {}
+};
+
 // ================================================================
 // A* Search Result
 // ================================================================
@@ -60,6 +77,7 @@ struct PathSearchResult {
     std::vector<GridCoordinate> path;  // Grid path
     double total_cost;                 // Total cost (distance or fuel)
     double total_time_hours;           // Total time in hours
+    SearchStats stats;                 // Search effort
     
     PathSearchResult()
         : total_cost(-1.0)
@@ -1,38 +1,10 @@
 #include "path_utils.h"
 #include <cmath>
 
-bool IsValidAndNavigable(
-    const NavigableGrid& grid,
-    int row,
-    int col)
-{
-    return grid.IsValid(row, col) && grid.IsNavigable(row, col);
-}
-
-bool IsValidAndNavigable(
-    const NavigableGrid& grid,
-    const GridCoordinate& pos)
-{
-    return IsValidAndNavigable(grid, pos.row, pos.col);
-}
+namespace {
 
-bool AngleCheck(
-    const PathNode& current_node,
-    int dx_curr,
-    int dy_curr)
+bool AngleWithinLimit(int dx_prev, int dy_prev, int dx_curr, int dy_curr)
 {
-    GridCoordinate current_pos = current_node.pos;
-    GridCoordinate parent_pos = current_node.parent_pos;
-    
-    // First move: no parent, always valid
-    if (parent_pos.row == -1) {
-        return true;
-    }
-    
-    // Calculate previous movement direction
-    int dx_prev = current_pos.row - parent_pos.row;
-    int dy_prev = current_pos.col - parent_pos.col;
-    
     // Calculate magnitudes
     double mag_prev = std::sqrt((double)dx_prev * dx_prev + (double)dy_prev * dy_prev);
     double mag_curr = std::sqrt((double)dx_curr * dx_curr + (double)dy_curr * dy_curr);
@@ -61,4 +33,40 @@ bool AngleCheck(
     
     // Check if within limit
     return angle_change <= MAX_ANGLE_DEGREES;
+}
+
+}  // namespace
+
+bool AngleCheck(
+    const PathNode& current_node,
+    int dx_curr,
+    int dy_curr)
+{
+    GridCoordinate current_pos = current_node.pos;
+    GridCoordinate parent_pos = current_node.parent_pos;
+    
+    // First move: no parent, always valid
+    if (parent_pos.row == -1) {
+        return true;
+    }
+    
+    // Calculate previous movement direction
+    int dx_prev = current_pos.row - parent_pos.row;
+    int dy_prev = current_pos.col - parent_pos.col;
+    
+    return AngleWithinLimit(dx_prev, dy_prev, dx_curr, dy_curr);
+}
+
+bool AngleCheck(
+    const NavigableGrid& grid,
+    const PathNode& current_node,
+    int dx_curr,
+    int dy_curr)
+{
+    if (current_node.parent_pos.row == -1) {
+        return true;
+    }
+    int dx_prev = current_node.pos.row - current_node.parent_pos.row;
+    int dy_prev = grid.ColumnStep(current_node.parent_pos, current_node.pos);
+    return AngleWithinLimit(dx_prev, dy_prev, dx_curr, dy_curr);
 }
\ No newline at end of file
@@ -15,6 +15,29 @@ constexpr double MAX_ANGLE_DEGREES = 90.0;
 constexpr int DX_8DIR[8] = { -1, -1, -1,  0,  0,  1,  1,  1 };
 constexpr int DY_8DIR[8] = { -1,  0,  1, -1,  1, -1,  0,  1 };
 
+constexpr bool MatchesNeighborMaskOrder() {
+    for (int i = 0; i < 8; ++i) {
+        if (DX_8DIR[i] != NEIGHBOR_DROW[i] || DY_8DIR[i] != NEIGHBOR_DCOL[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(MatchesNeighborMaskOrder(), "DX_8DIR/DY_8DIR must follow NavigableGrid neighbour mask bits");
+
+/**
+ * @brief Pop the lowest set bit of a neighbour mask
+ * @return Direction index (0-7) into DX_8DIR/DY_8DIR
+ */
+inline int PopNeighbor(uint8_t& mask) {
+    int i = 0;
+    while (!(mask & (1u << i))) {
+        ++i;
+    }
+    mask = static_cast<uint8_t>(mask & (mask - 1));
+    return i;
+}
+
 // ================================================================
 // Grid Validation
 // ================================================================
@@ -22,16 +45,20 @@ constexpr int DY_8DIR[8] = { -1,  0,  1, -1,  1, -1,  0,  1 };
 /**
  * @brief Check if a grid position is valid and navigable
  */
-bool IsValidAndNavigable(
+inline bool IsValidAndNavigable(
     const NavigableGrid& grid,
     int row,
-    int col
-);
+    int col)
+{
+    return grid.IsNavigable(row, col);  // Bounds check + navigability bit
+}
 
-bool IsValidAndNavigable(
+inline bool IsValidAndNavigable(
     const NavigableGrid& grid,
-    const GridCoordinate& pos
-);
+    const GridCoordinate& pos)
+{
+    return grid.IsNavigable(pos.row, pos.col);
+}
 
 // ================================================================
 // Angle Limiting
@@ -53,4 +80,18 @@ bool AngleCheck(
     const PathNode& current_node,
     int dx_curr,
     int dy_curr
+);
+
+/**
+ * @brief AngleCheck for equal-distance grids
+ *
+ * The previous step (parent -> current) is measured with
+ * NavigableGrid::ColumnStep so that a move straight north/south keeps
+ * dy = 0 even when the two rows have different column counts.
+ */
+bool AngleCheck(
+    const NavigableGrid& grid,
+    const PathNode& current_node,
+    int dx_curr,
+    int dy_curr
 );
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "quadtree_search_engine.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+
+PathSearchResult QuadtreeSearchEngine::Search(
+    const QuadtreeGrid& tree,
+    const GridCoordinate& start,
+    const GridCoordinate& goal,
+    const IRoutePlanner& planner)
+{
+    // ================================================================
+    // 1. Validate start and goal
+    // ================================================================
+    int32_t startLeaf = tree.LeafAt(start);
+    int32_t goalLeaf = tree.LeafAt(goal);
+    if (startLeaf < 0 || goalLeaf < 0 ||
+        !tree.Leaf(startLeaf).navigable || !tree.Leaf(goalLeaf).navigable) {
+        std::cerr << "[QuadtreeSearchEngine] Error: Start or Goal position is not navigable." << std::endl;
+        return PathSearchResult();
+    }
+
+    if (start == goal) {
+        PathSearchResult result;
+        result.path = { start };
+        result.total_cost = 0.0;
+        result.total_time_hours = 0.0;
+        return result;
+    }
+
+    // Node position of a leaf
+    auto position = [&](int32_t leaf) {
+        if (leaf == startLeaf) return start;
+        if (leaf == goalLeaf) return goal;
+        return tree.Leaf(leaf).Center();
+    };
+
+    if (startLeaf == goalLeaf) {
+        // Straight move inside one navigable leaf
+        EdgeCostResult edge = planner.ComputeEdgeCost(start, goal, 0.0);
+        PathSearchResult result;
+        result.path = { start, goal };
+        result.total_cost = edge.cost;
+        result.total_time_hours = edge.deltaTimeHours;
+        result.stats.edge_evaluations = 1;
+        return result;
+    }
+
+    // ================================================================
+    // 2. Dense per-leaf state (leaf count << cell count)
+    // ================================================================
+    SearchStats stats;
+    size_t leafCount = static_cast<size_t>(tree.LeafCount());
+    std::vector<double> g(leafCount, std::numeric_limits<double>::infinity());
+    std::vector<double> timeHours(leafCount, 0.0);
+    std::vector<int32_t> parent(leafCount, -1);
+    std::vector<uint8_t> closed(leafCount, 0);
+
+    using QueueEntry = std::pair<double, int32_t>;   // (f, leaf)
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open_list;
+
+    g[startLeaf] = 0.0;
+    open_list.push({ planner.ComputeHeuristic(start, goal), startLeaf });
+    ++stats.nodes_pushed;
+
+    // ================================================================
+    // 3. Main loop
+    // ================================================================
+    bool found = false;
+    while (!open_list.empty()) {
+        int32_t current = open_list.top().second;
+        open_list.pop();
+
+        if (closed[current]) {
+            continue;
+        }
+        if (current == goalLeaf) {
+            found = true;
+            break;
+        }
+        closed[current] = 1;
+        ++stats.nodes_expanded;
+
+        GridCoordinate currentPos = position(current);
+        PathNode currentNode(currentPos, g[current], 0.0,
+            parent[current] >= 0 ? position(parent[current]) : GridCoordinate(-1, -1),
+            timeHours[current]);
+        for (const int32_t* it = tree.NeighborsBegin(current); it != tree.NeighborsEnd(current); ++it) {
+            int32_t next = *it;
+            if (closed[next]) {
+                continue;
+            }
+
+            GridCoordinate nextPos = position(next);
+
+            // Turn limit between leaf moves (same rule as between unit steps)
+            if (!planner.IsValidTransition(currentNode, nextPos)) {
+                continue;
+            }
+
+            EdgeCostResult edge = planner.ComputeEdgeCost(currentPos, nextPos, timeHours[current]);
+            ++stats.edge_evaluations;
+
+            double newG = g[current] + edge.cost;
+            if (newG < g[next]) {
+                g[next] = newG;
+                timeHours[next] = timeHours[current] + edge.deltaTimeHours;
+                parent[next] = current;
+                open_list.push({ newG + planner.ComputeHeuristic(nextPos, goal), next });
+                ++stats.nodes_pushed;
+            }
+        }
+    }
+
+    if (!found) {
+        std::cerr << "[QuadtreeSearchEngine] Error: Path not found from ("
+                  << start.row << ", " << start.col << ") to ("
+                  << goal.row << ", " << goal.col << ")" << std::endl;
+        PathSearchResult result;
+        result.stats = stats;
+        return result;
+    }
+
+    // ================================================================
+    // 4. Reconstruct path through the leaf positions
+    // ================================================================
+    std::vector<GridCoordinate> path;
+    for (int32_t leaf = goalLeaf; leaf >= 0; leaf = parent[leaf]) {
+        path.push_back(position(leaf));
+    }
+    std::reverse(path.begin(), path.end());
+
+    PathSearchResult result;
+    result.path = path;
+    result.total_cost = g[goalLeaf];
+    result.total_time_hours = timeHours[goalLeaf];
+    result.stats = stats;
+    return result;
+}
\ No newline at end of file
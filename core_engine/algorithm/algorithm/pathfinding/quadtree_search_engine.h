@@ -0,0 +1,39 @@
+#pragma once
+
+#include "path_types.h"
+#include "route_planner.h"
+#include "../types/quadtree_grid.h"
+
+/**
+ * @class QuadtreeSearchEngine
+ * @brief A* over the navigable leaves of a QuadtreeGrid
+ *
+ * Nodes are leaves, placed at their centre cell (the start and goal leaves
+ * at the start and goal cells), and edges are the quadtree neighbour links.
+ * Edge cost, heuristic and time accumulation come from the planner, whose
+ * grid must be the quadtree's source grid. The planner's IsValidTransition
+ * (turn limit) is checked on every leaf-to-leaf move, with the incoming
+ * move taken from the parent leaf's position.
+ *
+ * Build the quadtree with the start and goal as fine cells so the first and
+ * last moves start from 1x1 leaves. The path lists source-grid cells with
+ * straight, navigable segments between consecutive entries.
+ */
+class QuadtreeSearchEngine {
+public:
+    /**
+     * @brief Execute A* search over quadtree leaves
+     *
+     * @param tree Quadtree built from the planner's grid
+     * @param start Start grid coordinate
+     * @param goal Goal grid coordinate
+     * @param planner Strategy for cost/heuristic computation
+     * @return PathSearchResult with (sparse) path and total cost
+     */
+    static PathSearchResult Search(
+        const QuadtreeGrid& tree,
+        const GridCoordinate& start,
+        const GridCoordinate& goal,
+        const IRoutePlanner& planner
+    );
+};
\ No newline at end of file
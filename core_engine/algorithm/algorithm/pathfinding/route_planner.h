@@ -76,4 +76,13 @@ public:
         const PathNode& current_node,
         const GridCoordinate& neighbor_pos
     ) const = 0;
+    
+    /**
+     * @brief Whether paths may leave the 8-connected cell graph
+     * 
+     * Any-angle planners link cells by line of sight, so two cells in
+     * different 8-connected components (NavigableGrid::ComponentOf) can
+     * still be joined; callers must not reject such legs up front.
+     */
+    virtual bool IsAnyAngle() const { return false; }
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "shortest_planner.h"
 #include "a_star_engine.h"
+#include "parallel_a_star_engine.h"
+#include "quadtree_search_engine.h"
 #include "path_utils.h"
 #include "../utils/geo_calculations.h"
 #include "../utils/time_calculator.h"
@@ -10,6 +12,8 @@ ShortestRoutePlanner::ShortestRoutePlanner(
     double shipSpeedMps)
     : grid_(grid)
     , shipSpeedMps_(shipSpeedMps)
+    , searchThreads_(1)
+    , quadtree_(nullptr)
 {
 }
 
@@ -18,7 +22,11 @@ PathSearchResult ShortestRoutePlanner::FindPath(
     const GridCoordinate& start,
     const GridCoordinate& goal)
 {    
-    PathSearchResult result = AStarEngine::Search(grid, start, goal, *this);
+    PathSearchResult result = quadtree_
+        ? QuadtreeSearchEngine::Search(*quadtree_, start, goal, *this)
+        : (searchThreads_ > 1)
+        ? ParallelAStarEngine::Search(grid, start, goal, *this, searchThreads_)
+        : AStarEngine::Search(grid, start, goal, *this);
     
     if (result.IsSuccess()) {
         std::cout << "[ShortestPlanner] Shortest: " << result.total_cost << " km, " 
@@ -76,10 +84,10 @@ bool ShortestRoutePlanner::IsValidTransition(
     const PathNode& current_node,
     const GridCoordinate& neighbor_pos) const
 {
-    // Calculate direction to neighbor
+    // Calculate direction to neighbor (column step re-based on equal-distance grids)
     int dx = neighbor_pos.row - current_node.pos.row;
-    int dy = neighbor_pos.col - current_node.pos.col;
+    int dy = grid_.ColumnStep(current_node.pos, neighbor_pos);
     
     // Check angle constraint
-    return AngleCheck(current_node, dx, dy);
+    return AngleCheck(grid_, current_node, dx, dy);
 }
\ No newline at end of file
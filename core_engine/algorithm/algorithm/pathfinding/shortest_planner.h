@@ -3,6 +3,7 @@
 #include "route_planner.h"
 #include "path_types.h"
 #include "../types/grid_types.h"
+#include "../types/quadtree_grid.h"
 
 /**
  * @class ShortestRoutePlanner
@@ -49,8 +50,21 @@ public:
         const PathNode& current_node,
         const GridCoordinate& neighbor_pos
     ) const override;
+    
+    /**
+     * @brief Set worker threads for FindPath (> 1 uses ParallelAStarEngine)
+     */
+    void SetSearchThreads(int numThreads) { searchThreads_ = numThreads; }
+    
+    /**
+     * @brief Search over quadtree leaves (QuadtreeSearchEngine) instead of cells
+     * @param tree Quadtree built from this planner's grid (nullptr = cell search)
+     */
+    void SetQuadtree(const QuadtreeGrid* tree) { quadtree_ = tree; }
 
 private:
     const NavigableGrid& grid_;
     double shipSpeedMps_;
+    int searchThreads_;
+    const QuadtreeGrid* quadtree_;
 };
\ No newline at end of file
@@ -0,0 +1,590 @@
+#include "visibility_graph_planner.h"
+#include "path_utils.h"
+#include "../utils/geo_calculations.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+
+    constexpr double KM_PER_DEGREE = 111.195;
+    constexpr int MAX_BUCKETS_PER_SIDE = 1024;
+
+    struct Vec2 {
+        double x;
+        double y;
+    };
+
+    // Twice the signed area of (o, a, b): > 0 when b is left of o -> a
+    double Cross(double ox, double oy, double ax, double ay, double bx, double by) {
+        return (ax - ox) * (by - oy) - (ay - oy) * (bx - ox);
+    }
+
+    double KmPerDegreeLon(double lat) {
+        return std::max(0.01, std::cos(lat * PI / 180.0)) * KM_PER_DEGREE;
+    }
+
+    // Distance (km) from p to segment a-b in the local frame at a
+    double SegmentDistanceKm(const Vec2& p, const Vec2& a, const Vec2& b) {
+        double sx = KmPerDegreeLon(a.y);
+        double ux = (b.x - a.x) * sx, uy = (b.y - a.y) * KM_PER_DEGREE;
+        double vx = (p.x - a.x) * sx, vy = (p.y - a.y) * KM_PER_DEGREE;
+        double len2 = ux * ux + uy * uy;
+        double t = (len2 > 0.0) ? std::clamp((ux * vx + uy * vy) / len2, 0.0, 1.0) : 0.0;
+        double dx = vx - t * ux, dy = vy - t * uy;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+
+    // Douglas-Peucker on a closed ring (no repeated closing point)
+    std::vector<Vec2> SimplifyRing(const std::vector<Vec2>& ring, double toleranceKm) {
+        size_t n = ring.size();
+        if (toleranceKm <= 0.0 || n <= 4) {
+            return ring;
+        }
+
+        // Split the ring at vertex 0 and the vertex farthest from it
+        size_t far = 0;
+        double farDist = -1.0;
+        for (size_t i = 1; i < n; ++i) {
+            double d = SegmentDistanceKm(ring[i], ring[0], ring[0]);
+            if (d > farDist) { farDist = d; far = i; }
+        }
+
+        std::vector<uint8_t> keep(n, 0);
+        keep[0] = keep[far] = 1;
+        std::vector<std::pair<size_t, size_t>> stack = { { 0, far }, { far, n } };   // n wraps to 0
+        while (!stack.empty()) {
+            auto [i, j] = stack.back();
+            stack.pop_back();
+            const Vec2& a = ring[i];
+            const Vec2& b = ring[j % n];
+            size_t worst = i;
+            double worstDist = toleranceKm;
+            for (size_t k = i + 1; k < j; ++k) {
+                double d = SegmentDistanceKm(ring[k], a, b);
+                if (d > worstDist) { worstDist = d; worst = k; }
+            }
+            if (worst != i) {
+                keep[worst] = 1;
+                stack.push_back({ i, worst });
+                stack.push_back({ worst, j });
+            }
+        }
+
+        std::vector<Vec2> out;
+        for (size_t i = 0; i < n; ++i) {
+            if (keep[i]) out.push_back(ring[i]);
+        }
+        return (out.size() >= 3) ? out : ring;
+    }
+
+    // Offset a counter-clockwise ring outward by offsetKm (miter joins;
+    // convex corners sharper than 120 degrees are bevelled)
+    std::vector<Vec2> InflateRing(const std::vector<Vec2>& ring, double offsetKm) {
+        size_t n = ring.size();
+        std::vector<Vec2> out;
+        out.reserve(n + n / 4);
+        for (size_t i = 0; i < n; ++i) {
+            const Vec2& p = ring[(i + n - 1) % n];
+            const Vec2& v = ring[i];
+            const Vec2& q = ring[(i + 1) % n];
+
+            // Local km frame at v
+            double sx = KmPerDegreeLon(v.y);
+            double e1x = (v.x - p.x) * sx, e1y = (v.y - p.y) * KM_PER_DEGREE;
+            double e2x = (q.x - v.x) * sx, e2y = (q.y - v.y) * KM_PER_DEGREE;
+            double l1 = std::hypot(e1x, e1y), l2 = std::hypot(e2x, e2y);
+            if (l1 <= 0.0 || l2 <= 0.0) {
+                continue;
+            }
+            // Outward normals (right of travel for a CCW ring)
+            double n1x = e1y / l1, n1y = -e1x / l1;
+            double n2x = e2y / l2, n2y = -e2x / l2;
+            double dot = n1x * n2x + n1y * n2y;
+            bool convex = (e1x * e2y - e1y * e2x) > 0.0;
+
+            auto emit = [&](double ox, double oy) {
+                out.push_back(Vec2{ v.x + ox / sx, v.y + oy / KM_PER_DEGREE });
+            };
+            if (convex && dot < -0.5) {
+                emit(n1x * offsetKm, n1y * offsetKm);
+                emit(n2x * offsetKm, n2y * offsetKm);
+                continue;
+            }
+            double scale = offsetKm / std::max(1.0 + dot, 1e-9);
+            double mx = (n1x + n2x) * scale, my = (n1y + n2y) * scale;
+            double len = std::hypot(mx, my);
+            if (len > 4.0 * offsetKm) {   // Narrow inlet: cap the miter
+                mx *= 4.0 * offsetKm / len;
+                my *= 4.0 * offsetKm / len;
+            }
+            emit(mx, my);
+        }
+        return out;
+    }
+
+    bool ProperIntersect(double ax, double ay, double bx, double by,
+                         double cx, double cy, double dx, double dy) {
+        double o1 = Cross(ax, ay, bx, by, cx, cy);
+        double o2 = Cross(ax, ay, bx, by, dx, dy);
+        double o3 = Cross(cx, cy, dx, dy, ax, ay);
+        double o4 = Cross(cx, cy, dx, dy, bx, by);
+        return ((o1 > 0.0 && o2 < 0.0) || (o1 < 0.0 && o2 > 0.0))
+            && ((o3 > 0.0 && o4 < 0.0) || (o3 < 0.0 && o4 > 0.0));
+    }
+
+}  // namespace
+
+VisibilityGraphPlanner::VisibilityGraphPlanner(
+    const NavigableGrid& grid,
+    double shipSpeedMps)
+    : grid_(grid)
+    , cellPlanner_(grid, shipSpeedMps)
+    , built_(false)
+    , bucketsX_(1)
+    , bucketsY_(1)
+    , bucketW_(1.0)
+    , bucketH_(1.0)
+{
+}
+
+// ================================================================
+// Graph Construction
+// ================================================================
+
+void VisibilityGraphPlanner::Build(
+    const std::vector<std::vector<GeoCoordinate>>& landRings,
+    double bufferKm,
+    double simplifyKm,
+    int numThreads)
+{
+    built_ = false;
+    nodes_.clear();
+    obstacles_.clear();
+    adjacencyOffsets_.clear();
+    adjacency_.clear();
+    adjacencyKm_.clear();
+
+    const BoundingBox& roi = grid_.Bounds();
+    const double offsetKm = std::max(0.0, bufferKm) + std::max(0.0, simplifyKm);
+
+    // ================================================================
+    // 1. Simplify, orient and inflate each ring
+    // ================================================================
+    for (const auto& geoRing : landRings) {
+        std::vector<Vec2> ring;
+        ring.reserve(geoRing.size());
+        for (const auto& pt : geoRing) {
+            Vec2 v{ pt.longitude, pt.latitude };
+            if (ring.empty() || ring.back().x != v.x || ring.back().y != v.y) {
+                ring.push_back(v);
+            }
+        }
+        while (ring.size() > 1 && ring.front().x == ring.back().x && ring.front().y == ring.back().y) {
+            ring.pop_back();
+        }
+        if (ring.size() < 3) {
+            continue;
+        }
+
+        ring = SimplifyRing(ring, simplifyKm);
+        double area2 = 0.0;
+        for (size_t i = 0; i < ring.size(); ++i) {
+            const Vec2& a = ring[i];
+            const Vec2& b = ring[(i + 1) % ring.size()];
+            area2 += a.x * b.y - b.x * a.y;
+        }
+        if (area2 < 0.0) {
+            std::reverse(ring.begin(), ring.end());
+        }
+        std::vector<Vec2> inflated = InflateRing(ring, offsetKm);
+        size_t n = inflated.size();
+        if (n < 3) {
+            continue;
+        }
+
+        for (size_t i = 0; i < n; ++i) {
+            const Vec2& p = inflated[(i + n - 1) % n];
+            const Vec2& v = inflated[i];
+            const Vec2& q = inflated[(i + 1) % n];
+
+            // Obstacle edges touching the bounds
+            if (!(std::max(v.x, q.x) < roi.minLon || std::min(v.x, q.x) > roi.maxLon ||
+                  std::max(v.y, q.y) < roi.minLat || std::min(v.y, q.y) > roi.maxLat)) {
+                obstacles_.push_back(Segment{ Point{ v.x, v.y }, Point{ q.x, q.y } });
+            }
+
+            // Shortest paths only bend at convex vertices
+            if (Cross(p.x, p.y, v.x, v.y, q.x, q.y) <= 0.0) {
+                continue;
+            }
+            if (v.x <= roi.minLon || v.x >= roi.maxLon || v.y <= roi.minLat || v.y >= roi.maxLat) {
+                continue;
+            }
+            GridCoordinate cell = grid_.GeoToGrid(GeoCoordinate(v.y, v.x));
+            if (!grid_.IsNavigable(cell.row, cell.col)) {
+                continue;
+            }
+            nodes_.push_back(Node{ Point{ v.x, v.y }, Point{ p.x, p.y }, Point{ q.x, q.y }, cell });
+        }
+    }
+
+    BuildBuckets();
+
+    // ================================================================
+    // 2. Bitangent, unblocked node pairs (rows of the pair matrix in parallel)
+    // ================================================================
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    const size_t count = nodes_.size();
+    numThreads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(numThreads, count / 64 + 1)));
+
+    std::vector<std::vector<std::pair<uint32_t, uint32_t>>> found(numThreads);
+    auto linkRows = [&](int t) {
+        for (size_t i = t; i < count; i += numThreads) {
+            const Node& a = nodes_[i];
+            for (size_t j = i + 1; j < count; ++j) {
+                const Node& b = nodes_[j];
+                if (!IsTangent(a, b.pos) || !IsTangent(b, a.pos)) {
+                    continue;
+                }
+                if (!SegmentBlocked(a.pos, b.pos)) {
+                    found[t].push_back({ static_cast<uint32_t>(i), static_cast<uint32_t>(j) });
+                }
+            }
+        }
+    };
+    if (numThreads == 1) {
+        linkRows(0);
+    } else {
+        std::vector<std::thread> workers;
+        for (int t = 0; t < numThreads; ++t) {
+            workers.emplace_back(linkRows, t);
+        }
+        for (auto& w : workers) {
+            w.join();
+        }
+    }
+
+    // ================================================================
+    // 3. CSR adjacency in both directions
+    // ================================================================
+    adjacencyOffsets_.assign(count + 1, 0);
+    for (const auto& list : found) {
+        for (const auto& e : list) {
+            ++adjacencyOffsets_[e.first + 1];
+            ++adjacencyOffsets_[e.second + 1];
+        }
+    }
+    for (size_t i = 0; i < count; ++i) {
+        adjacencyOffsets_[i + 1] += adjacencyOffsets_[i];
+    }
+    adjacency_.resize(adjacencyOffsets_[count]);
+    adjacencyKm_.resize(adjacencyOffsets_[count]);
+    std::vector<uint32_t> fill(adjacencyOffsets_.begin(), adjacencyOffsets_.end() - 1);
+    for (const auto& list : found) {
+        for (const auto& e : list) {
+            const Point& a = nodes_[e.first].pos;
+            const Point& b = nodes_[e.second].pos;
+            double km = greatCircleDistance(a.y, a.x, b.y, b.x);
+            adjacency_[fill[e.first]] = e.second;
+            adjacencyKm_[fill[e.first]++] = km;
+            adjacency_[fill[e.second]] = e.first;
+            adjacencyKm_[fill[e.second]++] = km;
+        }
+    }
+
+    built_ = true;
+    std::cout << "[VisibilityGraph] " << nodes_.size() << " nodes, " << EdgeCount() << " edges, "
+              << obstacles_.size() << " obstacle edges (buffer " << offsetKm << " km)" << std::endl;
+}
+
+void VisibilityGraphPlanner::BuildBuckets() {
+    const BoundingBox& roi = grid_.Bounds();
+    int side = static_cast<int>(std::ceil(std::sqrt(static_cast<double>(obstacles_.size()) / 2.0)));
+    side = std::clamp(side, 1, MAX_BUCKETS_PER_SIDE);
+    bucketsX_ = side;
+    bucketsY_ = side;
+    bucketW_ = std::max(roi.Width(), 1e-9) / bucketsX_;
+    bucketH_ = std::max(roi.Height(), 1e-9) / bucketsY_;
+
+    // Count, prefix sum, fill (edges registered in every bucket their bbox overlaps)
+    auto forEachBucket = [&](const Segment& s, const std::function<void(size_t)>& fn) {
+        int x0 = BucketX(std::min(s.a.x, s.b.x)), x1 = BucketX(std::max(s.a.x, s.b.x));
+        int y0 = BucketY(std::min(s.a.y, s.b.y)), y1 = BucketY(std::max(s.a.y, s.b.y));
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                fn(static_cast<size_t>(y) * bucketsX_ + x);
+            }
+        }
+    };
+
+    size_t buckets = static_cast<size_t>(bucketsX_) * bucketsY_;
+    bucketOffsets_.assign(buckets + 1, 0);
+    for (const auto& s : obstacles_) {
+        forEachBucket(s, [&](size_t b) { ++bucketOffsets_[b + 1]; });
+    }
+    for (size_t b = 0; b < buckets; ++b) {
+        bucketOffsets_[b + 1] += bucketOffsets_[b];
+    }
+    bucketEdges_.resize(bucketOffsets_[buckets]);
+    std::vector<uint32_t> fill(bucketOffsets_.begin(), bucketOffsets_.end() - 1);
+    for (size_t i = 0; i < obstacles_.size(); ++i) {
+        forEachBucket(obstacles_[i], [&](size_t b) { bucketEdges_[fill[b]++] = static_cast<uint32_t>(i); });
+    }
+}
+
+int VisibilityGraphPlanner::BucketX(double x) const {
+    return std::clamp(static_cast<int>(std::floor((x - grid_.Bounds().minLon) / bucketW_)), 0, bucketsX_ - 1);
+}
+
+int VisibilityGraphPlanner::BucketY(double y) const {
+    return std::clamp(static_cast<int>(std::floor((y - grid_.Bounds().minLat) / bucketH_)), 0, bucketsY_ - 1);
+}
+
+// ================================================================
+// Visibility Tests
+// ================================================================
+
+bool VisibilityGraphPlanner::SegmentBlocked(const Point& a, const Point& b) const {
+    if (obstacles_.empty()) {
+        return false;
+    }
+
+    auto bucketBlocks = [&](int bx, int by) {
+        size_t bucket = static_cast<size_t>(by) * bucketsX_ + bx;
+        for (uint32_t k = bucketOffsets_[bucket]; k < bucketOffsets_[bucket + 1]; ++k) {
+            const Segment& s = obstacles_[bucketEdges_[k]];
+            if (ProperIntersect(a.x, a.y, b.x, b.y, s.a.x, s.a.y, s.b.x, s.b.y)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    // Walk the buckets along a -> b (Amanatides-Woo)
+    const BoundingBox& roi = grid_.Bounds();
+    int bx = BucketX(a.x), by = BucketY(a.y);
+    int ex = BucketX(b.x), ey = BucketY(b.y);
+    double dx = b.x - a.x, dy = b.y - a.y;
+    int stepX = (dx > 0.0) ? 1 : -1;
+    int stepY = (dy > 0.0) ? 1 : -1;
+    const double INF = std::numeric_limits<double>::infinity();
+    double tMaxX = (dx != 0.0) ? (roi.minLon + (bx + (dx > 0.0 ? 1 : 0)) * bucketW_ - a.x) / dx : INF;
+    double tMaxY = (dy != 0.0) ? (roi.minLat + (by + (dy > 0.0 ? 1 : 0)) * bucketH_ - a.y) / dy : INF;
+    double tDeltaX = (dx != 0.0) ? bucketW_ / std::abs(dx) : INF;
+    double tDeltaY = (dy != 0.0) ? bucketH_ / std::abs(dy) : INF;
+
+    for (int steps = 0; steps <= bucketsX_ + bucketsY_; ++steps) {
+        if (bucketBlocks(bx, by)) {
+            return true;
+        }
+        if (bx == ex && by == ey) {
+            break;
+        }
+        if (tMaxX < tMaxY) {
+            bx += stepX;
+            tMaxX += tDeltaX;
+        } else {
+            by += stepY;
+            tMaxY += tDeltaY;
+        }
+        if (bx < 0 || bx >= bucketsX_ || by < 0 || by >= bucketsY_) {
+            break;
+        }
+    }
+    return false;
+}
+
+bool VisibilityGraphPlanner::GridLineOfSight(const Point& a, const Point& b) const {
+    double span = std::max(std::abs(b.y - a.y) / grid_.CellSizeLat(),
+                           std::abs(b.x - a.x) / grid_.CellSizeLon());
+    int steps = std::max(1, static_cast<int>(std::ceil(span * 2.0)));
+    for (int k = 0; k <= steps; ++k) {
+        double t = static_cast<double>(k) / steps;
+        GridCoordinate cell = grid_.GeoToGrid(GeoCoordinate(a.y + (b.y - a.y) * t, a.x + (b.x - a.x) * t));
+        if (!grid_.IsNavigable(cell.row, cell.col)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool VisibilityGraphPlanner::IsTangent(const Node& node, const Point& p) {
+    double sPrev = Cross(node.pos.x, node.pos.y, p.x, p.y, node.prev.x, node.prev.y);
+    double sNext = Cross(node.pos.x, node.pos.y, p.x, p.y, node.next.x, node.next.y);
+    return !((sPrev > 0.0 && sNext < 0.0) || (sPrev < 0.0 && sNext > 0.0));
+}
+
+// ================================================================
+// Query
+// ================================================================
+
+PathSearchResult VisibilityGraphPlanner::FindPath(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal)
+{
+    if (!built_) {
+        return FallbackSearch(grid, start, goal, "graph not built");
+    }
+    if (!IsValidAndNavigable(grid_, start) || !IsValidAndNavigable(grid_, goal) || start == goal) {
+        return FallbackSearch(grid, start, goal, "trivial or invalid leg");
+    }
+
+    GeoCoordinate startGeo = grid_.GridToGeo(start);
+    GeoCoordinate goalGeo = grid_.GridToGeo(goal);
+    const Point s{ startGeo.longitude, startGeo.latitude };
+    const Point g{ goalGeo.longitude, goalGeo.latitude };
+
+    // ================================================================
+    // 1. Link start and goal: navigable cells, tangent at the node
+    // ================================================================
+    const uint32_t count = static_cast<uint32_t>(nodes_.size());
+    const uint32_t START = count;
+    const uint32_t GOAL = count + 1;
+    SearchStats stats;
+
+    std::vector<std::pair<uint32_t, double>> startLinks;
+    std::vector<double> goalLinkKm(count, -1.0);
+    for (uint32_t k = 0; k < count; ++k) {
+        const Node& node = nodes_[k];
+        if (IsTangent(node, s) && GridLineOfSight(s, node.pos)) {
+            startLinks.push_back({ k, greatCircleDistance(s.y, s.x, node.pos.y, node.pos.x) });
+        }
+        if (IsTangent(node, g) && GridLineOfSight(node.pos, g)) {
+            goalLinkKm[k] = greatCircleDistance(node.pos.y, node.pos.x, g.y, g.x);
+        }
+    }
+    if (GridLineOfSight(s, g)) {
+        startLinks.push_back({ GOAL, greatCircleDistance(s.y, s.x, g.y, g.x) });
+    }
+
+    // ================================================================
+    // 2. Dijkstra over nodes + start/goal
+    // ================================================================
+    std::vector<double> dist(count + 2, std::numeric_limits<double>::infinity());
+    std::vector<uint32_t> parent(count + 2, std::numeric_limits<uint32_t>::max());
+    using Entry = std::pair<double, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    dist[START] = 0.0;
+    open.push({ 0.0, START });
+
+    auto relax = [&](uint32_t from, uint32_t to, double km) {
+        ++stats.edge_evaluations;
+        double d = dist[from] + km;
+        if (d < dist[to]) {
+            dist[to] = d;
+            parent[to] = from;
+            open.push({ d, to });
+            ++stats.nodes_pushed;
+        }
+    };
+
+    while (!open.empty()) {
+        auto [d, u] = open.top();
+        open.pop();
+        if (d > dist[u]) {
+            continue;
+        }
+        ++stats.nodes_expanded;
+        if (u == GOAL) {
+            break;
+        }
+        if (u == START) {
+            for (const auto& link : startLinks) {
+                relax(START, link.first, link.second);
+            }
+            continue;
+        }
+        for (uint32_t k = adjacencyOffsets_[u]; k < adjacencyOffsets_[u + 1]; ++k) {
+            relax(u, adjacency_[k], adjacencyKm_[k]);
+        }
+        if (goalLinkKm[u] >= 0.0) {
+            relax(u, GOAL, goalLinkKm[u]);
+        }
+    }
+
+    if (parent[GOAL] == std::numeric_limits<uint32_t>::max()) {
+        return FallbackSearch(grid, start, goal, "goal not reachable in the graph");
+    }
+
+    // ================================================================
+    // 3. Turn points -> cells; graph edges must stay on navigable cells
+    // ================================================================
+    std::vector<uint32_t> chain;
+    for (uint32_t id = GOAL; id != START; id = parent[id]) {
+        chain.push_back(id);
+    }
+    std::reverse(chain.begin(), chain.end());
+
+    PathSearchResult result;
+    result.path.push_back(start);
+    for (size_t i = 0; i < chain.size(); ++i) {
+        uint32_t id = chain[i];
+        if (id == GOAL) {
+            if (!(result.path.back() == goal)) result.path.push_back(goal);
+            break;
+        }
+        if (i + 1 < chain.size() && chain[i + 1] != GOAL &&
+            !GridLineOfSight(nodes_[id].pos, nodes_[chain[i + 1]].pos)) {
+            return FallbackSearch(grid, start, goal, "graph edge crosses non-navigable cells");
+        }
+        if (!(result.path.back() == nodes_[id].cell)) {
+            result.path.push_back(nodes_[id].cell);
+        }
+    }
+
+    for (size_t i = 1; i < result.path.size(); ++i) {
+        EdgeCostResult edge = ComputeEdgeCost(result.path[i - 1], result.path[i], result.total_time_hours);
+        result.total_cost += edge.cost;
+        result.total_time_hours += edge.deltaTimeHours;
+    }
+    result.stats = stats;
+
+    std::cout << "[VisibilityGraph] Shortest: " << result.total_cost << " km, "
+              << result.total_time_hours << "h (" << result.path.size() - 2 << " turns)" << std::endl;
+    return result;
+}
+
+PathSearchResult VisibilityGraphPlanner::FallbackSearch(
+    const NavigableGrid& grid,
+    const GridCoordinate& start,
+    const GridCoordinate& goal,
+    const char* reason)
+{
+    std::cout << "[VisibilityGraph] " << reason << ", using cell A*" << std::endl;
+    return cellPlanner_.FindPath(grid, start, goal);
+}
+
+// ================================================================
+// Cost Model (ShortestRoutePlanner)
+// ================================================================
+
+EdgeCostResult VisibilityGraphPlanner::ComputeEdgeCost(
+    const GridCoordinate& from,
+    const GridCoordinate& to,
+    double accumulatedTimeHours) const
+{
+    return cellPlanner_.ComputeEdgeCost(from, to, accumulatedTimeHours);
+}
+
+double VisibilityGraphPlanner::ComputeHeuristic(
+    const GridCoordinate& current,
+    const GridCoordinate& goal) const
+{
+    return cellPlanner_.ComputeHeuristic(current, goal);
+}
+
+bool VisibilityGraphPlanner::IsValidTransition(
+    const PathNode& current_node,
+    const GridCoordinate& neighbor_pos) const
+{
+    return cellPlanner_.IsValidTransition(current_node, neighbor_pos);
+}
\ No newline at end of file
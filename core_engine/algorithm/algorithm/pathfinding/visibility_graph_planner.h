@@ -0,0 +1,149 @@
+#pragma once
+
+#include "route_planner.h"
+#include "shortest_planner.h"
+#include "path_types.h"
+#include "../types/grid_types.h"
+#include "../types/geo_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class VisibilityGraphPlanner
+ * @brief Any-angle shortest path over a visibility graph of coastline vertices
+ *
+ * Land rings are simplified (Douglas-Peucker) and inflated by a safety
+ * buffer. Convex vertices of the inflated rings inside the grid bounds
+ * become graph nodes, linked when the segment between them crosses no
+ * inflated edge and is tangent to the coast at both ends (reduced
+ * visibility graph). Obstacle edges are bucketed in a uniform grid, and a
+ * visibility test only walks the buckets the segment passes through.
+ *
+ * Queries link start and goal to the nodes they reach through navigable
+ * cells and run Dijkstra. When a graph edge of the result crosses
+ * non-navigable cells (GEBCO shallows are not in the coastline data), or
+ * the graph was not built, the leg falls back to ShortestRoutePlanner.
+ * Costs and heuristics are the ShortestRoutePlanner ones (great circle km).
+ */
+class VisibilityGraphPlanner : public IRoutePlanner {
+public:
+    /**
+     * @brief Constructor
+     * @param grid Navigable grid reference (nodes are kept inside its bounds)
+     * @param shipSpeedMps Ship speed in meters per second
+     */
+    VisibilityGraphPlanner(
+        const NavigableGrid& grid,
+        double shipSpeedMps
+    );
+
+    /**
+     * @brief Build the visibility graph
+     *
+     * @param landRings Land polygons (GSHHS level 1) in lat/lon, longitudes
+     *                  continuous with the grid bounds (GshhsLoader::ExtractROI)
+     * @param bufferKm Clearance kept from the simplified coastline
+     * @param simplifyKm Douglas-Peucker tolerance; rings are inflated by
+     *                   bufferKm + simplifyKm so the original coast stays outside
+     * @param numThreads Threads for the visibility tests (0 = hardware concurrency)
+     */
+    void Build(
+        const std::vector<std::vector<GeoCoordinate>>& landRings,
+        double bufferKm = 2.0,
+        double simplifyKm = 1.0,
+        int numThreads = 0
+    );
+
+    bool IsBuilt() const { return built_; }
+    size_t NodeCount() const { return nodes_.size(); }
+    size_t EdgeCount() const { return adjacency_.size() / 2; }
+    size_t ObstacleEdgeCount() const { return obstacles_.size(); }
+
+    // ================================================================
+    // IRoutePlanner Interface Implementation
+    // ================================================================
+
+    PathSearchResult FindPath(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal
+    ) override;
+
+    EdgeCostResult ComputeEdgeCost(
+        const GridCoordinate& from,
+        const GridCoordinate& to,
+        double accumulatedTimeHours
+    ) const override;
+
+    double ComputeHeuristic(
+        const GridCoordinate& current,
+        const GridCoordinate& goal
+    ) const override;
+
+    bool IsValidTransition(
+        const PathNode& current_node,
+        const GridCoordinate& neighbor_pos
+    ) const override;
+
+    // Start/goal links and graph edges use line of sight
+    bool IsAnyAngle() const override { return true; }
+
+private:
+    // x = longitude, y = latitude (degrees, continuous with the grid bounds)
+    struct Point {
+        double x;
+        double y;
+    };
+
+    struct Segment {
+        Point a;
+        Point b;
+    };
+
+    // Convex vertex of an inflated ring with its ring neighbours
+    struct Node {
+        Point pos;
+        Point prev;
+        Point next;
+        GridCoordinate cell;
+    };
+
+    const NavigableGrid& grid_;
+    ShortestRoutePlanner cellPlanner_;   // Costs/heuristic and fallback search
+    bool built_;
+
+    std::vector<Node> nodes_;
+    std::vector<Segment> obstacles_;
+
+    // Uniform bucket grid over the grid bounds (CSR of obstacle indices)
+    int bucketsX_;
+    int bucketsY_;
+    double bucketW_;
+    double bucketH_;
+    std::vector<uint32_t> bucketOffsets_;
+    std::vector<uint32_t> bucketEdges_;
+
+    // Undirected node graph (CSR, both directions)
+    std::vector<uint32_t> adjacencyOffsets_;
+    std::vector<uint32_t> adjacency_;
+    std::vector<double> adjacencyKm_;
+
+    void BuildBuckets();
+    int BucketX(double x) const;
+    int BucketY(double y) const;
+
+    // Segment a-b properly crosses an inflated coastline edge
+    bool SegmentBlocked(const Point& a, const Point& b) const;
+    // Every cell along a-b (sampled at half a cell) is navigable
+    bool GridLineOfSight(const Point& a, const Point& b) const;
+    // Line from the node towards p keeps the coast on one side
+    static bool IsTangent(const Node& node, const Point& p);
+
+    PathSearchResult FallbackSearch(
+        const NavigableGrid& grid,
+        const GridCoordinate& start,
+        const GridCoordinate& goal,
+        const char* reason
+    );
+};
\ No newline at end of file
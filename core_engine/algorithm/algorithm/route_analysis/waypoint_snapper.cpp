@@ -1,5 +1,6 @@
 #include "waypoint_snapper.h"
 #include "../utils/geo_calculations.h"
+#include <map>
 #include <queue>
 #include <set>
 #include <cmath>
@@ -25,8 +26,30 @@ double WaypointSnapper::CalculateDistanceKm(
 
 GridCoordinate WaypointSnapper::FindNearestNavigableCell(
     const GridCoordinate& start,
-    double maxSearchRadiusKm) const
+    double maxSearchRadiusKm,
+    int32_t component) const
 {
+    auto qualifies = [&](const GridCoordinate& pos) {
+        return component < 0 ? navGrid_.IsNavigable(pos.row, pos.col)
+                             : navGrid_.ComponentOf(pos.row, pos.col) == component;
+    };
+
+    // Distance field built with the grid: single lookup
+    // (falls through to the local search if the nearest cell is in another component)
+    if (navGrid_.HasDistanceFields()) {
+        GridCoordinate nearest = navGrid_.NearestNavigableCell(start.row, start.col);
+        if (nearest.row < 0) {
+            return GridCoordinate(-1, -1);
+        }
+        double distKm = CalculateDistanceKm(navGrid_.GridToGeo(start), navGrid_.GridToGeo(nearest));
+        if (distKm > maxSearchRadiusKm) {
+            return GridCoordinate(-1, -1);
+        }
+        if (qualifies(nearest)) {
+            return nearest;
+        }
+    }
+
     struct Node {
         GridCoordinate pos;
         double distKmFromStart;
@@ -44,9 +67,6 @@ GridCoordinate WaypointSnapper::FindNearestNavigableCell(
     pq.push(Node{ start, 0.0 });
     visited.insert({ start.row, start.col });
 
-    const int dr[] = { -1, -1, -1,  0, 0,  1, 1, 1 };
-    const int dc[] = { -1,  0,  1, -1, 1, -1, 0, 1 };
-
     while (!pq.empty()) {
         Node current = pq.top();
         pq.pop();
@@ -58,13 +78,15 @@ GridCoordinate WaypointSnapper::FindNearestNavigableCell(
             continue;
         }
 
-        if (navGrid_.IsNavigable(curPos.row, curPos.col)) {
+        if (qualifies(curPos)) {
             return curPos;
         }
 
         for (int i = 0; i < 8; ++i) {
-            int nr = curPos.row + dr[i];
-            int nc = curPos.col + dc[i];
+            // Re-based per row on equal-distance grids
+            GridCoordinate next = navGrid_.Neighbor(curPos.row, curPos.col, i);
+            int nr = next.row;
+            int nc = next.col;
 
             if (!navGrid_.IsValid(nr, nc)) continue;
             if (visited.count({ nr, nc })) continue;
@@ -143,6 +165,10 @@ std::vector<SnappingInfo> WaypointSnapper::SnapMultipleWaypoints(
         results.push_back(SnapToNavigable(wp, maxSearchRadiusKm));
     }
 
+    if (navGrid_.HasComponents() && results.size() >= 2) {
+        PreferSharedComponent(results, maxSearchRadiusKm);
+    }
+
 #ifdef _DEBUG
     for (size_t i = 0; i < results.size(); ++i) {
         const auto& sr = results[i];
@@ -169,6 +195,54 @@ std::vector<SnappingInfo> WaypointSnapper::SnapMultipleWaypoints(
     return results;
 }
 
+void WaypointSnapper::PreferSharedComponent(
+    std::vector<SnappingInfo>& results,
+    double maxSearchRadiusKm) const
+{
+    // Component of every snapped waypoint; the most common one wins,
+    // ties go to the larger water body
+    std::vector<int32_t> components(results.size(), -1);
+    std::map<int32_t, int> votes;
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (!results[i].IsSuccess()) continue;
+        GridCoordinate cell = navGrid_.GeoToGrid(results[i].snapped);
+        components[i] = navGrid_.ComponentOf(cell.row, cell.col);
+        if (components[i] >= 0) ++votes[components[i]];
+    }
+
+    int32_t shared = -1;
+    for (const auto& vote : votes) {
+        if (shared < 0 || vote.second > votes[shared] ||
+            (vote.second == votes[shared] &&
+             navGrid_.ComponentSize(vote.first) > navGrid_.ComponentSize(shared))) {
+            shared = vote.first;
+        }
+    }
+    if (shared < 0 || votes.size() < 2) {
+        return;
+    }
+
+    for (size_t i = 0; i < results.size(); ++i) {
+        if (components[i] < 0 || components[i] == shared) continue;
+
+        SnappingInfo& result = results[i];
+        GridCoordinate cell = FindNearestNavigableCell(
+            navGrid_.GeoToGrid(result.original), maxSearchRadiusKm, shared);
+        if (cell.row < 0) {
+            std::cerr << "[WaypointSnapper] Waypoint " << i
+                      << " is not connected to the other waypoints by water" << std::endl;
+            continue;
+        }
+
+        result.status = SnappingStatus::SNAPPED;
+        result.was_snapped = true;
+        result.snapped = navGrid_.GridToGeo(cell);
+        result.snapping_distance_km = CalculateDistanceKm(result.original, result.snapped);
+        std::cout << "[WaypointSnapper] Waypoint " << i << " moved "
+                  << result.snapping_distance_km << " km into the shared water body" << std::endl;
+    }
+}
+
 std::vector<GeoCoordinate> WaypointSnapper::GetSnappedWaypoints(
     const std::vector<SnappingInfo>& results) const 
 {
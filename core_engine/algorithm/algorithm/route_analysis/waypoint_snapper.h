@@ -47,8 +47,17 @@ private:
         const GeoCoordinate& p2
     ) const;
 
+    // component >= 0: only cells of that connected component qualify
     GridCoordinate FindNearestNavigableCell(
         const GridCoordinate& start,
+        double maxSearchRadiusKm,
+        int32_t component = -1
+    ) const;
+
+    // Re-snaps waypoints that landed in a different water body (lake, closed
+    // basin) into the component shared by most waypoints, if one is in range
+    void PreferSharedComponent(
+        std::vector<SnappingInfo>& results,
         double maxSearchRadiusKm
     ) const;
 };
\ No newline at end of file
@@ -0,0 +1,237 @@
+// bench_cell_layout.cpp - ROW_MAJOR vs BLOCKED_8X8 셀 배치 벤치마크 (넓은 합성 격자)
+// 사용법: bench_cell_layout [rows] [cols] [islands]
+// 캐시 미스는 Linux(perf_event_open)에서만 측정, 그 외 플랫폼은 n/a
+
+#include "../pathfinding/a_star_engine.h"
+#include "../pathfinding/shortest_planner.h"
+#include "../types/grid_types.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 원형 섬이 흩어진 합성 격자 (재현 가능하도록 고정 시드)
+NavigableGrid MakeSyntheticGrid(int rows, int cols, int islands) {
+    NavigableGrid grid(BoundingBox(0.0, rows * 0.01, 120.0, 120.0 + cols * 0.01), rows, cols);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            grid.SetCellType(r, c, CellType::NAVIGABLE);
+        }
+    }
+
+    std::mt19937 rng(42);
+    int maxRadius = std::max(3, std::min(rows, cols) / 20);
+    for (int i = 0; i < islands; ++i) {
+        int cr = static_cast<int>(rng() % rows);
+        int cc = static_cast<int>(rng() % cols);
+        int rad = 2 + static_cast<int>(rng() % maxRadius);
+        for (int r = std::max(0, cr - rad); r <= std::min(rows - 1, cr + rad); ++r) {
+            for (int c = std::max(0, cc - rad); c <= std::min(cols - 1, cc + rad); ++c) {
+                if ((r - cr) * (r - cr) + (c - cc) * (c - cc) <= rad * rad) {
+                    grid.SetCellType(r, c, CellType::LAND);
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+GridCoordinate NearestNavigable(const NavigableGrid& grid, GridCoordinate pos, int step) {
+    while (grid.IsValid(pos) && !grid.IsNavigable(pos.row, pos.col)) {
+        pos.col += step;
+    }
+    return pos;
+}
+
+// 하드웨어 캐시 미스 카운터 (지원하지 않으면 Read()가 -1)
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+    void Start() {
+#ifdef __linux__
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+    long long Read() {
+#ifdef __linux__
+        long long count = 0;
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) == sizeof(count)) return count;
+        }
+#endif
+        return -1;
+    }
+
+private:
+    int fd_ = -1;
+};
+
+// 조밀 배열 A*: g 값/닫힘 표시를 grid.CellIndex로 색인 (배치의 효과가 그대로 드러나는 커널)
+PathSearchResult DenseAStar(const NavigableGrid& grid, GridCoordinate start, GridCoordinate goal) {
+    const float DIAG = 1.41421356f;
+    auto heuristic = [&](int r, int c) {
+        float dr = static_cast<float>(std::abs(r - goal.row));
+        float dc = static_cast<float>(std::abs(c - goal.col));
+        return std::max(dr, dc) + (DIAG - 1.0f) * std::min(dr, dc);
+    };
+
+    size_t count = grid.CellIndexCount();
+    std::vector<float> g(count, std::numeric_limits<float>::infinity());
+    std::vector<uint8_t> closed(count, 0);
+    std::vector<uint8_t> parentDir(count, 0xFF);
+
+    using Entry = std::pair<float, size_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+    size_t startIdx = grid.CellIndex(start);
+    size_t goalIdx = grid.CellIndex(goal);
+    g[startIdx] = 0.0f;
+    open.push({ heuristic(start.row, start.col), startIdx });
+
+    PathSearchResult result;
+    while (!open.empty()) {
+        size_t idx = open.top().second;
+        open.pop();
+        if (closed[idx]) continue;
+        closed[idx] = 1;
+        ++result.stats.nodes_expanded;
+        if (idx == goalIdx) break;
+
+        GridCoordinate cur = grid.CellAt(idx);
+        uint8_t neighbors = grid.NeighborMask(cur.row, cur.col);
+        for (int i = 0; neighbors; ++i, neighbors >>= 1) {
+            if (!(neighbors & 1u)) continue;
+            GridCoordinate n = grid.Neighbor(cur.row, cur.col, i);
+            size_t nIdx = grid.CellIndex(n);
+            float step = (NEIGHBOR_DROW[i] != 0 && NEIGHBOR_DCOL[i] != 0) ? DIAG : 1.0f;
+            float cost = g[idx] + step;
+            if (cost < g[nIdx]) {
+                g[nIdx] = cost;
+                parentDir[nIdx] = static_cast<uint8_t>(i);
+                open.push({ cost + heuristic(n.row, n.col), nIdx });
+                ++result.stats.nodes_pushed;
+            }
+        }
+    }
+
+    if (!closed[goalIdx]) {
+        return result;
+    }
+    for (GridCoordinate p = goal; !(p == start);) {
+        result.path.push_back(p);
+        int i = parentDir[grid.CellIndex(p)];
+        p = GridCoordinate(p.row - NEIGHBOR_DROW[i], p.col - NEIGHBOR_DCOL[i]);
+    }
+    result.path.push_back(start);
+    std::reverse(result.path.begin(), result.path.end());
+    result.total_cost = g[goalIdx];
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int rows = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int cols = (argc > 2) ? std::atoi(argv[2]) : 8000;
+    int islands = (argc > 3) ? std::atoi(argv[3]) : 800;
+
+    NavigableGrid rowMajor = MakeSyntheticGrid(rows, cols, islands);
+    rowMajor.BuildNeighborMasks();
+    NavigableGrid blocked = rowMajor;
+    blocked.SetLayout(CellLayout::BLOCKED_8X8);
+
+    // 북→남 방향 구간: 행 우선 배치에서 캐시 미스가 가장 많은 경우
+    GridCoordinate start = NearestNavigable(rowMajor, GridCoordinate(rows / 20, cols / 3), 1);
+    GridCoordinate goal = NearestNavigable(rowMajor, GridCoordinate(rows - rows / 20, cols / 3 + rows / 4), -1);
+
+    std::cout << "=== Cell Layout Benchmark ===" << std::endl;
+    std::cout << "Grid: " << rows << " x " << cols << ", islands: " << islands << std::endl;
+    std::cout << "Start: (" << start.row << ", " << start.col << ")  Goal: ("
+              << goal.row << ", " << goal.col << ")" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::setw(12) << "layout"
+              << std::setw(12) << "search"
+              << std::setw(12) << "time(ms)"
+              << std::setw(12) << "expanded"
+              << std::setw(12) << "ns/exp"
+              << std::setw(14) << "cache miss"
+              << std::setw(12) << "miss/exp"
+              << std::setw(14) << "cost" << std::endl;
+
+    CacheMissCounter counter;
+    auto run = [&](const char* layoutName, const char* searchName,
+                   const std::function<PathSearchResult()>& search) {
+        counter.Start();
+        auto t0 = std::chrono::steady_clock::now();
+        PathSearchResult result = search();
+        auto t1 = std::chrono::steady_clock::now();
+        long long misses = counter.Read();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+        if (!result.IsSuccess()) {
+            std::cout << std::setw(12) << layoutName << std::setw(12) << searchName << "  FAILED" << std::endl;
+            return;
+        }
+        double expanded = static_cast<double>(std::max<size_t>(1, result.stats.nodes_expanded));
+        std::cout << std::setw(12) << layoutName
+                  << std::setw(12) << searchName
+                  << std::setw(12) << ms
+                  << std::setw(12) << result.stats.nodes_expanded
+                  << std::setw(12) << ms * 1e6 / expanded
+                  << std::setw(14) << (misses >= 0 ? std::to_string(misses) : std::string("n/a"))
+                  << std::setw(12);
+        if (misses >= 0) std::cout << misses / expanded;
+        else             std::cout << "n/a";
+        std::cout << std::setw(14) << result.total_cost << std::endl;
+    };
+
+    for (const NavigableGrid* grid : { &rowMajor, &blocked }) {
+        const char* name = (grid->Layout() == CellLayout::BLOCKED_8X8) ? "blocked8x8" : "row-major";
+        run(name, "dense", [&]() { return DenseAStar(*grid, start, goal); });
+    }
+    for (const NavigableGrid* grid : { &rowMajor, &blocked }) {
+        const char* name = (grid->Layout() == CellLayout::BLOCKED_8X8) ? "blocked8x8" : "row-major";
+        ShortestRoutePlanner planner(*grid, 8.0);
+        run(name, "AStarEngine", [&]() { return AStarEngine::Search(*grid, start, goal, planner); });
+    }
+
+    return 0;
+}
\ No newline at end of file
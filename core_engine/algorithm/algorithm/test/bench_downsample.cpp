@@ -0,0 +1,110 @@
+// bench_downsample.cpp - DownsampleDepthGrid 커널 벤치마크 (스칼라/SIMD x 스레드 수, 합성 수심 래스터)
+// 사용법: bench_downsample [srcRows] [srcCols] [blockLat] [blockLon] [repeats]
+// 기본값: 4800 x 9600 GEBCO 픽셀 (20° x 40°, 15초 해상도) -> 약 5km 셀
+
+#include "../data_loading/depth_downsample.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 해저 지형 흉내: 완만한 기복 + 잡음, 일부는 육지(양수) (재현 가능하도록 고정 시드)
+std::vector<std::vector<float>> MakeSyntheticDepths(int rows, int cols) {
+    std::vector<std::vector<float>> depths(rows, std::vector<float>(cols));
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> noise(-25.0f, 25.0f);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            double relief = 2500.0 * std::sin(r * 0.0031) * std::cos(c * 0.0017);
+            depths[r][c] = static_cast<float>(-3000.0 + relief) + noise(rng);
+        }
+    }
+    return depths;
+}
+
+// 비트 단위 비교 (SIMD 커널은 스칼라와 완전히 같아야 함)
+size_t CountMismatches(const std::vector<std::vector<float>>& a, const std::vector<std::vector<float>>& b) {
+    size_t mismatches = 0;
+    for (size_t r = 0; r < a.size(); ++r) {
+        for (size_t c = 0; c < a[r].size(); ++c) {
+            if (std::memcmp(&a[r][c], &b[r][c], sizeof(float)) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+int main(int argc, char* argv[]) {
+    int srcRows = (argc > 1) ? std::atoi(argv[1]) : 4800;
+    int srcCols = (argc > 2) ? std::atoi(argv[2]) : 9600;
+    int blockLat = (argc > 3) ? std::atoi(argv[3]) : 11;
+    int blockLon = (argc > 4) ? std::atoi(argv[4]) : 13;
+    int repeats = (argc > 5) ? std::atoi(argv[5]) : 3;
+    if (srcRows <= 0 || srcCols <= 0 || blockLat <= 0 || blockLon <= 0 || repeats <= 0) {
+        std::cerr << "Invalid arguments" << std::endl;
+        return 1;
+    }
+
+    // 블록 단위로 내림한 출력 크기
+    int dstRows = std::max(1, srcRows / blockLat);
+    int dstCols = std::max(1, srcCols / blockLon);
+
+    std::cout << "=== Depth Downsampling Benchmark ===" << std::endl;
+    std::cout << "Source: " << srcRows << " x " << srcCols << " ("
+              << static_cast<double>(srcRows) * srcCols * sizeof(float) / (1024.0 * 1024.0) << " MB)"
+              << ", block " << blockLat << " x " << blockLon
+              << " -> " << dstRows << " x " << dstCols << std::endl;
+    std::cout << "SIMD kernel: " << DownsampleSimdName() << std::endl;
+
+    auto depths = MakeSyntheticDepths(srcRows, srcCols);
+
+    // 기준: 스칼라 1스레드 (셀마다 행-열 순서로 합산하는 기준 루프)
+    auto reference = DownsampleDepthGrid(depths, dstRows, dstCols, blockLat, blockLon, 1, DownsampleKernel::SCALAR);
+
+    int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts = { 1 };
+    for (int t = 2; t < hw; t *= 2) threadCounts.push_back(t);
+    if (hw > 1) threadCounts.push_back(hw);
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::setw(10) << "kernel"
+              << std::setw(10) << "threads"
+              << std::setw(12) << "time(ms)"
+              << std::setw(12) << "Mpix/s"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "mismatch" << std::endl;
+
+    double baselineMs = 0.0;
+    for (DownsampleKernel kernel : { DownsampleKernel::SCALAR, DownsampleKernel::SIMD }) {
+        for (int threads : threadCounts) {
+            // 최솟값 (반복 측정)
+            double bestMs = 1e300;
+            std::vector<std::vector<float>> result;
+            for (int i = 0; i < repeats; ++i) {
+                auto t0 = std::chrono::steady_clock::now();
+                result = DownsampleDepthGrid(depths, dstRows, dstCols, blockLat, blockLon, threads, kernel);
+                auto t1 = std::chrono::steady_clock::now();
+                bestMs = std::min(bestMs, std::chrono::duration<double, std::milli>(t1 - t0).count());
+            }
+            if (baselineMs == 0.0) baselineMs = bestMs;
+
+            std::cout << std::setw(10) << (kernel == DownsampleKernel::SIMD ? DownsampleSimdName() : "scalar")
+                      << std::setw(10) << threads
+                      << std::setw(12) << bestMs
+                      << std::setw(12) << static_cast<double>(srcRows) * srcCols / (bestMs * 1000.0)
+                      << std::setw(9) << baselineMs / bestMs << "x"
+                      << std::setw(12) << CountMismatches(reference, result) << std::endl;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
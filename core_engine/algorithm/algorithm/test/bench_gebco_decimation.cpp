@@ -0,0 +1,149 @@
+// bench_gebco_decimation.cpp - GEBCO 블록 평균: 원 해상도 읽기 + DownsampleDepthGrid vs GDAL 평균 읽기 (작업 디렉토리: LINK)
+// 사용법: bench_gebco_decimation [--build-overviews] [minLat maxLat minLon maxLon]
+// 기본 ROI: 한국 ~ 동중국해 (20~45N, 115~145E), 셀 크기 5/10/20 km
+
+#include "../data_loading/gebco_loader.h"
+#include "../data_loading/depth_downsample.h"
+#include "../types/grid_types.h"
+#include <gdal_priv.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+struct DiffStats {
+    double maxAbs = 0.0;
+    double meanAbs = 0.0;
+    double rms = 0.0;
+    size_t flipsLand = 0;      // 0 m 기준 육지/바다 판정이 바뀐 셀
+    size_t flipsShallow = 0;   // -15 m 기준 (기본 안전 수심) 판정이 바뀐 셀
+};
+
+DiffStats Compare(const std::vector<std::vector<float>>& reference, const std::vector<float>& averaged, int cols) {
+    DiffStats s;
+    size_t n = 0;
+    for (size_t r = 0; r < reference.size(); ++r) {
+        for (int c = 0; c < cols; ++c) {
+            double a = reference[r][c];
+            double b = averaged[r * cols + c];
+            double d = std::abs(a - b);
+            s.maxAbs = std::max(s.maxAbs, d);
+            s.meanAbs += d;
+            s.rms += d * d;
+            if ((a >= 0.0) != (b >= 0.0)) ++s.flipsLand;
+            if ((a > -15.0) != (b > -15.0)) ++s.flipsShallow;
+            ++n;
+        }
+    }
+    if (n > 0) {
+        s.meanAbs /= n;
+        s.rms = std::sqrt(s.rms / n);
+    }
+    return s;
+}
+
+double ElapsedMs(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char* argv[]) {
+    int arg = 1;
+    bool buildOverviews = (argc > 1 && std::strcmp(argv[1], "--build-overviews") == 0);
+    if (buildOverviews) ++arg;
+
+    BoundingBox roi(20.0, 45.0, 115.0, 145.0);
+    if (argc - arg >= 4) {
+        roi = BoundingBox(std::atof(argv[arg]), std::atof(argv[arg + 1]),
+                          std::atof(argv[arg + 2]), std::atof(argv[arg + 3]));
+    }
+
+    GDALAllRegister();
+    GebcoLoader loader("data/gebco/GEBCO_2024_sub_ice_topo.nc");
+    if (!loader.Open()) {
+        std::cerr << "ERROR: Cannot open GEBCO" << std::endl;
+        return 1;
+    }
+    if (buildOverviews) {
+        auto t0 = std::chrono::steady_clock::now();
+        if (!loader.BuildOverviews()) {
+            std::cerr << "ERROR: Overview build failed" << std::endl;
+            return 1;
+        }
+        std::cout << "Overviews built in " << ElapsedMs(t0) / 1000.0 << " s" << std::endl;
+    }
+
+    std::cout << "=== GEBCO Decimation Benchmark ===" << std::endl;
+    std::cout << "ROI: " << roi.minLat << "~" << roi.maxLat << "N, "
+              << roi.minLon << "~" << roi.maxLon << "E" << std::endl;
+    std::cout << "Overviews: " << loader.GetOverviewCount() << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::setw(8) << "cell(km)"
+              << std::setw(12) << "grid"
+              << std::setw(12) << "full(ms)"
+              << std::setw(12) << "gdal(ms)"
+              << std::setw(10) << "speedup"
+              << std::setw(10) << "max|d|"
+              << std::setw(10) << "mean|d|"
+              << std::setw(10) << "rms"
+              << std::setw(8) << "flip0"
+              << std::setw(8) << "flip15" << std::endl;
+
+    for (double cellKm : { 5.0, 10.0, 20.0 }) {
+        BoundingBox expanded;
+        PixelWindow window;
+        if (!loader.ExpandROI(roi, 0, expanded, &window)) {
+            std::cerr << "ERROR: ROI outside raster" << std::endl;
+            return 1;
+        }
+        GridResolution res = GridResolution::Calculate(expanded, window.height(), window.width(), cellKm);
+
+        // 두 방식 모두 같은 온전한 블록 영역 (GridBuilder::DownsampleWindow의 GDAL 경로와 동일)
+        PixelWindow blocks = window;
+        blocks.bottomRow = window.topRow + res.rows * res.blockLat - 1;
+        blocks.rightCol = window.leftCol + res.cols * res.blockLon - 1;
+
+        // 기준: 원 해상도 읽기 + 자체 블록 평균 (DownsampleDepthGrid)
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<std::vector<float>> full;
+        if (!loader.ReadWindow(blocks, full)) {
+            std::cerr << "ERROR: Full-resolution read failed" << std::endl;
+            return 1;
+        }
+        auto reference = DownsampleDepthGrid(full, res.rows, res.cols, res.blockLat, res.blockLon);
+        double fullMs = ElapsedMs(t0);
+        full.clear();
+        full.shrink_to_fit();
+
+        // GDAL: RasterIO + GRIORA_Average (오버뷰가 있으면 사용)
+        t0 = std::chrono::steady_clock::now();
+        std::vector<float> averaged;
+        if (!loader.ReadWindowAveraged(blocks, res.rows, res.cols, averaged)) {
+            std::cerr << "ERROR: Averaged read failed" << std::endl;
+            return 1;
+        }
+        double gdalMs = ElapsedMs(t0);
+
+        DiffStats s = Compare(reference, averaged, res.cols);
+        std::cout << std::setw(8) << cellKm
+                  << std::setw(12) << (std::to_string(res.rows) + "x" + std::to_string(res.cols))
+                  << std::setw(12) << fullMs
+                  << std::setw(12) << gdalMs
+                  << std::setw(9) << fullMs / gdalMs << "x"
+                  << std::setw(10) << s.maxAbs
+                  << std::setw(10) << s.meanAbs
+                  << std::setw(10) << s.rms
+                  << std::setw(8) << s.flipsLand
+                  << std::setw(8) << s.flipsShallow << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,180 @@
+// bench_isochrone.cpp - OptimizedRoutePlanner(A*) vs IsochroneRoutePlanner 벤치마크 (합성 격자 + 합성 날씨)
+// 사용법: bench_isochrone [rows] [cols] [islands]
+// 같은 구간/날씨에서 탐색 시간과 연료를 비교 (연료는 ShipDynamics.dll 필요)
+
+#include "../pathfinding/isochrone_planner.h"
+#include "../pathfinding/optimized_planner.h"
+#include "../types/grid_types.h"
+#include "../types/voyage_types.h"
+#include "../types/weather_types.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 원형 섬이 흩어진 합성 격자, 셀 0.05° (재현 가능하도록 고정 시드)
+NavigableGrid MakeSyntheticGrid(int rows, int cols, int islands) {
+    NavigableGrid grid(BoundingBox(20.0, 20.0 + rows * 0.05, 120.0, 120.0 + cols * 0.05), rows, cols);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            grid.SetCellType(r, c, CellType::NAVIGABLE);
+        }
+    }
+
+    std::mt19937 rng(7);
+    int maxRadius = std::max(3, std::min(rows, cols) / 15);
+    for (int i = 0; i < islands; ++i) {
+        int cr = static_cast<int>(rng() % rows);
+        int cc = static_cast<int>(rng() % cols);
+        int rad = 2 + static_cast<int>(rng() % maxRadius);
+        for (int r = std::max(0, cr - rad); r <= std::min(rows - 1, cr + rad); ++r) {
+            for (int c = std::max(0, cc - rad); c <= std::min(cols - 1, cc + rad); ++c) {
+                if ((r - cr) * (r - cr) + (c - cc) * (c - cc) <= rad * rad) {
+                    grid.SetCellType(r, c, CellType::LAND);
+                }
+            }
+        }
+    }
+    grid.BuildNeighborMasks();
+    return grid;
+}
+
+// 0.5° 날씨 필드 [time][lon][lat], 북위 60도부터 남쪽으로
+WeatherDataInput MakeField(int numTime, const std::function<float(int, double, double)>& value) {
+    WeatherDataInput data;
+    data.iStartTime = 0;
+    data.iNumTime = numTime;
+    data.iTimeBin = 3;
+    data.StartLon = 100.0f;
+    data.iNumLon = 100;
+    data.LonBin = 0.5f;
+    data.StartLat = 60.0f;
+    data.iNumLat = 100;
+    data.LatBin = 0.5f;
+    data.data.resize(static_cast<size_t>(numTime) * data.iNumLon * data.iNumLat);
+    for (int t = 0; t < numTime; ++t) {
+        for (unsigned int lo = 0; lo < data.iNumLon; ++lo) {
+            for (unsigned int la = 0; la < data.iNumLat; ++la) {
+                double lon = data.StartLon + lo * data.LonBin;
+                double lat = data.StartLat - la * data.LatBin;
+                data.data[(static_cast<size_t>(t) * data.iNumLon + lo) * data.iNumLat + la] = value(t, lat, lon);
+            }
+        }
+    }
+    return data;
+}
+
+// 동쪽으로 이동하는 폭풍 (파고/풍속 최대 6 m / 20 m/s) + 일정한 서풍
+std::map<std::string, WeatherDataInput> MakeSyntheticWeather(const BoundingBox& bounds, int numTime) {
+    double centerLat = 0.5 * (bounds.minLat + bounds.maxLat);
+    double lonSpan = bounds.maxLon - bounds.minLon;
+    auto storm = [=](int t, double lat, double lon) {
+        double stormLon = bounds.minLon + lonSpan * (0.3 + 0.1 * t);
+        double d2 = (lat - centerLat) * (lat - centerLat) + (lon - stormLon) * (lon - stormLon);
+        return std::exp(-d2 / (2.0 * 1.5 * 1.5));
+    };
+
+    std::map<std::string, WeatherDataInput> weather;
+    weather["WaveHgt.bin"] = MakeField(numTime, [&](int t, double lat, double lon) {
+        return static_cast<float>(1.0 + 5.0 * storm(t, lat, lon));
+    });
+    weather["WaveDir.bin"] = MakeField(numTime, [](int, double, double) { return 270.0f; });
+    weather["WavePrd.bin"] = MakeField(numTime, [](int, double, double) { return 8.0f; });
+    weather["WindSpd.bin"] = MakeField(numTime, [&](int t, double lat, double lon) {
+        return static_cast<float>(5.0 + 15.0 * storm(t, lat, lon));
+    });
+    weather["WindDir.bin"] = MakeField(numTime, [](int, double, double) { return 270.0f; });
+    return weather;
+}
+
+GridCoordinate NearestNavigable(const NavigableGrid& grid, GridCoordinate pos, int step) {
+    while (grid.IsValid(pos) && !grid.IsNavigable(pos.row, pos.col)) {
+        pos.col += step;
+    }
+    return pos;
+}
+
+int main(int argc, char* argv[]) {
+    int rows = (argc > 1) ? std::atoi(argv[1]) : 300;
+    int cols = (argc > 2) ? std::atoi(argv[2]) : 400;
+    int islands = (argc > 3) ? std::atoi(argv[3]) : 40;
+    if (rows <= 0 || cols <= 0 || islands < 0) {
+        std::cerr << "Invalid arguments" << std::endl;
+        return 1;
+    }
+
+    NavigableGrid grid = MakeSyntheticGrid(rows, cols, islands);
+    auto weather = MakeSyntheticWeather(grid.Bounds(), 16);
+
+    // 서→동 구간: 폭풍을 가로지르는 경우
+    GridCoordinate start = NearestNavigable(grid, GridCoordinate(rows / 2, cols / 20), 1);
+    GridCoordinate goal = NearestNavigable(grid, GridCoordinate(rows / 2 + rows / 10, cols - cols / 20), -1);
+
+    VoyageInfo voyageInfo;
+    voyageInfo.shipSpeed = 8.0;
+    voyageInfo.draft = 10.0;
+    voyageInfo.trim = 0.0;
+    const double shipSpeedMps = 8.0;
+
+    std::cout << "=== Isochrone vs A* Benchmark ===" << std::endl;
+    std::cout << "Grid: " << rows << " x " << cols << ", islands: " << islands << std::endl;
+    std::cout << "Start: (" << start.row << ", " << start.col << ")  Goal: ("
+              << goal.row << ", " << goal.col << ")" << std::endl;
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::setw(12) << "planner"
+              << std::setw(10) << "threads"
+              << std::setw(12) << "time(ms)"
+              << std::setw(14) << "fuel(kg)"
+              << std::setw(10) << "hours"
+              << std::setw(10) << "cells"
+              << std::setw(12) << "fuel diff" << std::endl;
+
+    double referenceFuel = 0.0;
+    auto run = [&](const char* name, int threads, IRoutePlanner& planner) {
+        auto t0 = std::chrono::steady_clock::now();
+        PathSearchResult result = planner.FindPath(grid, start, goal);
+        auto t1 = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+        if (!result.IsSuccess()) {
+            std::cout << std::setw(12) << name << std::setw(10) << threads << "  FAILED" << std::endl;
+            return;
+        }
+        if (referenceFuel == 0.0) referenceFuel = result.total_cost;
+        std::cout << std::setw(12) << name
+                  << std::setw(10) << threads
+                  << std::setw(12) << ms
+                  << std::setw(14) << result.total_cost
+                  << std::setw(10) << result.total_time_hours
+                  << std::setw(10) << result.path.size()
+                  << std::setw(11) << 100.0 * (result.total_cost - referenceFuel) / referenceFuel << "%" << std::endl;
+    };
+
+    // 기준: 격자 A* (OptimizedRoutePlanner)
+    OptimizedRoutePlanner optimized(grid, voyageInfo, 0, weather, shipSpeedMps);
+    run("A*", 1, optimized);
+
+    int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    std::vector<int> threadCounts = { 1 };
+    if (hw > 1) threadCounts.push_back(hw);
+    for (int threads : threadCounts) {
+        IsochroneRoutePlanner isochrone(grid, voyageInfo, 0, weather, shipSpeedMps);
+        isochrone.SetSearchThreads(threads);
+        run("isochrone", threads, isochrone);
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+// bench_label_setting.cpp - 셀당 라벨 수에 따른 라벨 설정(label-setting) 탐색 벤치마크 (작업 디렉토리: LINK)
+// 실제 GEBCO/GSHHS/날씨 데이터로 A*와 maxLabelsPerCell = 1, 2, 4, 8을 비교합니다.
+
+#include "../api/ship_router.h"
+#include "../data_loading/weather_loader.h"
+#include "../pathfinding/optimized_planner.h"
+#include "../types/geo_types.h"
+#include "../types/voyage_types.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+int main() {
+    try {
+        std::cout << "=== Label-Setting Benchmark ===" << std::endl;
+
+        // ========================================
+        // 1. 데이터 로딩
+        // ========================================
+        ShipRouter router;
+        if (!router.Initialize(
+            "data/gebco/GEBCO_2024_sub_ice_topo.nc",
+            "data/gshhs/GSHHS_i_L1.shp")) {
+            std::cerr << "ERROR: Initialization failed" << std::endl;
+            return 1;
+        }
+
+        WeatherLoader weatherLoader;
+        std::map<std::string, WeatherDataInput> weather = weatherLoader.LoadWeatherData("data/weather");
+        if (weather.empty()) {
+            std::cerr << "ERROR: No weather data (data/weather)" << std::endl;
+            return 1;
+        }
+
+        std::vector<GeoCoordinate> waypoints = {
+            {35.0994, 129.0336},  // Busan
+            {33.4996, 126.5312},  // Jeju
+        };
+
+        VoyageConfig config;
+        config.shipSpeedMps = 8.0;
+        config.draftM = 10.0;
+        config.startTimeUnix = 1577836800;  // 2020-01-01
+
+        // ========================================
+        // 2. 그리드 생성 및 스냅핑
+        // ========================================
+        NavigableGrid grid = router.BuildGrid(waypoints, 5.0, 20);
+        std::vector<SnappingInfo> snaps = router.SnapWaypoints(grid, waypoints, 50.0);
+        if (snaps.size() < 2 ||
+            snaps.front().status == SnappingStatus::FAILED ||
+            snaps.back().status == SnappingStatus::FAILED) {
+            std::cerr << "ERROR: Snapping failed" << std::endl;
+            return 1;
+        }
+
+        GridCoordinate start = grid.GeoToGrid(snaps.front().snapped);
+        GridCoordinate goal = grid.GeoToGrid(snaps.back().snapped);
+
+        VoyageInfo voyageInfo;
+        voyageInfo.shipSpeed = config.shipSpeedMps;
+        voyageInfo.draft = config.draftM;
+        voyageInfo.trim = config.trimM;
+
+        // ========================================
+        // 3. A* 대비 라벨 수별 비교
+        // ========================================
+        std::cout << std::fixed << std::setprecision(2);
+        std::cout << "\n" << std::setw(8) << "labels"
+                  << std::setw(12) << "time(ms)"
+                  << std::setw(14) << "fuel(kg)"
+                  << std::setw(12) << "hours"
+                  << std::setw(12) << "expanded"
+                  << std::setw(12) << "DLL calls"
+                  << std::setw(10) << "avg/cell"
+                  << std::setw(10) << "max/cell"
+                  << std::setw(12) << "dominated"
+                  << std::setw(10) << "evicted" << std::endl;
+
+        for (int maxLabels : { 0, 1, 2, 4, 8 }) {
+            OptimizedRoutePlanner planner(
+                grid,
+                voyageInfo,
+                config.startTimeUnix,
+                weather,
+                config.shipSpeedMps
+            );
+            planner.SetMaxLabelsPerCell(maxLabels);
+
+            auto t0 = std::chrono::high_resolution_clock::now();
+            PathSearchResult result = planner.FindPath(grid, start, goal);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+            if (!result.IsSuccess()) {
+                std::cout << std::setw(8) << maxLabels << "  FAILED" << std::endl;
+                continue;
+            }
+
+            const LabelSearchStats& ls = planner.LastLabelStats();
+            std::cout << std::setw(8) << (maxLabels == 0 ? std::string("A*") : std::to_string(maxLabels))
+                      << std::setw(12) << ms
+                      << std::setw(14) << result.total_cost
+                      << std::setw(12) << result.total_time_hours
+                      << std::setw(12) << result.stats.nodes_expanded
+                      << std::setw(12) << result.stats.edge_evaluations;
+            if (maxLabels > 0) {
+                std::cout << std::setw(10) << ls.avg_labels_per_cell
+                          << std::setw(10) << ls.max_labels_in_cell
+                          << std::setw(12) << ls.labels_dominated
+                          << std::setw(10) << ls.labels_evicted;
+            }
+            std::cout << std::endl;
+        }
+
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\nERROR: Exception - " << e.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file
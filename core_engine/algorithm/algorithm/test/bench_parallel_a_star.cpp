@@ -0,0 +1,118 @@
+// bench_parallel_a_star.cpp - AStarEngine vs ParallelAStarEngine(HDA*) 스케일링 벤치마크
+// 사용법: bench_parallel_a_star [rows] [cols] [islands]
+
+#include "../pathfinding/a_star_engine.h"
+#include "../pathfinding/parallel_a_star_engine.h"
+#include "../pathfinding/shortest_planner.h"
+#include "../types/grid_types.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 원형 섬이 흩어진 합성 격자 (재현 가능하도록 고정 시드)
+NavigableGrid MakeSyntheticGrid(int rows, int cols, int islands) {
+    NavigableGrid grid(BoundingBox(0.0, rows * 0.01, 120.0, 120.0 + cols * 0.01), rows, cols);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            grid.SetCellType(r, c, CellType::NAVIGABLE);
+        }
+    }
+
+    std::mt19937 rng(42);
+    int maxRadius = std::max(3, std::min(rows, cols) / 20);
+    for (int i = 0; i < islands; ++i) {
+        int cr = static_cast<int>(rng() % rows);
+        int cc = static_cast<int>(rng() % cols);
+        int rad = 2 + static_cast<int>(rng() % maxRadius);
+        for (int r = std::max(0, cr - rad); r <= std::min(rows - 1, cr + rad); ++r) {
+            for (int c = std::max(0, cc - rad); c <= std::min(cols - 1, cc + rad); ++c) {
+                if ((r - cr) * (r - cr) + (c - cc) * (c - cc) <= rad * rad) {
+                    grid.SetCellType(r, c, CellType::LAND);
+                }
+            }
+        }
+    }
+    return grid;
+}
+
+GridCoordinate NearestNavigable(const NavigableGrid& grid, GridCoordinate pos, int step) {
+    while (grid.IsValid(pos) && !grid.IsNavigable(pos.row, pos.col)) {
+        pos.col += step;
+    }
+    return pos;
+}
+
+int main(int argc, char* argv[]) {
+    int rows = (argc > 1) ? std::atoi(argv[1]) : 2000;
+    int cols = (argc > 2) ? std::atoi(argv[2]) : 2000;
+    int islands = (argc > 3) ? std::atoi(argv[3]) : 400;
+
+    NavigableGrid grid = MakeSyntheticGrid(rows, cols, islands);
+    GridCoordinate start = NearestNavigable(grid, GridCoordinate(rows / 20, cols / 20), 1);
+    GridCoordinate goal = NearestNavigable(grid, GridCoordinate(rows - rows / 20, cols - cols / 20), -1);
+
+    ShortestRoutePlanner planner(grid, 8.0);
+
+    std::cout << "=== Parallel A* Benchmark ===" << std::endl;
+    std::cout << "Grid: " << rows << " x " << cols << ", islands: " << islands << std::endl;
+    std::cout << "Start: (" << start.row << ", " << start.col << ")  Goal: ("
+              << goal.row << ", " << goal.col << ")" << std::endl;
+
+    // 기준: 단일 스레드 AStarEngine
+    auto t0 = std::chrono::steady_clock::now();
+    PathSearchResult baseline = AStarEngine::Search(grid, start, goal, planner);
+    auto t1 = std::chrono::steady_clock::now();
+    double baseMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+
+    if (!baseline.IsSuccess()) {
+        std::cerr << "[ERROR] Baseline search failed" << std::endl;
+        return 1;
+    }
+
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "\n" << std::setw(8) << "threads"
+              << std::setw(12) << "time(ms)"
+              << std::setw(10) << "speedup"
+              << std::setw(12) << "expanded"
+              << std::setw(12) << "pushed"
+              << std::setw(14) << "cost(km)"
+              << std::setw(12) << "cost diff" << std::endl;
+
+    std::cout << std::setw(8) << "A*"
+              << std::setw(12) << baseMs
+              << std::setw(10) << 1.0
+              << std::setw(12) << baseline.stats.nodes_expanded
+              << std::setw(12) << baseline.stats.nodes_pushed
+              << std::setw(14) << baseline.total_cost
+              << std::setw(12) << 0.0 << std::endl;
+
+    for (int threads : { 1, 2, 4, 8, 16 }) {
+        auto s = std::chrono::steady_clock::now();
+        PathSearchResult result = ParallelAStarEngine::Search(grid, start, goal, planner, threads);
+        auto e = std::chrono::steady_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(e - s).count();
+
+        if (!result.IsSuccess()) {
+            std::cout << std::setw(8) << threads << "  FAILED" << std::endl;
+            continue;
+        }
+
+        std::cout << std::setw(8) << threads
+                  << std::setw(12) << ms
+                  << std::setw(10) << baseMs / ms
+                  << std::setw(12) << result.stats.nodes_expanded
+                  << std::setw(12) << result.stats.nodes_pushed
+                  << std::setw(14) << result.total_cost
+                  << std::setw(12) << (result.total_cost - baseline.total_cost) << std::endl;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+// build_tile_pyramid.cpp - 전역 항해 가능/수심 타일 피라미드 생성 (작업 디렉토리: LINK)
+// 사용법: build_tile_pyramid [출력 경로] [레벨 km 목록, 예: 1,2,5,10,20] [타일 크기(셀)]
+
+#include "../data_loading/grid_builder.h"
+#include "../data_loading/tile_pyramid.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+int main(int argc, char* argv[]) {
+    try {
+        std::string outputPath = argc > 1 ? argv[1] : "data/pyramid/navigability.pyr";
+        std::string levelsArg = argc > 2 ? argv[2] : "1,2,5,10,20";
+        int tileSize = argc > 3 ? std::stoi(argv[3]) : 128;
+
+        std::vector<double> levelsKm;
+        std::stringstream ss(levelsArg);
+        for (std::string item; std::getline(ss, item, ',');) {
+            levelsKm.push_back(std::stod(item));
+        }
+
+        std::cout << "=== Tile Pyramid Builder ===" << std::endl;
+
+        // ========================================
+        // 1. 데이터 로딩
+        // ========================================
+        GridBuilder builder;
+        if (!builder.LoadBathymetryData("data/gebco/GEBCO_2024_sub_ice_topo.nc") ||
+            !builder.LoadCoastlineData("data/gshhs/GSHHS_i_L1.shp")) {
+            std::cerr << "ERROR: Data loading failed" << std::endl;
+            return 1;
+        }
+
+        // ========================================
+        // 2. 피라미드 생성
+        // ========================================
+        auto t0 = std::chrono::high_resolution_clock::now();
+        if (!TilePyramid::Build(builder, outputPath, levelsKm, tileSize)) {
+            std::cerr << "ERROR: Pyramid build failed" << std::endl;
+            return 1;
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+
+        // ========================================
+        // 3. 검증 (매핑 후 레벨 정보 출력)
+        // ========================================
+        TilePyramid pyramid;
+        if (!pyramid.Open(outputPath)) {
+            std::cerr << "ERROR: Cannot open built pyramid" << std::endl;
+            return 1;
+        }
+        for (int i = 0; i < pyramid.LevelCount(); ++i) {
+            const PyramidLevelHeader& lv = pyramid.Level(i);
+            std::cout << "  Level " << i << ": " << lv.cellSizeKm << " km, "
+                      << lv.rows << "x" << lv.cols << " cells" << std::endl;
+        }
+
+        std::cout << "Done in "
+                  << std::chrono::duration<double>(t1 - t0).count() << " s" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\nERROR: Exception - " << e.what() << std::endl;
+        return 1;
+    }
+}
\ No newline at end of file
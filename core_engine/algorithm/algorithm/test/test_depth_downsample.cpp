@@ -0,0 +1,125 @@
+// test_depth_downsample.cpp - 수심 블록 평균 커널 비트 일치 검증 (합성 수심, 데이터 파일/GDAL 불필요)
+// SIMD/다중 스레드 DownsampleDepthGrid와 스트립 스트리밍 DownsampleStrips가
+// 스칼라 1스레드 기준과 비트 단위로 같은지 확인 (가장자리 잘림, 행별 블록 폭 포함)
+
+#include "../data_loading/depth_downsample.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+std::vector<std::vector<float>> MakeDepths(int rows, int cols) {
+    std::vector<std::vector<float>> depths(rows, std::vector<float>(cols));
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> value(-6000.0f, 300.0f);
+    for (auto& row : depths) {
+        for (auto& v : row) {
+            v = value(rng);
+        }
+    }
+    return depths;
+}
+
+size_t CountMismatches(const std::vector<std::vector<float>>& a, const std::vector<std::vector<float>>& b) {
+    if (a.size() != b.size()) return static_cast<size_t>(-1);
+    size_t mismatches = 0;
+    for (size_t r = 0; r < a.size(); ++r) {
+        if (a[r].size() != b[r].size()) return static_cast<size_t>(-1);
+        for (size_t c = 0; c < a[r].size(); ++c) {
+            if (std::memcmp(&a[r][c], &b[r][c], sizeof(float)) != 0) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// GebcoLoader::ReadWindowRows 대신 메모리의 래스터에서 행 범위를 복사
+auto MakeReader(const std::vector<std::vector<float>>& src, int& reads) {
+    return [&src, &reads](int first, int count, std::vector<float>& strip) {
+        const size_t cols = src[0].size();
+        strip.resize(static_cast<size_t>(count) * cols);
+        for (int r = 0; r < count; ++r) {
+            std::copy(src[first + r].begin(), src[first + r].end(), strip.begin() + r * cols);
+        }
+        ++reads;
+    };
+}
+
+bool Report(const char* name, size_t mismatches) {
+    std::cout << "  " << name << ": " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+int main() {
+    std::cout << "=== Depth Downsample Test ===" << std::endl;
+    std::cout << "SIMD kernel: " << DownsampleSimdName() << std::endl;
+
+    // 블록 크기의 배수가 아닌 래스터 (오른쪽/아래 가장자리 블록 잘림)
+    const int srcRows = 301;
+    const int srcCols = 457;
+    auto src = MakeDepths(srcRows, srcCols);
+
+    bool ok = true;
+    for (int blockLat : { 1, 4, 7 }) {
+        for (int blockLon : { 1, 5, 13 }) {
+            std::cout << "block " << blockLat << " x " << blockLon << std::endl;
+            const int dstRows = (srcRows + blockLat - 1) / blockLat;   // 잘린 블록 포함
+            const int dstCols = (srcCols + blockLon - 1) / blockLon;
+            auto reference = DownsampleDepthGrid(src, dstRows, dstCols, blockLat, blockLon, 1, DownsampleKernel::SCALAR);
+
+            // SIMD + 스레드 분할
+            for (int threads : { 1, 3 }) {
+                auto simd = DownsampleDepthGrid(src, dstRows, dstCols, blockLat, blockLon, threads, DownsampleKernel::SIMD);
+                ok &= Report(threads == 1 ? "SIMD, 1 thread" : "SIMD, 3 threads", CountMismatches(reference, simd));
+            }
+
+            // 스트립 스트리밍: 작은 스트립으로 여러 번 나눠 읽기
+            GridResolution res{};
+            res.blockLat = blockLat;
+            res.blockLon = blockLon;
+            res.rows = dstRows;
+            res.cols = dstCols;
+            int reads = 0;
+            auto streamed = DownsampleStrips(srcRows, srcCols, res, MakeReader(src, reads),
+                static_cast<size_t>(blockLat) * srcCols * 5);
+            ok &= Report("strips", CountMismatches(reference, streamed));
+            ok &= (reads > 1);
+        }
+    }
+
+    // 행별 블록 폭 (등거리 격자): 행 r은 rowBlockLon[r] 폭, rowCols[r] 셀, 나머지는 0
+    {
+        std::cout << "per-row blocks" << std::endl;
+        GridResolution res{};
+        res.blockLat = 6;
+        res.rows = (srcRows + res.blockLat - 1) / res.blockLat;
+        for (int r = 0; r < res.rows; ++r) {
+            res.rowBlockLon.push_back(3 + r % 9);
+            res.rowCols.push_back((srcCols + res.rowBlockLon.back() - 1) / res.rowBlockLon.back());
+        }
+        res.blockLon = *std::min_element(res.rowBlockLon.begin(), res.rowBlockLon.end());
+        res.cols = *std::max_element(res.rowCols.begin(), res.rowCols.end());
+
+        std::vector<std::vector<float>> reference(res.rows, std::vector<float>(res.cols, 0.0f));
+        for (int r = 0; r < res.rows; ++r) {
+            std::vector<const float*> rows;
+            for (int s = r * res.blockLat; s < std::min((r + 1) * res.blockLat, srcRows); ++s) {
+                rows.push_back(src[s].data());
+            }
+            AverageDepthBlockRow(rows, srcCols, res.rowBlockLon[r], res.rowCols[r],
+                reference[r].data(), DownsampleKernel::SCALAR);
+        }
+
+        int reads = 0;
+        auto streamed = DownsampleStrips(srcRows, srcCols, res, MakeReader(src, reads),
+            static_cast<size_t>(res.blockLat) * srcCols * 4);
+        ok &= Report("strips", CountMismatches(reference, streamed));
+    }
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
\ No newline at end of file
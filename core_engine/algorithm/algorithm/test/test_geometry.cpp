@@ -0,0 +1,252 @@
+// test_geometry.cpp - 해안선 전처리 기하 검증 (합성 상자/링, 데이터 파일/GDAL 불필요)
+// PackedRTree 질의 결과를 전수 겹침 검사와 비교 (여러 레벨, 경계 접촉, 점 상자 포함)
+// ClipRingToBox (오목 링, 상자를 감싸는 링, 경도 이동)와 SimplifyRingCells 허용 오차 확인
+
+#include "../data_loading/packed_rtree.h"
+#include "../data_loading/polygon_clip.h"
+#include "../types/geo_types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 무작위 상자: 크기 0(점)부터 수 도까지, 경도 [-180, 180)
+std::vector<BoundingBox> MakeRandomBoxes(size_t count, std::mt19937& rng) {
+    std::uniform_real_distribution<double> lat(-80.0, 80.0);
+    std::uniform_real_distribution<double> lon(-180.0, 175.0);
+    std::uniform_real_distribution<double> size(0.0, 5.0);
+    std::vector<BoundingBox> boxes;
+    for (size_t i = 0; i < count; ++i) {
+        double minLat = lat(rng);
+        double minLon = lon(rng);
+        double h = (i % 7 == 0) ? 0.0 : size(rng);
+        double w = (i % 7 == 0) ? 0.0 : size(rng);
+        boxes.emplace_back(minLat, minLat + h, minLon, minLon + w);
+    }
+    return boxes;
+}
+
+// 기준: 모든 상자와 겹침 검사 (경계 포함)
+std::vector<uint32_t> BruteForceQuery(const std::vector<BoundingBox>& boxes, const BoundingBox& query) {
+    std::vector<uint32_t> hits;
+    for (uint32_t i = 0; i < boxes.size(); ++i) {
+        const BoundingBox& b = boxes[i];
+        if (b.maxLat >= query.minLat && b.minLat <= query.maxLat
+            && b.maxLon >= query.minLon && b.minLon <= query.maxLon) {
+            hits.push_back(i);
+        }
+    }
+    return hits;
+}
+
+// 짝홀 규칙 점-다각형 판정 (닫는 점 반복 여부 무관)
+bool InsideRing(const std::vector<GeoCoordinate>& ring, double lat, double lon) {
+    bool inside = false;
+    for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        const GeoCoordinate& a = ring[i];
+        const GeoCoordinate& b = ring[j];
+        if ((a.latitude > lat) != (b.latitude > lat)) {
+            double crossLon = a.longitude + (lat - a.latitude) * (b.longitude - a.longitude) / (b.latitude - a.latitude);
+            if (lon < crossLon) inside = !inside;
+        }
+    }
+    return inside;
+}
+
+double RingArea(const std::vector<GeoCoordinate>& ring) {
+    double area = 0.0;
+    for (size_t i = 0, j = ring.size() - 1; i < ring.size(); j = i++) {
+        area += ring[j].longitude * ring[i].latitude - ring[i].longitude * ring[j].latitude;
+    }
+    return std::abs(area) / 2.0;
+}
+
+// 상자 안의 표본점(경계 제외)에서 클리핑 결과와 원본 링의 안/밖이 다른 점의 개수
+size_t CountClipMismatches(
+    const std::vector<GeoCoordinate>& ring, double lonShift,
+    const BoundingBox& box, const std::vector<GeoCoordinate>& clipped)
+{
+    size_t mismatches = 0;
+    const int samples = 40;
+    for (int i = 0; i < samples; ++i) {
+        for (int j = 0; j < samples; ++j) {
+            double lat = box.minLat + (i + 0.37) / samples * (box.maxLat - box.minLat);
+            double lon = box.minLon + (j + 0.61) / samples * (box.maxLon - box.minLon);
+            bool expected = InsideRing(ring, lat, lon - lonShift);
+            bool actual = !clipped.empty() && InsideRing(clipped, lat, lon);
+            if (expected != actual) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// 경계 위에 있지 않은 꼭짓점 개수 (상자를 감싸는 링의 결과는 상자 경계만 남아야 함)
+size_t CountOffBoundary(const std::vector<GeoCoordinate>& ring, const BoundingBox& box) {
+    const double EPS = 1e-9;
+    size_t count = 0;
+    for (const GeoCoordinate& p : ring) {
+        bool onLat = std::abs(p.latitude - box.minLat) < EPS || std::abs(p.latitude - box.maxLat) < EPS;
+        bool onLon = std::abs(p.longitude - box.minLon) < EPS || std::abs(p.longitude - box.maxLon) < EPS;
+        if (!onLat && !onLon) ++count;
+    }
+    return count;
+}
+
+// 원본 꼭짓점에서 단순화된 링까지의 최대 거리 (셀 단위)
+double MaxDeviationCells(
+    const std::vector<GeoCoordinate>& ring, const std::vector<GeoCoordinate>& simplified,
+    double cellLonDeg, double cellLatDeg)
+{
+    double worst = 0.0;
+    for (const GeoCoordinate& p : ring) {
+        double px = p.longitude / cellLonDeg, py = p.latitude / cellLatDeg;
+        double best = INFINITY;
+        for (size_t i = 0, j = simplified.size() - 1; i < simplified.size(); j = i++) {
+            double ax = simplified[j].longitude / cellLonDeg, ay = simplified[j].latitude / cellLatDeg;
+            double bx = simplified[i].longitude / cellLonDeg, by = simplified[i].latitude / cellLatDeg;
+            double ux = bx - ax, uy = by - ay;
+            double len2 = ux * ux + uy * uy;
+            double t = (len2 > 0.0) ? std::clamp(((px - ax) * ux + (py - ay) * uy) / len2, 0.0, 1.0) : 0.0;
+            best = std::min(best, std::hypot(px - ax - t * ux, py - ay - t * uy));
+        }
+        worst = std::max(worst, best);
+    }
+    return worst;
+}
+
+bool Report(const char* name, size_t mismatches) {
+    std::cout << "  " << name << ": " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+bool Expect(const char* name, bool condition) {
+    std::cout << "  " << name << ": " << (condition ? "ok" : "FAIL") << std::endl;
+    return condition;
+}
+
+// ================================================================
+// Tests
+// ================================================================
+
+bool TestPackedRTree() {
+    bool ok = true;
+    std::mt19937 rng(21);
+    std::cout << "packed r-tree" << std::endl;
+
+    // 빈 트리, 리프 하나, 리프 경계 (16/17), 여러 레벨 (16^3 초과)
+    for (size_t count : { 0u, 1u, 16u, 17u, 300u, 5000u }) {
+        std::vector<BoundingBox> boxes = MakeRandomBoxes(count, rng);
+        PackedRTree tree;
+        tree.Build(boxes);
+
+        std::vector<BoundingBox> queries = MakeRandomBoxes(200, rng);
+        for (size_t i = 0; i < std::min<size_t>(boxes.size(), 50); ++i) {
+            queries.push_back(boxes[i]);                                  // 자기 자신
+            queries.emplace_back(boxes[i].maxLat, boxes[i].maxLat + 1.0,  // 모서리만 접촉
+                boxes[i].maxLon, boxes[i].maxLon + 1.0);
+        }
+        queries.emplace_back(-90.0, 90.0, -180.0, 180.0);                 // 전체
+
+        size_t mismatches = (tree.Size() == count) ? 0 : 1;
+        for (const BoundingBox& query : queries) {
+            std::vector<uint32_t> found;
+            tree.Query(query, found);
+            std::sort(found.begin(), found.end());
+            if (found != BruteForceQuery(boxes, query)) ++mismatches;
+        }
+        std::cout << "  " << count << " boxes, " << queries.size() << " queries" << std::endl;
+        ok &= Report("query", mismatches);
+    }
+    return ok;
+}
+
+bool TestClipRing() {
+    bool ok = true;
+    std::cout << "ring clipping" << std::endl;
+    const BoundingBox box(10.0, 20.0, 100.0, 110.0);
+
+    // 오목 링 (C자): 열린 쪽이 상자 안, 팔 두 개가 상자 밖으로 나감
+    const std::vector<GeoCoordinate> concave = {
+        { 8.0, 98.0 }, { 8.0, 112.0 }, { 13.0, 112.0 }, { 13.0, 104.0 },
+        { 17.0, 104.0 }, { 17.0, 112.0 }, { 22.0, 112.0 }, { 22.0, 98.0 }
+    };
+    ok &= Report("concave ring", CountClipMismatches(concave, 0.0, box, ClipRingToBox(concave, 0.0, box)));
+
+    // 톱니 링: 상자 위쪽 변을 여러 번 드나듦
+    std::vector<GeoCoordinate> teeth = { { 5.0, 95.0 }, { 5.0, 115.0 } };
+    for (int k = 0; k <= 8; ++k) {
+        teeth.emplace_back((k % 2 == 0) ? 25.0 : 15.0, 115.0 - k * 2.5);
+    }
+    ok &= Report("toothed ring", CountClipMismatches(teeth, 0.0, box, ClipRingToBox(teeth, 0.0, box)));
+
+    // 상자를 감싸는 링: 결과는 상자 자체
+    const std::vector<GeoCoordinate> enclosing = {
+        { 0.0, 90.0 }, { 0.0, 120.0 }, { 30.0, 125.0 }, { 35.0, 95.0 }
+    };
+    std::vector<GeoCoordinate> clipped = ClipRingToBox(enclosing, 0.0, box);
+    ok &= Expect("enclosing ring is the box",
+        std::abs(RingArea(clipped) - 100.0) < 1e-9 && CountOffBoundary(clipped, box) == 0);
+    ok &= Report("enclosing ring", CountClipMismatches(enclosing, 0.0, box, clipped));
+
+    // 경도 이동 (-360): 날짜변경선 반대편 링
+    std::vector<GeoCoordinate> shifted;
+    for (const GeoCoordinate& p : concave) {
+        shifted.emplace_back(p.latitude, p.longitude + 360.0);
+    }
+    ok &= Report("shifted ring", CountClipMismatches(shifted, -360.0, box, ClipRingToBox(shifted, -360.0, box)));
+
+    // 안쪽 링은 그대로 (이동만), 밖의 링은 비어 있음
+    const std::vector<GeoCoordinate> inner = { { 12.0, 102.0 }, { 12.0, 105.0 }, { 15.0, 103.0 } };
+    std::vector<GeoCoordinate> kept = ClipRingToBox(inner, 0.0, box);
+    ok &= Expect("inner ring kept", kept.size() == inner.size()
+        && std::equal(kept.begin(), kept.end(), inner.begin(), [](const GeoCoordinate& a, const GeoCoordinate& b) {
+            return a.latitude == b.latitude && a.longitude == b.longitude;
+        }));
+    const std::vector<GeoCoordinate> outer = { { 30.0, 130.0 }, { 30.0, 135.0 }, { 35.0, 132.0 } };
+    ok &= Expect("outer ring dropped", ClipRingToBox(outer, 0.0, box).empty());
+    return ok;
+}
+
+bool TestSimplifyRing() {
+    bool ok = true;
+    std::cout << "ring simplification" << std::endl;
+
+    // 잡음 섞인 원형 링 (반지름 1°, 꼭짓점 720개)
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<double> noise(-0.002, 0.002);
+    std::vector<GeoCoordinate> ring;
+    for (int i = 0; i < 720; ++i) {
+        double a = i * 3.14159265358979323846 / 360.0;
+        ring.emplace_back(35.0 + std::sin(a) + noise(rng), 129.0 + std::cos(a) + noise(rng));
+    }
+
+    const double cellLon = 0.01, cellLat = 0.008;
+    for (double tolerance : { 0.5, 2.0 }) {
+        std::vector<GeoCoordinate> simplified = SimplifyRingCells(ring, cellLon, cellLat, tolerance);
+        double deviation = MaxDeviationCells(ring, simplified, cellLon, cellLat);
+        std::cout << "  tolerance " << tolerance << " cells: " << ring.size() << " -> "
+                  << simplified.size() << " vertices, max deviation " << deviation << std::endl;
+        ok &= Expect("within tolerance", simplified.size() < ring.size() && deviation <= tolerance + 1e-9);
+        ok &= Expect("first vertex kept", simplified.front().latitude == ring.front().latitude
+            && simplified.front().longitude == ring.front().longitude);
+    }
+    return ok;
+}
+
+int main() {
+    std::cout << "=== Geometry Test ===" << std::endl;
+
+    bool ok = true;
+    ok &= TestPackedRTree();
+    ok &= TestClipRing();
+    ok &= TestSimplifyRing();
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
\ No newline at end of file
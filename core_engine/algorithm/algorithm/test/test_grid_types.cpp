@@ -0,0 +1,398 @@
+// test_grid_types.cpp - NavigableGrid 레이어와 GridFile 저장 형식 검증 (합성 격자, 데이터 파일/GDAL 불필요)
+// GridFile Save/Load/Map 왕복 (행 우선, BLOCKED_8X8, 등거리 격자)과 손상된 파일 거부 확인
+// 스트립 병렬 연결 요소 레이블과 BFS 기준 비교
+// 분리형 최근접 특징 변환 거리 필드와 전수 최근접 탐색 비교
+// SetLayout(BLOCKED_8X8) 전후로 셀/수심/마스크/거리 필드/연결 요소가 그대로인지 확인
+
+#include "../data_loading/grid_file.h"
+#include "../types/grid_types.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <queue>
+#include <random>
+#include <string>
+#include <vector>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 무작위 육지/천해가 섞인 합성 격자 + 수심 레이어, 셀 0.05°
+NavigableGrid MakeRandomGrid(int rows, int cols, double landFraction, unsigned seed, double minLat = 30.0) {
+    NavigableGrid grid(BoundingBox(minLat, minLat + rows * 0.05, 125.0, 125.0 + cols * 0.05), rows, cols);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<float> depths(static_cast<size_t>(rows) * cols);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            double u = unit(rng);
+            CellType type = (u < landFraction) ? CellType::LAND
+                : (u < landFraction + 0.05) ? CellType::SHALLOW : CellType::NAVIGABLE;
+            grid.SetCellType(r, c, type);
+            depths[static_cast<size_t>(r) * cols + c] = (type == CellType::LAND)
+                ? static_cast<float>(100.0 * unit(rng)) : static_cast<float>(-5000.0 * unit(rng));
+        }
+    }
+    grid.SetDepths(depths);
+    return grid;
+}
+
+// 셀/수심/이웃 마스크/거리 필드/행별 셀 수가 모두 같은 셀의 개수 차이
+size_t CountLayerMismatches(const NavigableGrid& a, const NavigableGrid& b) {
+    if (a.Rows() != b.Rows() || a.Cols() != b.Cols()
+        || a.IsEqualDistance() != b.IsEqualDistance()
+        || a.HasDepths() != b.HasDepths()
+        || a.HasNeighborMasks() != b.HasNeighborMasks()
+        || a.HasDistanceFields() != b.HasDistanceFields()) {
+        return static_cast<size_t>(-1);
+    }
+    size_t mismatches = 0;
+    for (int r = 0; r < a.Rows(); ++r) {
+        if (a.RowCols(r) != b.RowCols(r)) ++mismatches;
+        for (int c = 0; c < a.Cols(); ++c) {
+            bool same = a.GetCellType(r, c) == b.GetCellType(r, c)
+                && a.IsNavigable(r, c) == b.IsNavigable(r, c)
+                && a.DepthM(r, c) == b.DepthM(r, c)
+                && a.NeighborMask(r, c) == b.NeighborMask(r, c);
+            if (same && a.HasDistanceFields()) {
+                same = a.NearestNavigableCell(r, c) == b.NearestNavigableCell(r, c)
+                    && a.NearestCoastCell(r, c) == b.NearestCoastCell(r, c);
+            }
+            if (!same) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// 기준 연결 요소: Neighbor()/NeighborMask() 간선을 무방향으로 본 BFS (행 우선 레이블)
+std::vector<int32_t> BfsComponents(const NavigableGrid& grid, std::vector<size_t>& sizes) {
+    const int rows = grid.Rows();
+    const int cols = grid.Cols();
+    auto id = [cols](int r, int c) { return static_cast<size_t>(r) * cols + c; };
+
+    std::vector<std::vector<size_t>> adjacency(static_cast<size_t>(rows) * cols);
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (!grid.IsNavigable(r, c)) continue;
+            uint8_t neighbors = grid.NeighborMask(r, c);
+            for (int i = 0; neighbors; ++i, neighbors >>= 1) {
+                if (!(neighbors & 1u)) continue;
+                GridCoordinate n = grid.Neighbor(r, c, i);
+                adjacency[id(r, c)].push_back(id(n.row, n.col));
+                adjacency[id(n.row, n.col)].push_back(id(r, c));
+            }
+        }
+    }
+
+    std::vector<int32_t> labels(adjacency.size(), -1);
+    sizes.clear();
+    for (int r = 0; r < rows; ++r) {
+        for (int c = 0; c < cols; ++c) {
+            if (!grid.IsNavigable(r, c) || labels[id(r, c)] >= 0) continue;
+            int32_t label = static_cast<int32_t>(sizes.size());
+            sizes.push_back(0);
+            std::queue<size_t> open;
+            open.push(id(r, c));
+            labels[id(r, c)] = label;
+            while (!open.empty()) {
+                size_t cur = open.front();
+                open.pop();
+                ++sizes[label];
+                for (size_t next : adjacency[cur]) {
+                    if (labels[next] < 0) {
+                        labels[next] = label;
+                        open.push(next);
+                    }
+                }
+            }
+        }
+    }
+    return labels;
+}
+
+// ComponentOf가 BFS와 같은 분할인지: 레이블 사이 일대일 대응 + 요소 크기
+size_t CountComponentMismatches(const NavigableGrid& grid) {
+    std::vector<size_t> bfsSizes;
+    std::vector<int32_t> bfs = BfsComponents(grid, bfsSizes);
+    if (!grid.HasComponents() || grid.ComponentCount() != static_cast<int>(bfsSizes.size())) {
+        return static_cast<size_t>(-1);
+    }
+
+    std::vector<int32_t> toBfs(grid.ComponentCount(), -1);
+    std::vector<int32_t> fromBfs(bfsSizes.size(), -1);
+    size_t mismatches = 0;
+    for (int r = 0; r < grid.Rows(); ++r) {
+        for (int c = 0; c < grid.Cols(); ++c) {
+            int32_t label = bfs[static_cast<size_t>(r) * grid.Cols() + c];
+            int32_t component = grid.ComponentOf(r, c);
+            if (label < 0 || component < 0) {
+                if (label != component) ++mismatches;
+                continue;
+            }
+            if (toBfs[component] < 0 && fromBfs[label] < 0) {
+                toBfs[component] = label;
+                fromBfs[label] = component;
+            }
+            if (toBfs[component] != label || fromBfs[label] != component
+                || grid.ComponentSize(component) != bfsSizes[label]) {
+                ++mismatches;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// 기준 거리 필드: 모든 특징 셀까지의 최소 거리 (BuildDistanceFields와 같은
+// 중위도 평면 근사 km), 특징이 없으면 -1
+size_t CountDistanceMismatches(const NavigableGrid& grid, bool toNavigable) {
+    const double PI_D = 3.14159265358979323846;
+    const double kmPerDeg = 6371.0 * PI_D / 180.0;
+    const double midLat = (grid.Bounds().minLat + grid.Bounds().maxLat) / 2.0;
+    const double rowKm = grid.CellSizeLat() * kmPerDeg;
+    const double colKm = std::max(1e-6, grid.CellSizeLon() * kmPerDeg * std::cos(midLat * PI_D / 180.0));
+
+    std::vector<GridCoordinate> features;
+    for (int r = 0; r < grid.Rows(); ++r) {
+        for (int c = 0; c < grid.Cols(); ++c) {
+            if (grid.IsNavigable(r, c) == toNavigable) features.emplace_back(r, c);
+        }
+    }
+
+    size_t mismatches = 0;
+    for (int r = 0; r < grid.Rows(); ++r) {
+        for (int c = 0; c < grid.Cols(); ++c) {
+            double expected = -1.0;
+            for (const GridCoordinate& f : features) {
+                double d = std::hypot((f.row - r) * rowKm, (f.col - c) * colKm);
+                if (expected < 0.0 || d < expected) expected = d;
+            }
+            // 같은 거리의 후보가 여럿일 수 있으므로 셀이 아니라 거리와 특징 여부를 비교
+            GridCoordinate nearest = toNavigable ? grid.NearestNavigableCell(r, c) : grid.NearestCoastCell(r, c);
+            double actual = toNavigable ? grid.DistanceToNavigableKm(r, c) : grid.DistanceFromCoastKm(r, c);
+            bool same = (expected < 0.0)
+                ? (actual < 0.0 && nearest.row < 0)
+                : (nearest.row >= 0 && grid.IsNavigable(nearest.row, nearest.col) == toNavigable
+                    && std::abs(actual - expected) <= 1e-9 * std::max(1.0, expected));
+            if (!same) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+// CellIndex <-> CellAt 왕복이 모든 셀에서 성립하지 않는 개수
+size_t CountIndexMismatches(const NavigableGrid& grid) {
+    size_t mismatches = 0;
+    for (int r = 0; r < grid.Rows(); ++r) {
+        for (int c = 0; c < grid.Cols(); ++c) {
+            size_t index = grid.CellIndex(r, c);
+            if (index >= grid.CellIndexCount() || !(grid.CellAt(index) == GridCoordinate(r, c))) ++mismatches;
+        }
+    }
+    return mismatches;
+}
+
+std::vector<char> ReadBytes(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void WriteBytes(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+bool Report(const char* name, size_t mismatches) {
+    std::cout << "  " << name << ": " << mismatches << " mismatches" << std::endl;
+    return mismatches == 0;
+}
+
+bool Expect(const char* name, bool condition) {
+    std::cout << "  " << name << ": " << (condition ? "ok" : "FAIL") << std::endl;
+    return condition;
+}
+
+// Save -> Load / Map(검증) 후 원본과 레이어 비교
+bool CheckRoundTrip(const char* name, const NavigableGrid& grid, const std::string& path) {
+    std::cout << name << std::endl;
+    bool ok = Expect("save", GridFile::Save(grid, path, GridFileInfo(5.0, 20.0)));
+
+    NavigableGrid loaded;
+    GridFileInfo info;
+    ok &= Expect("load", GridFile::Load(path, loaded, &info));
+    ok &= Expect("info", info.cellSizeKm == 5.0 && info.shallowDepthM == 20.0);
+    ok &= Report("loaded", CountLayerMismatches(grid, loaded));
+
+    NavigableGrid mapped;
+    ok &= Expect("map", GridFile::Map(path, mapped, nullptr, true));
+    ok &= Report("mapped", CountLayerMismatches(grid, mapped));
+    return ok;
+}
+
+// ================================================================
+// Tests
+// ================================================================
+
+bool TestGridFileRoundTrip() {
+    const std::string path = "test_grid_types.grid";
+    bool ok = true;
+
+    // 행 우선 + 모든 선택 레이어 (8의 배수가 아닌 크기)
+    NavigableGrid rowMajor = MakeRandomGrid(53, 77, 0.3, 1);
+    rowMajor.BuildNeighborMasks();
+    rowMajor.BuildDistanceFields();
+    ok &= CheckRoundTrip("row-major grid", rowMajor, path);
+
+    // BLOCKED_8X8: 파일은 항상 행 우선, 읽은 셀은 같아야 함
+    NavigableGrid blocked = MakeRandomGrid(53, 77, 0.3, 2);
+    blocked.SetLayout(CellLayout::BLOCKED_8X8);
+    blocked.BuildNeighborMasks();
+    ok &= CheckRoundTrip("blocked 8x8 grid", blocked, path);
+
+    // 등거리 격자: 행별 셀 수도 저장
+    NavigableGrid equalDistance = MakeRandomGrid(40, 64, 0.3, 3);
+    std::vector<int> rowCols;
+    for (int r = 0; r < equalDistance.Rows(); ++r) {
+        rowCols.push_back(64 - r);
+    }
+    equalDistance.SetRowLayout(rowCols);
+    equalDistance.BuildNeighborMasks();
+    ok &= CheckRoundTrip("equal-distance grid", equalDistance, path);
+
+    // 손상된 파일 거부: 헤더 (magic, version), 페이로드 (checksum), 잘린 파일
+    std::cout << "corrupted files" << std::endl;
+    ok &= Expect("save", GridFile::Save(rowMajor, path));
+    const std::vector<char> original = ReadBytes(path);
+    NavigableGrid rejected;
+
+    std::vector<char> bytes = original;
+    bytes[0] ^= 0x20;
+    WriteBytes(path, bytes);
+    ok &= Expect("bad magic rejected", !GridFile::Map(path, rejected) && !GridFile::Load(path, rejected));
+
+    bytes = original;
+    bytes[offsetof(GridFileHeader, version)] ^= 0x01;
+    WriteBytes(path, bytes);
+    ok &= Expect("bad version rejected", !GridFile::Map(path, rejected) && !GridFile::Load(path, rejected));
+
+    bytes = original;
+    bytes[sizeof(GridFileHeader) + 100] ^= 0x01;
+    WriteBytes(path, bytes);
+    ok &= Expect("bad payload rejected", !GridFile::Map(path, rejected, nullptr, true) && !GridFile::Load(path, rejected));
+
+    bytes = original;
+    bytes.resize(bytes.size() - 64);
+    WriteBytes(path, bytes);
+    ok &= Expect("truncated file rejected", !GridFile::Map(path, rejected) && !GridFile::Load(path, rejected));
+
+    std::remove(path.c_str());
+    return ok;
+}
+
+// 128행 이상: BuildComponents가 여러 스트립으로 나눠 레이블하고 경계에서 병합
+bool TestComponents() {
+    bool ok = true;
+    std::cout << "components" << std::endl;
+
+    NavigableGrid rowMajor = MakeRandomGrid(203, 150, 0.45, 4);
+    rowMajor.BuildNeighborMasks();
+    for (int threads : { 1, 3 }) {
+        rowMajor.BuildComponents(threads);
+        ok &= Report(threads == 1 ? "row-major, 1 thread" : "row-major, 3 threads", CountComponentMismatches(rowMajor));
+    }
+
+    NavigableGrid blocked = MakeRandomGrid(203, 150, 0.45, 5);
+    blocked.SetLayout(CellLayout::BLOCKED_8X8);
+    blocked.BuildNeighborMasks();
+    blocked.BuildComponents(3);
+    ok &= Report("blocked 8x8, 3 threads", CountComponentMismatches(blocked));
+
+    // 등거리 격자: 행마다 셀 수가 달라 이웃 관계가 비대칭
+    NavigableGrid equalDistance = MakeRandomGrid(160, 120, 0.4, 6);
+    std::vector<int> rowCols;
+    for (int r = 0; r < equalDistance.Rows(); ++r) {
+        rowCols.push_back(60 + (r * 7) % 61);
+    }
+    equalDistance.SetRowLayout(rowCols);
+    equalDistance.BuildNeighborMasks();
+    equalDistance.BuildComponents(2);
+    ok &= Report("equal-distance, 2 threads", CountComponentMismatches(equalDistance));
+
+    ok &= Expect("multiple components", rowMajor.ComponentCount() > 1);
+    return ok;
+}
+
+bool TestDistanceFields() {
+    bool ok = true;
+    std::cout << "distance fields" << std::endl;
+
+    // 고위도 (열 간격 < 행 간격), 드문 특징, 특징 없음
+    struct Case { const char* name; int rows; int cols; double lat; double landFraction; };
+    for (const Case& test : { Case{ "mixed", 61, 83, 30.0, 0.3 },
+                              Case{ "high latitude", 47, 90, 65.0, 0.6 },
+                              Case{ "sparse water", 50, 70, 30.0, 0.97 },
+                              Case{ "no land", 20, 30, 30.0, 0.0 } }) {
+        NavigableGrid grid = MakeRandomGrid(test.rows, test.cols, test.landFraction, 7, test.lat);
+        if (test.landFraction == 0.0) {
+            for (int r = 0; r < grid.Rows(); ++r) {
+                for (int c = 0; c < grid.Cols(); ++c) {
+                    grid.SetCellType(r, c, CellType::NAVIGABLE);   // 천해도 제거
+                }
+            }
+        }
+        grid.BuildDistanceFields();
+        std::cout << "  " << test.name << std::endl;
+        ok &= Report("to navigable", CountDistanceMismatches(grid, true));
+        ok &= Report("from coast", CountDistanceMismatches(grid, false));
+    }
+    return ok;
+}
+
+bool TestBlockedLayout() {
+    bool ok = true;
+    std::cout << "blocked layout" << std::endl;
+
+    // 8의 배수가 아닌 크기, 8보다 좁은 격자, 스트립이 여러 개인 격자
+    struct Case { int rows; int cols; };
+    for (const Case& test : { Case{ 53, 77 }, Case{ 130, 5 }, Case{ 8, 8 }, Case{ 131, 99 } }) {
+        NavigableGrid reference = MakeRandomGrid(test.rows, test.cols, 0.4, 8);
+        reference.BuildNeighborMasks();
+        reference.BuildDistanceFields();
+        reference.BuildComponents(3);
+
+        NavigableGrid grid = MakeRandomGrid(test.rows, test.cols, 0.4, 8);
+        grid.BuildNeighborMasks();
+        grid.BuildDistanceFields();
+        grid.BuildComponents(3);
+
+        std::cout << "  " << test.rows << " x " << test.cols << std::endl;
+        grid.SetLayout(CellLayout::BLOCKED_8X8);
+        ok &= Expect("blocked", grid.Layout() == CellLayout::BLOCKED_8X8 && grid.HasComponents());
+        ok &= Report("layers", CountLayerMismatches(reference, grid));
+        ok &= Report("cell index", CountIndexMismatches(grid));
+        ok &= Report("components", CountComponentMismatches(grid));
+        ok &= Expect("component count", grid.ComponentCount() == reference.ComponentCount());
+
+        grid.SetLayout(CellLayout::ROW_MAJOR);
+        ok &= Expect("row-major again", grid.Layout() == CellLayout::ROW_MAJOR && grid.HasComponents());
+        ok &= Report("layers", CountLayerMismatches(reference, grid));
+        ok &= Report("components", CountComponentMismatches(grid));
+    }
+    return ok;
+}
+
+int main() {
+    std::cout << "=== Grid Types Test ===" << std::endl;
+
+    bool ok = true;
+    ok &= TestGridFileRoundTrip();
+    ok &= TestComponents();
+    ok &= TestDistanceFields();
+    ok &= TestBlockedLayout();
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+// test_weather_diff.cpp - diffWeatherData 변경 영역 검증 (합성 날씨, 데이터 파일 불필요)
+// 한 셀의 값을 바꾼 뒤, 조회 결과가 달라지는 모든 좌표가 변경 영역 안에 있는지 확인
+// LatBin 양수/음수 모두 (get3dIndex는 부호와 무관하게 lat_idx 증가 = 남쪽)
+
+#include "../utils/weather_interpolation.h"
+#include <cmath>
+#include <iostream>
+#include <map>
+#include <string>
+
+// ================================================================
+// Helper Functions
+// ================================================================
+
+// 10° 격자, 30N ~ -20S (5 bin), 100E ~ 160E (6 bin), 3시간 x 2
+WeatherDataInput MakeField(float latBin) {
+    WeatherDataInput data;
+    data.iStartTime = 0;
+    data.iNumTime = 2;
+    data.iTimeBin = 3;
+    data.StartLon = 100.0f;
+    data.iNumLon = 6;
+    data.LonBin = 10.0f;
+    data.StartLat = 30.0f;
+    data.iNumLat = 5;
+    data.LatBin = latBin;
+    data.data.resize(static_cast<size_t>(data.iNumTime) * data.iNumLon * data.iNumLat);
+    for (size_t i = 0; i < data.data.size(); ++i) {
+        data.data[i] = static_cast<float>(i % 17);
+    }
+    return data;
+}
+
+// [time][lon][lat] 레이아웃의 한 셀 변경 후, 바뀐 조회 좌표가 모두 변경 영역 안인지 검사
+bool CheckCellChange(float latBin, int lonIdx, int latIdx) {
+    WeatherDataInput oldField = MakeField(latBin);
+    WeatherDataInput newField = oldField;
+    newField.data[(static_cast<size_t>(1) * newField.iNumLon + lonIdx) * newField.iNumLat + latIdx] += 5.0f;
+
+    std::map<std::string, WeatherDataInput> oldWeather = { { "WindSpd.bin", oldField } };
+    std::map<std::string, WeatherDataInput> newWeather = { { "WindSpd.bin", newField } };
+    auto regions = diffWeatherData(oldWeather, newWeather);
+    if (regions.size() != 1 || regions[0].global) {
+        std::cerr << "  expected one local region, got " << regions.size() << std::endl;
+        return false;
+    }
+
+    const unsigned int time = 4 * 3600;   // time bin 1
+    int changed = 0, missed = 0, extra = 0;
+    for (double lat = -89.5; lat <= 89.5; lat += 0.5) {
+        for (double lon = -179.5; lon <= 179.5; lon += 0.5) {
+            double before = getWeatherAtCoordinate(oldWeather, time, lat, lon).windSpd;
+            double after = getWeatherAtCoordinate(newWeather, time, lat, lon).windSpd;
+            bool inRegion = isInWeatherChangeRegion(regions[0], time, lat, lon);
+            if (before != after) {
+                ++changed;
+                if (!inRegion) ++missed;
+            }
+            else if (inRegion) {
+                ++extra;
+            }
+        }
+    }
+
+    std::cout << "  LatBin " << latBin << ", cell (lon " << lonIdx << ", lat " << latIdx << "): "
+              << changed << " changed samples, " << missed << " missed, "
+              << extra << " extra (lat " << regions[0].minLat << " ~ " << regions[0].maxLat << ")" << std::endl;
+    return changed > 0 && missed == 0;
+}
+
+int main() {
+    std::cout << "=== Weather Change Region Test ===" << std::endl;
+
+    bool ok = true;
+    for (float latBin : { 10.0f, -10.0f }) {
+        ok &= CheckCellChange(latBin, 2, 2);   // 내부 셀
+        ok &= CheckCellChange(latBin, 0, 0);   // 북쪽 끝 bin (북극까지 clamp)
+        ok &= CheckCellChange(latBin, 5, 4);   // 남쪽/동쪽 끝 bin (남극, 360도까지 clamp)
+    }
+
+    std::cout << (ok ? "PASSED" : "FAILED") << std::endl;
+    return ok ? 0 : 1;
+}
\ No newline at end of file
@@ -10,14 +10,34 @@ BoundingBox BoundingBox::FromWaypoints(const std::vector<GeoCoordinate>& waypoin
 
     double minLat = waypoints[0].latitude;
     double maxLat = waypoints[0].latitude;
-    double minLon = waypoints[0].longitude;
-    double maxLon = waypoints[0].longitude;
+    std::vector<double> lons;
+    lons.reserve(waypoints.size());
 
     for (const auto& point : waypoints) {
         minLat = std::min(minLat, point.latitude);
         maxLat = std::max(maxLat, point.latitude);
-        minLon = std::min(minLon, point.longitude);
-        maxLon = std::max(maxLon, point.longitude);
+
+        double lon = point.longitude;
+        if (lon < -180.0 || lon > 180.0) {
+            lon = std::fmod(std::fmod(lon + 180.0, 360.0) + 360.0, 360.0) - 180.0;
+        }
+        lons.push_back(lon);
+    }
+
+    // 경도: 모든 웨이포인트를 포함하는 가장 짧은 호 (가장 큰 빈 구간의 반대편)
+    // 날짜변경선을 넘으면 maxLon > 180
+    std::sort(lons.begin(), lons.end());
+    double minLon = lons.front();
+    double maxLon = lons.back();
+    double largestGap = lons.front() + 360.0 - lons.back();   // 날짜변경선을 지나는 구간
+
+    for (size_t i = 0; i + 1 < lons.size(); ++i) {
+        double gap = lons[i + 1] - lons[i];
+        if (gap > largestGap) {
+            largestGap = gap;
+            minLon = lons[i + 1];
+            maxLon = lons[i] + 360.0;
+        }
     }
 
     return BoundingBox(minLat, maxLat, minLon, maxLon);
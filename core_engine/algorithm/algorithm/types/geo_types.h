@@ -13,6 +13,8 @@ struct GeoCoordinate {
     GeoCoordinate(double lat, double lon) : latitude(lat), longitude(lon) {}
 };
 
+// Longitudes are continuous inside a box: a box across the antimeridian
+// has maxLon > 180 (e.g. 120 ~ 240 for Busan -> Vancouver).
 struct BoundingBox {
     double minLat, maxLat;
     double minLon, maxLon;
@@ -24,10 +26,19 @@ struct BoundingBox {
     }
 
     bool Contains(const GeoCoordinate& point) const {
+        double lon = UnwrapLongitude(point.longitude);
         return point.latitude >= minLat && point.latitude <= maxLat &&
-            point.longitude >= minLon && point.longitude <= maxLon;
+            lon >= minLon && lon <= maxLon;
     }
 
+    // lon + k*360 closest to the box centre
+    double UnwrapLongitude(double lon) const {
+        double center = (minLon + maxLon) / 2.0;
+        return lon + 360.0 * std::round((center - lon) / 360.0);
+    }
+
+    bool CrossesAntimeridian() const { return minLon < -180.0 || maxLon > 180.0; }
+
     double Width() const { return maxLon - minLon; }
     double Height() const { return maxLat - minLat; }
 
@@ -2,6 +2,13 @@
 #include <iostream>
 #include <cmath>
 #include <algorithm>
+#include <atomic>
+#include <limits>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
 
 // ===== GridResolution Implementation =====
 std::pair<int, int> GridResolution::CalculateBlockSize(
@@ -34,7 +41,6 @@ GridResolution GridResolution::Calculate(
     res.rows = std::max(1, srcHeight / blockLat);
     res.cols = std::max(1, srcWidth / blockLon);
 
-    const int MAX_GRID_SIZE = 9000;
     res.rows = std::min(res.rows, MAX_GRID_SIZE);
     res.cols = std::min(res.cols, MAX_GRID_SIZE);
 
@@ -47,15 +53,213 @@ GridResolution GridResolution::Calculate(
     return res;
 }
 
+GridResolution GridResolution::CalculateEqualDistance(
+    const BoundingBox& roi,
+    int srcHeight, int srcWidth,
+    double targetCellSizeKm)
+{
+    using namespace GEBCOConstants;
+
+    GridResolution res{};
+    res.cellSizeKm = targetCellSizeKm;
+    res.blockLat = std::max(1, static_cast<int>(std::round(targetCellSizeKm / KM_PER_PIXEL_LAT)));
+    res.rows = std::min(std::max(1, srcHeight / res.blockLat), MAX_GRID_SIZE);
+
+    double rowDeg = roi.Height() / res.rows;
+    res.rowBlockLon.resize(res.rows);
+    res.rowCols.resize(res.rows);
+    res.blockLon = std::numeric_limits<int>::max();
+    res.cols = 1;
+
+    for (int r = 0; r < res.rows; ++r) {
+        double lat = roi.maxLat - (r + 0.5) * rowDeg;
+        // Keep at least 1 m per pixel so polar rows stay finite
+        double kmPerPixLon = std::max(1e-3, KM_PER_PIXEL_LAT * std::cos(lat * PI / 180.0));
+        int blockLon = std::max(1, static_cast<int>(std::round(targetCellSizeKm / kmPerPixLon)));
+        blockLon = std::min(blockLon, std::max(1, srcWidth));
+
+        res.rowBlockLon[r] = blockLon;
+        res.rowCols[r] = std::min(std::max(1, srcWidth / blockLon), MAX_GRID_SIZE);
+        res.blockLon = std::min(res.blockLon, blockLon);
+        res.cols = std::max(res.cols, res.rowCols[r]);
+    }
+    return res;
+}
+
+// ===== Equal-Distance Row Layout =====
+void GeoIndexMapper::SetRowLayout(const std::vector<int>& rowCols) {
+    rowCols_.clear();
+    rowCellSizeLon_.clear();
+    if (rowCols.empty()) {
+        return;
+    }
+    rowCols_.resize(rows_);
+    rowCellSizeLon_.resize(rows_);
+    for (int r = 0; r < rows_; ++r) {
+        int n = (r < static_cast<int>(rowCols.size())) ? rowCols[r] : cols_;
+        rowCols_[r] = std::clamp(n, 1, cols_);
+        rowCellSizeLon_[r] = bounds_.Width() / static_cast<double>(rowCols_[r]);
+    }
+}
+
+// ===== Tile Cache (tiled NavigableGrid) =====
+// Get keeps a per-thread pointer to the last tile it read, so consecutive
+// lookups in one tile (nearly every expansion of a search) take no lock.
+// That reference keeps the tile's cells alive if the tile is evicted
+// meanwhile; Set bumps epoch_ so stale references are dropped. As with flat
+// grids, SetCellType must not run concurrently with searches.
+class GridTileCache {
+public:
+    GridTileCache(int rows, int cols, int tileSize, size_t memoryBudgetBytes, GridTileLoader loader)
+        : rows_(rows), cols_(cols), tileSize_(std::max(1, tileSize))
+        , tilesX_((cols + tileSize_ - 1) / tileSize_)
+        , budget_(memoryBudgetBytes), bytes_(0), loader_(std::move(loader))
+        , cacheId_(nextCacheId_.fetch_add(1, std::memory_order_relaxed)), epoch_(0) {
+    }
+
+    CellType Get(int row, int col) {
+        struct LastTile {
+            uint64_t cacheId = 0;   // Ids start at 1: never matches a fresh entry
+            uint64_t epoch = 0;
+            int tileId = -1;
+            std::shared_ptr<const std::vector<uint8_t>> cells;
+        };
+        thread_local LastTile last;
+
+        const int id = TileId(row, col);
+        const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+        if (last.cacheId == cacheId_ && last.tileId == id && last.epoch == epoch) {
+            return static_cast<CellType>((*last.cells)[Offset(row, col)]);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Tile& tile = Acquire(row, col);
+        last.cacheId = cacheId_;
+        last.epoch = epoch;
+        last.tileId = id;
+        last.cells = tile.cells;
+        return static_cast<CellType>((*tile.cells)[Offset(row, col)]);
+    }
+
+    void Set(int row, int col, CellType type) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Tile& tile = Acquire(row, col);
+        (*tile.cells)[Offset(row, col)] = static_cast<uint8_t>(type);
+        tile.pinned = true;
+        epoch_.fetch_add(1, std::memory_order_release);
+    }
+
+    size_t Bytes() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return bytes_;
+    }
+
+private:
+    struct Tile {
+        std::shared_ptr<std::vector<uint8_t>> cells;
+        std::list<int>::iterator lru;
+        bool pinned = false;
+    };
+
+    int TileId(int row, int col) const {
+        return (row / tileSize_) * tilesX_ + (col / tileSize_);
+    }
+
+    size_t Offset(int row, int col) const {
+        return static_cast<size_t>(row % tileSize_) * tileSize_ + (col % tileSize_);
+    }
+
+    Tile& Acquire(int row, int col) {
+        int id = TileId(row, col);
+        if (id == lastId_) {
+            return *last_;
+        }
+
+        auto it = tiles_.find(id);
+        if (it != tiles_.end()) {
+            lru_.splice(lru_.begin(), lru_, it->second.lru);
+        } else {
+            it = tiles_.emplace(id, Load(id)).first;
+            lru_.push_front(id);
+            it->second.lru = lru_.begin();
+            bytes_ += it->second.cells->size();
+            Evict(id);
+        }
+
+        lastId_ = id;
+        last_ = &it->second;
+        return it->second;
+    }
+
+    Tile Load(int id) {
+        int firstRow = (id / tilesX_) * tileSize_;
+        int firstCol = (id % tilesX_) * tileSize_;
+        int tileRows = std::min(tileSize_, rows_ - firstRow);
+        int tileCols = std::min(tileSize_, cols_ - firstCol);
+
+        std::vector<uint8_t> loaded;
+        loader_(firstRow, firstCol, tileRows, tileCols, loaded);
+
+        // Store at full tile stride; missing cells stay UNKNOWN
+        Tile tile;
+        tile.cells = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(tileSize_) * tileSize_, 0);
+        for (int r = 0; r < tileRows; ++r) {
+            size_t src = static_cast<size_t>(r) * tileCols;
+            if (src + tileCols > loaded.size()) break;
+            std::copy(loaded.begin() + src, loaded.begin() + src + tileCols,
+                tile.cells->begin() + static_cast<size_t>(r) * tileSize_);
+        }
+        return tile;
+    }
+
+    // Drop least recently used unpinned tiles (never the one just loaded)
+    void Evict(int keepId) {
+        auto it = lru_.end();
+        while (bytes_ > budget_ && it != lru_.begin()) {
+            --it;
+            int id = *it;
+            Tile& tile = tiles_[id];
+            if (id == keepId || tile.pinned) {
+                continue;
+            }
+            bytes_ -= tile.cells->size();
+            it = lru_.erase(it);
+            tiles_.erase(id);
+        }
+    }
+
+    int rows_;
+    int cols_;
+    int tileSize_;
+    int tilesX_;
+    size_t budget_;
+    size_t bytes_;
+    GridTileLoader loader_;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<int, Tile> tiles_;
+    std::list<int> lru_;   // Most recently used first
+    int lastId_ = -1;
+    Tile* last_ = nullptr;
+
+    const uint64_t cacheId_;              // Unique per cache (a freed cache's address may be reused)
+    std::atomic<uint64_t> epoch_;         // Bumped by Set
+    static std::atomic<uint64_t> nextCacheId_;
+};
+
+std::atomic<uint64_t> GridTileCache::nextCacheId_(1);
+
 // ===== NavigableGrid Implementation =====
 NavigableGrid::NavigableGrid()
-    : rows_(0), cols_(0), cellSizeLat_(0), cellSizeLon_(0), mapper_() {
+    : rows_(0), cols_(0), cellSizeLat_(0), cellSizeLon_(0), mapper_()
+    , storage_(GridStorage::BYTE) {
 }
 
-NavigableGrid::NavigableGrid(const BoundingBox& bounds, int rows, int cols)
+NavigableGrid::NavigableGrid(const BoundingBox& bounds, int rows, int cols, GridStorage storage)
     : geoBounds_(bounds), rows_(rows), cols_(cols), mapper_(bounds, rows, cols)
+    , storage_(storage)
 {
-    grid_.resize(rows_, std::vector<CellType>(cols_, CellType::UNKNOWN));
+    Allocate();
 
     cellSizeLat_ = bounds.Height() / rows_;
     cellSizeLon_ = bounds.Width() / cols_;
@@ -65,38 +269,678 @@ NavigableGrid::NavigableGrid(const BoundingBox& bounds, int rows, int cols)
 #endif
 }
 
+NavigableGrid NavigableGrid::Tiled(
+    const BoundingBox& bounds, int rows, int cols,
+    int tileSize, size_t memoryBudgetBytes, GridTileLoader loader)
+{
+    NavigableGrid grid;
+    grid.geoBounds_ = bounds;
+    grid.rows_ = rows;
+    grid.cols_ = cols;
+    grid.mapper_.Reset(bounds, rows, cols);
+    grid.cellSizeLat_ = bounds.Height() / rows;
+    grid.cellSizeLon_ = bounds.Width() / cols;
+    grid.tiles_ = std::make_shared<GridTileCache>(
+        rows, cols, tileSize, memoryBudgetBytes, std::move(loader));
+    return grid;
+}
+
+CellType NavigableGrid::TiledCell(int row, int col) const {
+    return tiles_->Get(row, col);
+}
+
+void NavigableGrid::StoreTiledCell(int row, int col, CellType type) {
+    tiles_->Set(row, col, type);
+}
+
 void NavigableGrid::Reset(const BoundingBox& bounds, int rows, int cols) {
+    tiles_.reset();
+    view_ = GridLayerView();
     geoBounds_ = bounds;
     rows_ = rows;
     cols_ = cols;
     mapper_.Reset(bounds, rows, cols);
-    grid_.resize(rows_, std::vector<CellType>(cols_, CellType::UNKNOWN));
+    Allocate();
     
     cellSizeLat_ = bounds.Height() / rows_;
     cellSizeLon_ = bounds.Width() / cols_;
 }
 
-CellType NavigableGrid::GetCellType(int row, int col) const {
-    if (!IsValid(row, col)) return CellType::UNKNOWN;
-    return grid_[row][col];
+void NavigableGrid::Allocate() {
+    blockCols_ = (std::max(0, cols_) + 7) / 8;
+    size_t count = CellIndexCount();
+
+    // UNKNOWN == 0, so zero-filled buffers are all UNKNOWN / not navigable
+    cells_.assign(storage_ == GridStorage::BYTE ? count : (count + 3) / 4, 0);
+    navBits_.assign((count + 63) / 64, 0);
+    neighborMasks_.clear();
+    ClearDistanceFields();
+    ClearComponents();
+    depthDm_.clear();
 }
 
-void NavigableGrid::SetCellType(int row, int col, CellType type) {
-    if (IsValid(row, col)) {
-        grid_[row][col] = type;
+NavigableGrid NavigableGrid::ReadOnly(
+    const BoundingBox& bounds, int rows, int cols,
+    GridLayerView layers, const std::vector<int>& rowCols)
+{
+    if (!layers.cells || !layers.navBits) {
+        throw std::invalid_argument("NavigableGrid::ReadOnly: cells and navBits are required");
+    }
+    NavigableGrid grid;
+    grid.geoBounds_ = bounds;
+    grid.rows_ = rows;
+    grid.cols_ = cols;
+    grid.mapper_.Reset(bounds, rows, cols);
+    grid.mapper_.SetRowLayout(rowCols);
+    grid.cellSizeLat_ = bounds.Height() / rows;
+    grid.cellSizeLon_ = bounds.Width() / cols;
+    grid.view_ = std::move(layers);
+    if (!grid.view_.nearestNavigable || !grid.view_.nearestCoast) {
+        grid.view_.nearestNavigable = nullptr;
+        grid.view_.nearestCoast = nullptr;
     }
+    grid.SetFieldCellKm();
+    return grid;
 }
 
-bool NavigableGrid::IsNavigable(int row, int col) const {
-    return IsValid(row, col) && grid_[row][col] == CellType::NAVIGABLE;
+void NavigableGrid::MakeWritable() {
+    if (!IsReadOnly()) {
+        return;
+    }
+    size_t count = static_cast<size_t>(rows_) * static_cast<size_t>(cols_);
+    storage_ = GridStorage::BYTE;
+    cells_.assign(view_.cells, view_.cells + count);
+    navBits_.assign(view_.navBits, view_.navBits + (count + 63) / 64);
+    if (neighborMasks_.empty() && view_.neighborMasks) {
+        neighborMasks_.assign(view_.neighborMasks, view_.neighborMasks + count);
+    }
+    if (nearestNavigable_.empty() && view_.nearestNavigable) {
+        nearestNavigable_.assign(view_.nearestNavigable, view_.nearestNavigable + count);
+        nearestCoast_.assign(view_.nearestCoast, view_.nearestCoast + count);
+    }
+    if (depthDm_.empty() && view_.depthDm) {
+        depthDm_.assign(view_.depthDm, view_.depthDm + count);
+    }
+    view_ = GridLayerView();
 }
 
-bool NavigableGrid::IsValid(int row, int col) const {
-    return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+void NavigableGrid::SetRowLayout(const std::vector<int>& rowCols) {
+    if (IsReadOnly()) {
+        throw std::logic_error("NavigableGrid: read-only grid");
+    }
+    mapper_.SetRowLayout(rowCols);
+    neighborMasks_.clear();
+    ClearDistanceFields();
+    ClearComponents();
 }
 
-bool NavigableGrid::IsValid(const GridCoordinate& pos) const {
-    return IsValid(pos.row, pos.col);
+// ===== Neighbour Masks =====
+void NavigableGrid::BuildNeighborMasks() {
+    if (tiles_) {
+        return;   // Would load every tile; masks are computed on the fly
+    }
+    size_t count = CellIndexCount();
+    neighborMasks_.assign(count, 0);
+    if (count == 0) {
+        return;
+    }
+
+    // Diagonal/vertical neighbours are re-based per row: no rolling-row shortcut
+    if (IsEqualDistance()) {
+        for (int r = 0; r < rows_; ++r) {
+            for (int c = 0; c < mapper_.RowCols(r); ++c) {
+                neighborMasks_[Index(r, c)] = ComputeNeighborMask(r, c);
+            }
+        }
+        return;
+    }
+
+    // Three rolling rows of 0/1 bytes, padded by one zero column on each side
+    size_t width = static_cast<size_t>(cols_) + 2;
+    std::vector<uint8_t> up(width, 0), cur(width, 0), down(width, 0);
+
+    auto unpackRow = [this](int row, std::vector<uint8_t>& out) {
+        if (row < 0 || row >= rows_) {
+            std::fill(out.begin(), out.end(), uint8_t(0));
+            return;
+        }
+        for (int c = 0; c < cols_; ++c) {
+            size_t idx = Index(row, c);
+            out[c + 1] = static_cast<uint8_t>((NavWords()[idx >> 6] >> (idx & 63)) & 1u);
+        }
+    };
+
+    // Rows are contiguous only in ROW_MAJOR; otherwise compute into a row
+    // buffer and scatter
+    const bool rowMajor = (layout_ == CellLayout::ROW_MAJOR);
+    std::vector<uint8_t> rowMasks(rowMajor ? 0 : static_cast<size_t>(cols_));
+
+    unpackRow(-1, up);
+    unpackRow(0, cur);
+
+    for (int r = 0; r < rows_; ++r) {
+        unpackRow(r + 1, down);
+
+        const uint8_t* u = up.data();
+        const uint8_t* m = cur.data();
+        const uint8_t* d = down.data();
+        uint8_t* out = rowMajor ? neighborMasks_.data() + Index(r, 0) : rowMasks.data();
+
+        // Branch-free over contiguous rows so the compiler can vectorise it;
+        // bit order follows NEIGHBOR_DROW/DCOL
+        for (int c = 0; c < cols_; ++c) {
+            uint8_t bits = static_cast<uint8_t>(
+                  (u[c]     << 0) | (u[c + 1] << 1) | (u[c + 2] << 2)
+                | (m[c]     << 3) |                     (m[c + 2] << 4)
+                | (d[c]     << 5) | (d[c + 1] << 6) | (d[c + 2] << 7));
+            out[c] = static_cast<uint8_t>(bits * m[c + 1]);
+        }
+        if (!rowMajor) {
+            for (int c = 0; c < cols_; ++c) {
+                neighborMasks_[Index(r, c)] = out[c];
+            }
+        }
+
+        std::swap(up, cur);
+        std::swap(cur, down);
+    }
+}
+
+uint8_t NavigableGrid::ComputeNeighborMask(int row, int col) const {
+    if (!IsNavigable(row, col)) {
+        return 0;
+    }
+    uint8_t mask = 0;
+    for (int i = 0; i < 8; ++i) {
+        GridCoordinate n = Neighbor(row, col, i);
+        if (IsNavigable(n.row, n.col)) {
+            mask |= static_cast<uint8_t>(1u << i);
+        }
+    }
+    return mask;
+}
+
+void NavigableGrid::UpdateNeighborMasks(int row, int col) {
+    neighborMasks_[Index(row, col)] = ComputeNeighborMask(row, col);
+    if (IsEqualDistance()) {
+        // Cells of the adjacent rows whose longitude span overlaps (col - 1 .. col + 1)
+        double left = (col - 1) * mapper_.RowCellSizeLon(row);
+        double right = (col + 2) * mapper_.RowCellSizeLon(row);
+        for (int r = row - 1; r <= row + 1; ++r) {
+            if (r < 0 || r >= rows_) continue;
+            double width = mapper_.RowCellSizeLon(r);
+            int first = static_cast<int>(std::floor(left / width)) - 1;
+            int last = static_cast<int>(std::floor(right / width)) + 1;
+            for (int c = std::max(0, first); c <= std::min(last, cols_ - 1); ++c) {
+                if (r != row || c != col) {
+                    neighborMasks_[Index(r, c)] = ComputeNeighborMask(r, c);
+                }
+            }
+        }
+        return;
+    }
+    for (int i = 0; i < 8; ++i) {
+        int r = row + NEIGHBOR_DROW[i];
+        int c = col + NEIGHBOR_DCOL[i];
+        if (IsValid(r, c)) {
+            neighborMasks_[Index(r, c)] = ComputeNeighborMask(r, c);
+        }
+    }
+}
+
+// ===== Distance Fields =====
+namespace {
+
+    // Exact nearest-feature transform (Felzenszwalb & Huttenlocher, separable).
+    // Pass 1 finds the nearest feature row per column, pass 2 takes the lower
+    // envelope of the parabolas (rowKm * dy)^2 + (colKm * (c - q))^2 per row.
+    // O(rows * cols); out[i] = index of the nearest feature cell or -1.
+    void NearestFeatureTransform(
+        const std::vector<uint8_t>& isFeature,
+        int rows, int cols,
+        double rowKm, double colKm,
+        std::vector<int32_t>& out)
+    {
+        const double INF = std::numeric_limits<double>::infinity();
+        size_t count = static_cast<size_t>(rows) * static_cast<size_t>(cols);
+        std::vector<int32_t> featureRow(count, -1);
+
+        // Pass 1: nearest feature row in each column (two sweeps)
+        for (int c = 0; c < cols; ++c) {
+            int last = -1;
+            for (int r = 0; r < rows; ++r) {
+                size_t idx = static_cast<size_t>(r) * cols + c;
+                if (isFeature[idx]) last = r;
+                featureRow[idx] = last;
+            }
+            last = -1;
+            for (int r = rows - 1; r >= 0; --r) {
+                size_t idx = static_cast<size_t>(r) * cols + c;
+                if (isFeature[idx]) last = r;
+                if (last >= 0 && (featureRow[idx] < 0 || last - r < r - featureRow[idx])) {
+                    featureRow[idx] = last;
+                }
+            }
+        }
+
+        // Pass 2: lower envelope along each row
+        const double wx = colKm * colKm;
+        std::vector<double> f(cols);
+        std::vector<int> v(cols);          // Parabola sites in the envelope
+        std::vector<double> z(cols + 1);   // Envelope breakpoints
+        out.assign(count, -1);
+
+        for (int r = 0; r < rows; ++r) {
+            size_t base = static_cast<size_t>(r) * cols;
+            for (int c = 0; c < cols; ++c) {
+                int fr = featureRow[base + c];
+                double dy = (fr - r) * rowKm;
+                f[c] = fr >= 0 ? dy * dy : INF;
+            }
+
+            int k = -1;
+            for (int q = 0; q < cols; ++q) {
+                if (f[q] == INF) continue;
+                double s = -INF;
+                while (k >= 0) {
+                    int p = v[k];
+                    s = ((f[q] + wx * q * q) - (f[p] + wx * p * p)) / (2.0 * wx * (q - p));
+                    if (s > z[k]) break;
+                    --k;
+                }
+                ++k;
+                v[k] = q;
+                z[k] = (k == 0) ? -INF : s;
+                z[k + 1] = INF;
+            }
+            if (k < 0) continue;   // No feature anywhere in the grid
+
+            int j = 0;
+            for (int c = 0; c < cols; ++c) {
+                while (z[j + 1] < c) ++j;
+                int q = v[j];
+                out[base + c] = static_cast<int32_t>(static_cast<size_t>(featureRow[base + q]) * cols + q);
+            }
+        }
+    }
+
+}  // namespace
+
+void NavigableGrid::BuildDistanceFields() {
+    ClearDistanceFields();
+    if (tiles_ || IsEqualDistance()) {
+        return;   // Tiled: would load every tile; equal-distance: cells are not
+                  // a uniform lattice. Snapping falls back to its local search.
+    }
+    size_t count = static_cast<size_t>(rows_) * static_cast<size_t>(cols_);
+    if (count == 0) {
+        return;
+    }
+
+    SetFieldCellKm();
+
+    // Fields are row-major in every layout (snapping only, not on the search path)
+    std::vector<uint8_t> navigable(count);
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            navigable[RowMajorIndex(r, c)] = static_cast<uint8_t>(IsNavigableUnchecked(r, c));
+        }
+    }
+    NearestFeatureTransform(navigable, rows_, cols_, rowKm_, colKm_, nearestNavigable_);
+
+    for (auto& n : navigable) n ^= 1u;
+    NearestFeatureTransform(navigable, rows_, cols_, rowKm_, colKm_, nearestCoast_);
+}
+
+void NavigableGrid::SetFieldCellKm() {
+    // Local flat-earth cell size at the grid's mid-latitude
+    const double kmPerDeg = 6371.0 * PI / 180.0;
+    double midLat = (geoBounds_.minLat + geoBounds_.maxLat) / 2.0;
+    rowKm_ = cellSizeLat_ * kmPerDeg;
+    colKm_ = std::max(1e-6, cellSizeLon_ * kmPerDeg * std::cos(midLat * PI / 180.0));
+}
+
+void NavigableGrid::ClearDistanceFields() {
+    nearestNavigable_.clear();
+    nearestNavigable_.shrink_to_fit();
+    nearestCoast_.clear();
+    nearestCoast_.shrink_to_fit();
+    view_.nearestNavigable = nullptr;
+    view_.nearestCoast = nullptr;
+}
+
+GridCoordinate NavigableGrid::LookupNearest(const int32_t* field, int row, int col) const {
+    if (!field || !IsValid(row, col)) {
+        return GridCoordinate(-1, -1);
+    }
+    int32_t idx = field[RowMajorIndex(row, col)];
+    if (idx < 0) {
+        return GridCoordinate(-1, -1);
+    }
+    return GridCoordinate(idx / cols_, idx % cols_);
+}
+
+double NavigableGrid::DistanceKm(const int32_t* field, int row, int col) const {
+    GridCoordinate nearest = LookupNearest(field, row, col);
+    if (nearest.row < 0) {
+        return -1.0;
+    }
+    double dy = (nearest.row - row) * rowKm_;
+    double dx = (nearest.col - col) * colKm_;
+    return std::sqrt(dy * dy + dx * dx);
+}
+
+GridCoordinate NavigableGrid::NearestNavigableCell(int row, int col) const {
+    return LookupNearest(NearestNavigableField(), row, col);
+}
+
+GridCoordinate NavigableGrid::NearestCoastCell(int row, int col) const {
+    return LookupNearest(NearestCoastField(), row, col);
+}
+
+double NavigableGrid::DistanceToNavigableKm(int row, int col) const {
+    return DistanceKm(NearestNavigableField(), row, col);
+}
+
+double NavigableGrid::DistanceFromCoastKm(int row, int col) const {
+    return DistanceKm(NearestCoastField(), row, col);
+}
+
+// ===== Connected Components =====
+namespace {
+
+    // Union-find over cell indices; roots are the smallest index of their set
+    int32_t FindRoot(std::vector<int32_t>& parent, int32_t x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];   // Path halving
+            x = parent[x];
+        }
+        return x;
+    }
+
+    void Unite(std::vector<int32_t>& parent, int32_t a, int32_t b) {
+        a = FindRoot(parent, a);
+        b = FindRoot(parent, b);
+        if (a < b)      parent[b] = a;
+        else if (b < a) parent[a] = b;
+    }
+
+}  // namespace
+
+void NavigableGrid::BuildComponents(int numThreads) {
+    ClearComponents();
+    size_t count = CellIndexCount();
+    if (tiles_ || count == 0) {
+        return;
+    }
+    if (count > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+        std::cerr << "[NavigableGrid] Grid too large for component labelling" << std::endl;
+        return;
+    }
+
+    if (numThreads <= 0) {
+        numThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    const int MIN_ROWS_PER_STRIP = 64;
+    int strips = std::max(1, std::min(numThreads, rows_ / MIN_ROWS_PER_STRIP));
+    // Strip boundaries on multiples of 8 rows: no shared blocks in BLOCKED_8X8
+    auto stripRow = [&](int s) {
+        return (s >= strips) ? rows_
+            : static_cast<int>(static_cast<long long>(rows_) * s / strips) & ~7;
+    };
+
+    // Regular grids have a symmetric neighbour relation, so the backward
+    // neighbours (bits 0-3: previous row and left) cover every edge once.
+    // Equal-distance grids may link a -> b without b -> a: take all eight.
+    const uint8_t dirMask = IsEqualDistance() ? 0xFF : 0x0F;
+    std::vector<int32_t> parent(count, -1);   // -1: not navigable / block padding
+
+    // 1. Strips of rows in parallel: only edges inside the strip, so every
+    //    thread reads and writes its own index range
+    auto labelStrip = [&](int s) {
+        int firstRow = stripRow(s);
+        int endRow = stripRow(s + 1);
+        for (int r = firstRow; r < endRow; ++r) {
+            for (int c = 0; c < cols_; ++c) {
+                int32_t idx = static_cast<int32_t>(Index(r, c));
+                parent[idx] = IsNavigableUnchecked(r, c) ? idx : -1;
+            }
+        }
+        for (int r = firstRow; r < endRow; ++r) {
+            for (int c = 0; c < cols_; ++c) {
+                uint8_t neighbors = NeighborMask(r, c) & dirMask;
+                for (int i = 0; neighbors; ++i, neighbors >>= 1) {
+                    if (!(neighbors & 1u)) continue;
+                    GridCoordinate n = Neighbor(r, c, i);
+                    if (n.row < firstRow || n.row >= endRow) continue;
+                    Unite(parent, static_cast<int32_t>(Index(r, c)),
+                        static_cast<int32_t>(Index(n.row, n.col)));
+                }
+            }
+        }
+    };
+
+    if (strips == 1) {
+        labelStrip(0);
+    } else {
+        std::vector<std::thread> workers;
+        workers.reserve(strips);
+        for (int s = 0; s < strips; ++s) {
+            workers.emplace_back(labelStrip, s);
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+    }
+
+    // 2. Seams between strips (one row pair each), sequential
+    for (int s = 1; s < strips; ++s) {
+        int seam = stripRow(s);
+        for (int r = seam - 1; r <= seam; ++r) {
+            for (int c = 0; c < cols_; ++c) {
+                uint8_t neighbors = NeighborMask(r, c);
+                for (int i = 0; neighbors; ++i, neighbors >>= 1) {
+                    if (!(neighbors & 1u)) continue;
+                    GridCoordinate n = Neighbor(r, c, i);
+                    if (n.row != (r == seam ? seam - 1 : seam)) continue;
+                    Unite(parent, static_cast<int32_t>(Index(r, c)),
+                        static_cast<int32_t>(Index(n.row, n.col)));
+                }
+            }
+        }
+    }
+
+    // 3. Dense ids in scan order. A root is the smallest index of its set,
+    //    so it is numbered before any other member is reached.
+    components_.assign(count, -1);
+    for (size_t i = 0; i < count; ++i) {
+        if (parent[i] < 0) {
+            continue;
+        }
+        int32_t root = FindRoot(parent, static_cast<int32_t>(i));
+        if (root == static_cast<int32_t>(i)) {
+            components_[i] = static_cast<int32_t>(componentSizes_.size());
+            componentSizes_.push_back(0);
+        } else {
+            components_[i] = components_[root];
+        }
+        ++componentSizes_[components_[i]];
+    }
+}
+
+void NavigableGrid::ClearComponents() {
+    components_.clear();
+    components_.shrink_to_fit();
+    componentSizes_.clear();
+}
+
+// ===== Depth Layer =====
+void NavigableGrid::SetDepths(const std::vector<float>& depthsM) {
+    size_t count = static_cast<size_t>(rows_) * static_cast<size_t>(cols_);
+    if (depthsM.size() != count) {
+        throw std::invalid_argument("NavigableGrid::SetDepths: expected Rows() x Cols() depths");
+    }
+    view_.depthDm = nullptr;
+    depthDm_.assign(CellIndexCount(), 0);
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            float dm = std::clamp(depthsM[RowMajorIndex(r, c)] * 10.0f,
+                static_cast<float>(std::numeric_limits<int16_t>::min()),
+                static_cast<float>(std::numeric_limits<int16_t>::max()));
+            depthDm_[Index(r, c)] = static_cast<int16_t>(std::lround(dm));
+        }
+    }
+}
+
+void NavigableGrid::ClearDepths() {
+    depthDm_.clear();
+    depthDm_.shrink_to_fit();
+    view_.depthDm = nullptr;
+}
+
+void NavigableGrid::ApplyDepthThreshold(double minDepthM) {
+    const int16_t* depths = DepthWords();
+    if (!depths || tiles_) {
+        return;
+    }
+    if (IsReadOnly()) {
+        throw std::logic_error("NavigableGrid: read-only grid");
+    }
+
+    bool hadMasks = !neighborMasks_.empty();
+    bool hadFields = !nearestNavigable_.empty();
+    bool hadComponents = !components_.empty();
+    neighborMasks_.clear();   // Rebuilt once below instead of per edit
+    ClearDistanceFields();
+    ClearComponents();
+
+    // Navigable iff depth <= -minDepthM, compared in decimetres
+    const double limitDm = -minDepthM * 10.0;
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            size_t idx = Index(r, c);
+            CellType type = LoadCell(idx);
+            if (type != CellType::SHALLOW && type != CellType::NAVIGABLE) {
+                continue;
+            }
+            SetCellType(r, c, depths[idx] <= limitDm ? CellType::NAVIGABLE : CellType::SHALLOW);
+        }
+    }
+
+    if (hadMasks) BuildNeighborMasks();
+    if (hadFields) BuildDistanceFields();
+    if (hadComponents) BuildComponents();
+}
+
+void NavigableGrid::SetStorage(GridStorage storage) {
+    if (storage == storage_ || tiles_) {
+        return;
+    }
+    if (IsReadOnly()) {
+        throw std::logic_error("NavigableGrid: read-only grid");
+    }
+
+    size_t count = CellIndexCount();
+    std::vector<uint8_t> types(count);
+    for (size_t i = 0; i < count; ++i) {
+        types[i] = static_cast<uint8_t>(LoadCell(i));
+    }
+
+    storage_ = storage;
+    cells_.assign(storage_ == GridStorage::BYTE ? count : (count + 3) / 4, 0);
+    for (size_t i = 0; i < count; ++i) {
+        StoreCell(i, static_cast<CellType>(types[i]));
+    }
+}
+
+void NavigableGrid::SetLayout(CellLayout layout) {
+    if (layout == layout_ || tiles_) {
+        return;
+    }
+    if (IsReadOnly()) {
+        throw std::logic_error("NavigableGrid: read-only grid");
+    }
+
+    // Row-major copies of the layout-dependent layers
+    size_t count = static_cast<size_t>(rows_) * static_cast<size_t>(cols_);
+    std::vector<uint8_t> types(count);
+    std::vector<int16_t> depths(depthDm_.empty() ? 0 : count);
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            types[RowMajorIndex(r, c)] = static_cast<uint8_t>(LoadCell(Index(r, c)));
+            if (!depths.empty()) depths[RowMajorIndex(r, c)] = depthDm_[Index(r, c)];
+        }
+    }
+    bool hadMasks = !neighborMasks_.empty();
+    bool hadComponents = !components_.empty();
+    std::vector<int32_t> nearestNavigable = std::move(nearestNavigable_);   // Row-major in any layout
+    std::vector<int32_t> nearestCoast = std::move(nearestCoast_);
+
+    layout_ = layout;
+    Allocate();
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            SetCellType(r, c, static_cast<CellType>(types[RowMajorIndex(r, c)]));
+        }
+    }
+    if (!depths.empty()) {
+        depthDm_.assign(CellIndexCount(), 0);
+        for (int r = 0; r < rows_; ++r) {
+            for (int c = 0; c < cols_; ++c) {
+                depthDm_[Index(r, c)] = depths[RowMajorIndex(r, c)];
+            }
+        }
+    }
+    nearestNavigable_ = std::move(nearestNavigable);
+    nearestCoast_ = std::move(nearestCoast);
+    if (hadMasks) BuildNeighborMasks();
+    if (hadComponents) BuildComponents();
+}
+
+size_t NavigableGrid::CellIndexCount() const {
+    if (layout_ == CellLayout::BLOCKED_8X8) {
+        return static_cast<size_t>((std::max(0, rows_) + 7) / 8) * static_cast<size_t>(blockCols_) * 64;
+    }
+    return static_cast<size_t>(std::max(0, rows_)) * static_cast<size_t>(std::max(0, cols_));
+}
+
+GridCoordinate NavigableGrid::CellAt(size_t index) const {
+    if (layout_ == CellLayout::BLOCKED_8X8) {
+        size_t block = index >> 6;
+        int row = static_cast<int>((block / blockCols_) * 8 + ((index >> 3) & 7));
+        int col = static_cast<int>((block % blockCols_) * 8 + (index & 7));
+        return GridCoordinate(row, col);
+    }
+    return GridCoordinate(static_cast<int>(index / cols_), static_cast<int>(index % cols_));
+}
+
+size_t NavigableGrid::MemoryBytes() const {
+    return cells_.size() * sizeof(uint8_t) + navBits_.size() * sizeof(uint64_t)
+        + neighborMasks_.size() * sizeof(uint8_t)
+        + (nearestNavigable_.size() + nearestCoast_.size()) * sizeof(int32_t)
+        + depthDm_.size() * sizeof(int16_t)
+        + components_.size() * sizeof(int32_t) + componentSizes_.size() * sizeof(size_t)
+        + (tiles_ ? tiles_->Bytes() : 0);
+}
+
+std::vector<std::vector<CellType>> NavigableGrid::ToRows() const {
+    std::vector<std::vector<CellType>> rows(rows_, std::vector<CellType>(cols_));
+    for (int r = 0; r < rows_; ++r) {
+        for (int c = 0; c < cols_; ++c) {
+            rows[r][c] = GetCellType(r, c);
+        }
+    }
+    return rows;
+}
+
+void NavigableGrid::FromRows(const std::vector<std::vector<CellType>>& rows) {
+    int numRows = std::min(rows_, static_cast<int>(rows.size()));
+    for (int r = 0; r < numRows; ++r) {
+        int numCols = std::min(cols_, static_cast<int>(rows[r].size()));
+        for (int c = 0; c < numCols; ++c) {
+            SetCellType(r, c, rows[r][c]);
+        }
+    }
 }
 
 GridCoordinate NavigableGrid::GeoToGrid(const GeoCoordinate& geo) const {
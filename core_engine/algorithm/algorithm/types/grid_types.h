@@ -4,6 +4,9 @@
 #include <vector>
 #include <cstdint>
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <stdexcept>
 
 // ===== Cell Type Definition =====
 enum class CellType : uint8_t {
@@ -13,7 +16,17 @@ enum class CellType : uint8_t {
     NAVIGABLE = 3
 };
 
+// ===== 8-Neighbour Order =====
+// Bit i of a neighbour mask refers to (row + NEIGHBOR_DROW[i], col + NEIGHBOR_DCOL[i])
+constexpr int NEIGHBOR_DROW[8] = { -1, -1, -1,  0,  0,  1,  1,  1 };
+constexpr int NEIGHBOR_DCOL[8] = { -1,  0,  1, -1,  1, -1,  0,  1 };
+
 // ===== Geo-Grid Coordinate Mapper =====
+// Regular layout: every row has cols cells of CellSizeLon() degrees.
+// Equal-distance layout (SetRowLayout): row r has RowCols(r) <= cols cells of
+// RowCellSizeLon(r) degrees, so cell widths stay close to the requested km
+// size at every latitude. Columns of all rows start at bounds.minLon; cells
+// beyond RowCols(r) are padding.
 class GeoIndexMapper {
 public:
     GeoIndexMapper()
@@ -34,21 +47,52 @@ public:
 
         cellSizeLat_ = bounds_.Height() / static_cast<double>(rows_);
         cellSizeLon_ = bounds_.Width() / static_cast<double>(cols_);
+        rowCols_.clear();
+        rowCellSizeLon_.clear();
+    }
+
+    // Switches to the equal-distance layout; rowCols has one entry per row,
+    // each in [1, cols]. An empty vector restores the regular layout.
+    void SetRowLayout(const std::vector<int>& rowCols);
+
+    bool IsEqualDistance() const { return !rowCols_.empty(); }
+
+    int RowCols(int row) const {
+        return rowCols_.empty() ? cols_ : rowCols_[ClampRow(row)];
     }
 
+    double RowCellSizeLon(int row) const {
+        return rowCols_.empty() ? cellSizeLon_ : rowCellSizeLon_[ClampRow(row)];
+    }
+
+    // Column of toRow whose longitude span contains the centre of (row, col);
+    // col itself on regular grids
+    int NeighborCol(int row, int col, int toRow) const {
+        if (rowCols_.empty() || row == toRow) {
+            return col;
+        }
+        int to = ClampRow(toRow);
+        double lon = (col + 0.5) * rowCellSizeLon_[ClampRow(row)];
+        int c = static_cast<int>(lon / rowCellSizeLon_[to]);
+        return std::clamp(c, 0, rowCols_[to] - 1);
+    }
+
+    // Longitudes are wrapped to the bounds (grids may span the antimeridian);
+    // GridToGeo returns the continuous longitude, which may exceed 180
     GridCoordinate GeoToGrid(const GeoCoordinate& geo) const {
+        double lon = bounds_.UnwrapLongitude(geo.longitude);
         int row = static_cast<int>((bounds_.maxLat - geo.latitude) / cellSizeLat_);
-        int col = static_cast<int>((geo.longitude - bounds_.minLon) / cellSizeLon_);
-
         row = std::clamp(row, 0, rows_ - 1);
-        col = std::clamp(col, 0, cols_ - 1);
+
+        int col = static_cast<int>((lon - bounds_.minLon) / RowCellSizeLon(row));
+        col = std::clamp(col, 0, RowCols(row) - 1);
 
         return GridCoordinate(row, col);
     }
 
     GeoCoordinate GridToGeo(const GridCoordinate& idx) const {
         double lat = bounds_.maxLat - (idx.row + 0.5) * cellSizeLat_;
-        double lon = bounds_.minLon + (idx.col + 0.5) * cellSizeLon_;
+        double lon = bounds_.minLon + (idx.col + 0.5) * RowCellSizeLon(idx.row);
         return GeoCoordinate(lat, lon);
     }
 
@@ -64,6 +108,10 @@ private:
     int cols_;
     double cellSizeLat_;
     double cellSizeLon_;
+    std::vector<int> rowCols_;           // Equal-distance layout only
+    std::vector<double> rowCellSizeLon_;
+
+    int ClampRow(int row) const { return std::clamp(row, 0, rows_ - 1); }
 };
 
 // ===== Grid Resolution Helper =====
@@ -72,36 +120,258 @@ namespace GEBCOConstants {
 }
 
 struct GridResolution {
+    static constexpr int MAX_GRID_SIZE = 9000;   // Rows/cols of a flat grid
+
     double cellSizeKm;
     int blockLat;
     int blockLon;
     int rows;
     int cols;
+    std::vector<int> rowBlockLon;   // Equal-distance only: GEBCO pixels per cell, per row
+    std::vector<int> rowCols;       // Equal-distance only: cells per row (cols = max)
 
     static std::pair<int, int> CalculateBlockSize(
         const BoundingBox& roi,
         double targetCellSizeKm);
 
+    // Equal-distance variant: blockLon is chosen per row from the row's
+    // centre latitude instead of the ROI's average latitude
+    static GridResolution CalculateEqualDistance(
+        const BoundingBox& roi,
+        int srcHeight, int srcWidth,
+        double targetCellSizeKm);
+
     static GridResolution Calculate(
         const BoundingBox& roi,
         int srcHeight, int srcWidth,
         double targetCellSizeKm);
 };
 
+// ===== Cell Storage Mode =====
+enum class GridStorage : uint8_t {
+    BYTE = 0,         // 1 byte per cell (fastest GetCellType)
+    PACKED_2BIT = 1   // 4 cells per byte (CellType fits in 2 bits)
+};
+
+// ===== Cell Layout =====
+// Order of cells in the grid's layers. BLOCKED_8X8 stores 8x8 cell blocks
+// contiguously (blocks row-major, cells row-major inside a block), so the
+// 3x3 neighbourhood of a cell mostly lies in one 64-byte line of the cell
+// and mask layers and in one navigability word. Pays off on wide grids,
+// where a north/south step in row-major order is a cache miss.
+enum class CellLayout : uint8_t {
+    ROW_MAJOR = 0,
+    BLOCKED_8X8 = 1
+};
+
+// ===== Lazily Loaded Tiles =====
+// Fills one tile: tileRows x tileCols CellType bytes, row-major, starting at
+// (firstRow, firstCol) of the grid. Called on first access to the tile.
+using GridTileLoader = std::function<void(
+    int firstRow, int firstCol, int tileRows, int tileCols,
+    std::vector<uint8_t>& cells)>;
+
+class GridTileCache;
+
+// ===== Externally Owned Layers (read-only grids) =====
+// Row-major layers laid out like NavigableGrid's own (BYTE cells, 64-bit
+// navigability words), e.g. pointing into a memory-mapped grid file.
+// owner keeps the memory alive; the optional layers may be null.
+struct GridLayerView {
+    std::shared_ptr<const void> owner;
+    const uint8_t* cells = nullptr;
+    const uint64_t* navBits = nullptr;
+    const uint8_t* neighborMasks = nullptr;
+    const int32_t* nearestNavigable = nullptr;
+    const int32_t* nearestCoast = nullptr;
+    const int16_t* depthDm = nullptr;
+};
+
 // ===== Navigable Grid (Pure Data Container) =====
+// Cells live in one contiguous row-major buffer (byte or 2-bit packed),
+// plus a 1-bit navigability bitset used by IsNavigable().
+// A tiled grid (NavigableGrid::Tiled) instead loads fixed-size tiles on
+// first access and evicts them LRU under a memory budget.
+// A read-only grid (NavigableGrid::ReadOnly) reads external layers in place.
 class NavigableGrid {
 public:
     NavigableGrid();
-    NavigableGrid(const BoundingBox& bounds, int rows, int cols);
+    NavigableGrid(const BoundingBox& bounds, int rows, int cols,
+        GridStorage storage = GridStorage::BYTE);
+
+    // Tiled grid without a full cell buffer. Copies share the tile cache;
+    // tiles edited through SetCellType are never evicted.
+    static NavigableGrid Tiled(const BoundingBox& bounds, int rows, int cols,
+        int tileSize, size_t memoryBudgetBytes, GridTileLoader loader);
+    bool IsTiled() const { return tiles_ != nullptr; }
+
+    // Read-only grid over external layers (zero copy); copies share them.
+    // Cell edits throw std::logic_error until MakeWritable() copies the
+    // layers into owned storage. Masks/fields may still be (re)built.
+    static NavigableGrid ReadOnly(const BoundingBox& bounds, int rows, int cols,
+        GridLayerView layers, const std::vector<int>& rowCols = {});
+    bool IsReadOnly() const { return view_.cells != nullptr; }
+    void MakeWritable();
 
     void Reset(const BoundingBox& bounds, int rows, int cols);
 
+    // Equal-distance layout (GeoIndexMapper::SetRowLayout). Cells beyond
+    // RowCols(row) stay UNKNOWN. Drops the neighbour masks, distance fields and
+    // components.
+    void SetRowLayout(const std::vector<int>& rowCols);   // Throws on read-only grids
+    bool IsEqualDistance() const { return mapper_.IsEqualDistance(); }
+    int RowCols(int row) const { return mapper_.RowCols(row); }
+
+    // Cell reached from (row, col) in neighbour direction i. On equal-distance
+    // grids the column is taken relative to the cell of the target row that
+    // lies directly above/below (row, col); the result may be invalid.
+    GridCoordinate Neighbor(int row, int col, int i) const {
+        int toRow = row + NEIGHBOR_DROW[i];
+        return GridCoordinate(toRow, mapper_.NeighborCol(row, col, toRow) + NEIGHBOR_DCOL[i]);
+    }
+
+    // Column step from `from` to `to` in the same sense as NEIGHBOR_DCOL
+    // (raw index difference on regular grids)
+    int ColumnStep(const GridCoordinate& from, const GridCoordinate& to) const {
+        return to.col - mapper_.NeighborCol(from.row, from.col, to.row);
+    }
+
     // Cell type access
-    CellType GetCellType(int row, int col) const;
-    void SetCellType(int row, int col, CellType type);
-    bool IsNavigable(int row, int col) const;
-    bool IsValid(int row, int col) const;
-    bool IsValid(const GridCoordinate& pos) const;
+    CellType GetCellType(int row, int col) const {
+        if (!IsValid(row, col)) return CellType::UNKNOWN;
+        if (tiles_) return TiledCell(row, col);
+        return LoadCell(Index(row, col));
+    }
+
+    void SetCellType(int row, int col, CellType type) {
+        if (!IsValid(row, col)) return;
+        if (IsReadOnly()) throw std::logic_error("NavigableGrid: read-only grid");
+        if (tiles_) {
+            StoreTiledCell(row, col, type);
+            return;
+        }
+        size_t idx = Index(row, col);
+        StoreCell(idx, type);
+        uint64_t bit = uint64_t(1) << (idx & 63);
+        bool wasNavigable = (navBits_[idx >> 6] & bit) != 0;
+        if (type == CellType::NAVIGABLE) navBits_[idx >> 6] |= bit;
+        else                             navBits_[idx >> 6] &= ~bit;
+        if (wasNavigable != (type == CellType::NAVIGABLE)) {
+            if (!neighborMasks_.empty()) UpdateNeighborMasks(row, col);
+            if (!nearestNavigable_.empty()) ClearDistanceFields();  // Stale after an edit
+            if (!components_.empty()) ClearComponents();
+        }
+    }
+
+    bool IsNavigable(int row, int col) const {
+        return IsValid(row, col) && IsNavigableUnchecked(row, col);
+    }
+
+    // Caller guarantees IsValid(row, col)
+    bool IsNavigableUnchecked(int row, int col) const {
+        if (tiles_) return TiledCell(row, col) == CellType::NAVIGABLE;
+        size_t idx = Index(row, col);
+        return (NavWords()[idx >> 6] >> (idx & 63)) & 1u;
+    }
+
+    bool IsValid(int row, int col) const {
+        return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+    }
+
+    bool IsValid(const GridCoordinate& pos) const {
+        return IsValid(pos.row, pos.col);
+    }
+
+    // Neighbour masks: bit i set = neighbour i (NEIGHBOR_DROW/DCOL) is navigable.
+    // Zero for non-navigable cells. Without a built layer the mask is computed
+    // on the fly from the navigability bits. Tiled grids never build the layer.
+    void BuildNeighborMasks();
+    bool HasNeighborMasks() const { return MaskBytes() != nullptr; }
+
+    // Caller guarantees IsValid(row, col)
+    uint8_t NeighborMask(int row, int col) const {
+        if (const uint8_t* masks = MaskBytes()) {
+            return masks[Index(row, col)];
+        }
+        return ComputeNeighborMask(row, col);
+    }
+
+    // Distance fields: exact Euclidean nearest-feature transform (cell centres,
+    // cell sizes in km at the grid's mid-latitude), built once per grid.
+    // - nearest navigable cell for every cell (snapping)
+    // - nearest non-navigable cell for every cell (distance from coast)
+    void BuildDistanceFields();
+    bool HasDistanceFields() const { return NearestNavigableField() != nullptr; }
+    void ClearDistanceFields();
+
+    // (-1, -1) if the layer is not built, the cell is invalid or the grid has no such cell
+    GridCoordinate NearestNavigableCell(int row, int col) const;
+    GridCoordinate NearestCoastCell(int row, int col) const;
+
+    // Km between cell centres; 0 on navigable / non-navigable cells respectively,
+    // negative if the layer is not built or no such cell exists
+    double DistanceToNavigableKm(int row, int col) const;
+    double DistanceFromCoastKm(int row, int col) const;
+
+    // Connected components of the navigable cells (8-connectivity through
+    // Neighbor()), labelled with a parallel union-find over row strips.
+    // Cells in different components can never be joined by a search, so a
+    // leg between them is rejected without expanding any node.
+    // numThreads <= 0 uses all hardware threads. Tiled grids never build it.
+    void BuildComponents(int numThreads = 0);
+    bool HasComponents() const { return !components_.empty(); }
+    void ClearComponents();
+    int ComponentCount() const { return static_cast<int>(componentSizes_.size()); }
+
+    // Component id in [0, ComponentCount()); -1 for non-navigable/invalid
+    // cells or without the layer
+    int32_t ComponentOf(int row, int col) const {
+        if (components_.empty() || !IsValid(row, col)) return -1;
+        return components_[Index(row, col)];
+    }
+    // Navigable cells in the component (0 for an unknown id)
+    size_t ComponentSize(int32_t id) const {
+        return (id >= 0 && id < ComponentCount()) ? componentSizes_[id] : 0;
+    }
+
+    // Depth layer: per-cell depth in int16 decimetres (GEBCO sign, negative
+    // below sea level; deeper than -3276.8 m is clamped, which never matters
+    // for a draft). Lets one grid serve ships of different drafts.
+    void SetDepths(const std::vector<float>& depthsM);   // Rows() x Cols(), row-major, m
+    bool HasDepths() const { return DepthWords() != nullptr; }
+    void ClearDepths();
+
+    // Metres; 0 without a layer or outside the grid
+    float DepthM(int row, int col) const {
+        const int16_t* depths = DepthWords();
+        if (!depths || !IsValid(row, col)) return 0.0f;
+        return depths[Index(row, col)] * 0.1f;
+    }
+
+    // Reclassifies SHALLOW/NAVIGABLE cells from the depth layer: NAVIGABLE
+    // where the water is at least minDepthM deep (draft + under-keel
+    // clearance), SHALLOW otherwise. LAND (GEBCO or coastline) and UNKNOWN
+    // cells are kept. Rebuilds the search layers that were built.
+    // No-op without a depth layer; throws on read-only grids.
+    void ApplyDepthThreshold(double minDepthM);
+
+    // Storage
+    GridStorage Storage() const { return storage_; }
+    void SetStorage(GridStorage storage);   // Repacks existing cells
+
+    // Layout: repacks every owned layer (no-op on tiled grids, throws on
+    // read-only grids, which are always ROW_MAJOR). Cell indices below follow
+    // the layout; search engines key their per-cell state with them.
+    CellLayout Layout() const { return layout_; }
+    void SetLayout(CellLayout layout);
+
+    // Dense cell index in [0, CellIndexCount()); BLOCKED_8X8 pads the grid to
+    // whole blocks, so some indices map to no cell. Caller guarantees IsValid.
+    size_t CellIndex(int row, int col) const { return Index(row, col); }
+    size_t CellIndex(const GridCoordinate& pos) const { return Index(pos.row, pos.col); }
+    size_t CellIndexCount() const;
+    GridCoordinate CellAt(size_t index) const;
+    size_t MemoryBytes() const;             // Owned layers only (not mapped ones)
 
     // Coordinate conversion
     GridCoordinate GeoToGrid(const GeoCoordinate& geo) const;
@@ -117,9 +387,23 @@ public:
     double CellSizeLat() const { return cellSizeLat_; }
     double CellSizeLon() const { return cellSizeLon_; }
 
-    // Direct grid access (for builder)
-    std::vector<std::vector<CellType>>& GetGridData() { return grid_; }
-    const std::vector<std::vector<CellType>>& GetGridData() const { return grid_; }
+    // Bulk access
+    // Row-major cell buffer (flat BYTE storage, ROW_MAJOR layout only, nullptr otherwise)
+    const uint8_t* Data() const {
+        return (storage_ == GridStorage::BYTE && layout_ == CellLayout::ROW_MAJOR && !tiles_)
+            ? CellBytes() : nullptr;
+    }
+    // 1 bit per cell in 64-bit words, (Rows * Cols + 63) / 64 words
+    // (ROW_MAJOR layout only, nullptr otherwise or when tiled)
+    const uint64_t* NavigabilityBits() const {
+        return (layout_ == CellLayout::ROW_MAJOR && !tiles_) ? NavWords() : nullptr;
+    }
+    std::vector<std::vector<CellType>> ToRows() const;
+    void FromRows(const std::vector<std::vector<CellType>>& rows);
+
+    // Legacy nested-vector view; returns a copy (write back with FromRows)
+    [[deprecated("Use GetCellType/Data/ToRows; write back with FromRows")]]
+    std::vector<std::vector<CellType>> GetGridData() const { return ToRows(); }
 
 private:
     BoundingBox geoBounds_;
@@ -128,5 +412,72 @@ private:
     int cols_;
     double cellSizeLat_;
     double cellSizeLon_;
-    std::vector<std::vector<CellType>> grid_;
+    GridStorage storage_;
+    CellLayout layout_ = CellLayout::ROW_MAJOR;
+    int blockCols_ = 0;               // BLOCKED_8X8: blocks per block row
+    std::vector<uint8_t> cells_;      // BYTE: 1 cell/byte, PACKED_2BIT: 4 cells/byte
+    std::vector<uint64_t> navBits_;   // 1 bit per cell, set for NAVIGABLE
+    std::vector<uint8_t> neighborMasks_;  // Optional, 1 byte per cell
+    std::vector<int32_t> nearestNavigable_;  // Optional, cell index (-1 = none)
+    std::vector<int32_t> nearestCoast_;      // Optional, cell index (-1 = none)
+    std::vector<int16_t> depthDm_;           // Optional, decimetres
+    std::vector<int32_t> components_;        // Optional, component id (-1 = not navigable)
+    std::vector<size_t> componentSizes_;
+    double rowKm_ = 0.0;                     // Cell height/width used by the fields
+    double colKm_ = 0.0;
+    std::shared_ptr<GridTileCache> tiles_;   // Tiled grids only
+    GridLayerView view_;                     // Read-only grids only
+
+    const uint8_t* CellBytes() const { return view_.cells ? view_.cells : cells_.data(); }
+    const uint64_t* NavWords() const { return view_.navBits ? view_.navBits : navBits_.data(); }
+    const uint8_t* MaskBytes() const {
+        return !neighborMasks_.empty() ? neighborMasks_.data() : view_.neighborMasks;
+    }
+    const int32_t* NearestNavigableField() const {
+        return !nearestNavigable_.empty() ? nearestNavigable_.data() : view_.nearestNavigable;
+    }
+    const int32_t* NearestCoastField() const {
+        return !nearestCoast_.empty() ? nearestCoast_.data() : view_.nearestCoast;
+    }
+    const int16_t* DepthWords() const {
+        return !depthDm_.empty() ? depthDm_.data() : view_.depthDm;
+    }
+    void SetFieldCellKm();
+
+    size_t Index(int row, int col) const {
+        if (layout_ == CellLayout::BLOCKED_8X8) {
+            size_t block = static_cast<size_t>(row >> 3) * static_cast<size_t>(blockCols_)
+                + static_cast<size_t>(col >> 3);
+            return (block << 6) | (static_cast<size_t>(row & 7) << 3) | static_cast<size_t>(col & 7);
+        }
+        return static_cast<size_t>(row) * static_cast<size_t>(cols_) + static_cast<size_t>(col);
+    }
+    size_t RowMajorIndex(int row, int col) const {
+        return static_cast<size_t>(row) * static_cast<size_t>(cols_) + static_cast<size_t>(col);
+    }
+
+    CellType LoadCell(size_t idx) const {
+        if (storage_ == GridStorage::BYTE) {
+            return static_cast<CellType>(CellBytes()[idx]);
+        }
+        return static_cast<CellType>((cells_[idx >> 2] >> ((idx & 3) * 2)) & 0x3);
+    }
+
+    void StoreCell(size_t idx, CellType type) {
+        if (storage_ == GridStorage::BYTE) {
+            cells_[idx] = static_cast<uint8_t>(type);
+            return;
+        }
+        uint8_t shift = static_cast<uint8_t>((idx & 3) * 2);
+        uint8_t& packed = cells_[idx >> 2];
+        packed = static_cast<uint8_t>((packed & ~(0x3 << shift)) | (static_cast<uint8_t>(type) << shift));
+    }
+
+    void Allocate();
+    CellType TiledCell(int row, int col) const;
+    void StoreTiledCell(int row, int col, CellType type);
+    uint8_t ComputeNeighborMask(int row, int col) const;
+    void UpdateNeighborMasks(int row, int col);
+    GridCoordinate LookupNearest(const int32_t* field, int row, int col) const;
+    double DistanceKm(const int32_t* field, int row, int col) const;
 };
\ No newline at end of file
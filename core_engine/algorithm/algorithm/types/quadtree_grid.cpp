@@ -0,0 +1,196 @@
+#include "quadtree_grid.h"
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+
+QuadtreeGrid::QuadtreeGrid()
+    : rows_(0), cols_(0), rootSize_(0), navigableLeaves_(0)
+{
+}
+
+// ===== Build =====
+QuadtreeGrid QuadtreeGrid::Build(
+    const NavigableGrid& grid,
+    const std::vector<GridCoordinate>& fineCells,
+    int maxLeafSize,
+    int coastMarginCells)
+{
+    if (grid.IsEqualDistance()) {
+        throw std::invalid_argument("QuadtreeGrid::Build: equal-distance grids are not supported");
+    }
+
+    QuadtreeGrid tree;
+    tree.rows_ = grid.Rows();
+    tree.cols_ = grid.Cols();
+    if (tree.rows_ <= 0 || tree.cols_ <= 0) {
+        return tree;
+    }
+
+    tree.rootSize_ = 1;
+    while (tree.rootSize_ < std::max(tree.rows_, tree.cols_)) {
+        tree.rootSize_ *= 2;
+    }
+    int maxLeaf = 1;
+    while (maxLeaf * 2 <= std::max(1, maxLeafSize)) {
+        maxLeaf *= 2;
+    }
+    const int margin = std::max(0, coastMarginCells);
+
+    // Summed-area table of navigable cells: O(1) uniformity test per block
+    const int rows = tree.rows_;
+    const int cols = tree.cols_;
+    const size_t stride = static_cast<size_t>(cols) + 1;
+    std::vector<uint32_t> sat((static_cast<size_t>(rows) + 1) * stride, 0);
+    for (int r = 0; r < rows; ++r) {
+        uint32_t rowSum = 0;
+        for (int c = 0; c < cols; ++c) {
+            rowSum += grid.IsNavigableUnchecked(r, c) ? 1u : 0u;
+            sat[(r + 1) * stride + (c + 1)] = sat[r * stride + (c + 1)] + rowSum;
+        }
+    }
+
+    // Navigable cells and in-grid area of [r0, r1) x [c0, c1)
+    auto clipped = [&](int r0, int c0, int r1, int c1, uint64_t& area) -> uint64_t {
+        r0 = std::max(r0, 0); c0 = std::max(c0, 0);
+        r1 = std::min(r1, rows); c1 = std::min(c1, cols);
+        if (r0 >= r1 || c0 >= c1) {
+            area = 0;
+            return 0;
+        }
+        area = static_cast<uint64_t>(r1 - r0) * static_cast<uint64_t>(c1 - c0);
+        return static_cast<uint64_t>(sat[r1 * stride + c1]) - sat[r0 * stride + c1]
+             - sat[r1 * stride + c0] + sat[r0 * stride + c0];
+    };
+
+    auto containsFineCell = [&](int r, int c, int s) {
+        for (const auto& cell : fineCells) {
+            if (cell.row >= r && cell.row < r + s && cell.col >= c && cell.col < c + s) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    auto makeLeaf = [&tree](int32_t node, int r, int c, int s, bool navigable) {
+        tree.nodes_[node].leaf = static_cast<int32_t>(tree.leaves_.size());
+        tree.leaves_.push_back(QuadtreeLeaf{ r, c, s, navigable });
+        if (navigable) ++tree.navigableLeaves_;
+    };
+
+    std::function<void(int32_t, int, int, int)> subdivide = [&](int32_t node, int r, int c, int s) {
+        uint64_t area = 0;
+        uint64_t navigable = clipped(r, c, r + s, c + s, area);
+        if (navigable == 0) {
+            makeLeaf(node, r, c, s, false);
+            return;
+        }
+
+        bool inside = (r + s <= rows && c + s <= cols);
+        if (inside && navigable == static_cast<uint64_t>(s) * s && s <= maxLeaf) {
+            bool keep = (s == 1);
+            if (!keep && !containsFineCell(r, c, s)) {
+                uint64_t ringArea = 0;
+                uint64_t ringNavigable = clipped(r - margin, c - margin, r + s + margin, c + s + margin, ringArea);
+                keep = (ringNavigable == ringArea);   // No coast/shallows within the margin
+            }
+            if (keep) {
+                makeLeaf(node, r, c, s, true);
+                return;
+            }
+        }
+
+        // Mixed block (s > 1 here: a single cell is always uniform)
+        int32_t first = static_cast<int32_t>(tree.nodes_.size());
+        tree.nodes_[node].firstChild = first;
+        tree.nodes_.resize(tree.nodes_.size() + 4, Node{ -1, -1 });
+        int half = s / 2;
+        subdivide(first + 0, r, c, half);
+        subdivide(first + 1, r, c + half, half);
+        subdivide(first + 2, r + half, c, half);
+        subdivide(first + 3, r + half, c + half, half);
+    };
+
+    tree.nodes_.push_back(Node{ -1, -1 });
+    subdivide(0, 0, 0, tree.rootSize_);
+    tree.LinkNeighbors();
+
+    std::cout << "[QuadtreeGrid] " << tree.navigableLeaves_ << " navigable leaves for "
+              << grid.Rows() << "x" << grid.Cols() << " cells ("
+              << tree.MemoryBytes() / 1024 << " KB)" << std::endl;
+    return tree;
+}
+
+// ===== Lookup =====
+int32_t QuadtreeGrid::LeafAt(int row, int col) const {
+    if (row < 0 || row >= rows_ || col < 0 || col >= cols_ || nodes_.empty()) {
+        return -1;
+    }
+    int32_t node = 0;
+    int r0 = 0;
+    int c0 = 0;
+    int size = rootSize_;
+    while (nodes_[node].firstChild >= 0) {
+        size /= 2;
+        int quadrant = 0;
+        if (row >= r0 + size) { quadrant += 2; r0 += size; }
+        if (col >= c0 + size) { quadrant += 1; c0 += size; }
+        node = nodes_[node].firstChild + quadrant;
+    }
+    return nodes_[node].leaf;
+}
+
+// ===== Neighbour Links =====
+void QuadtreeGrid::LinkNeighbors() {
+    neighborOffsets_.assign(leaves_.size() + 1, 0);
+    neighbors_.clear();
+
+    std::vector<int32_t> found;
+    for (size_t id = 0; id < leaves_.size(); ++id) {
+        neighborOffsets_[id] = static_cast<uint32_t>(neighbors_.size());
+        const QuadtreeLeaf& leaf = leaves_[id];
+        if (!leaf.navigable) {
+            continue;
+        }
+
+        found.clear();
+        auto visit = [&](int row, int col) -> int32_t {
+            int32_t other = LeafAt(row, col);
+            if (other >= 0 && leaves_[other].navigable) {
+                found.push_back(other);
+            }
+            return other;
+        };
+
+        // Rows above and below, corners included; skip along each touching leaf
+        for (int row : { leaf.row - 1, leaf.row + leaf.size }) {
+            if (row < 0 || row >= rows_) continue;
+            int col = std::max(0, leaf.col - 1);
+            int last = std::min(cols_ - 1, leaf.col + leaf.size);
+            while (col <= last) {
+                int32_t other = visit(row, col);
+                col = (other >= 0) ? std::max(col + 1, leaves_[other].col + leaves_[other].size) : col + 1;
+            }
+        }
+        // Columns left and right
+        for (int col : { leaf.col - 1, leaf.col + leaf.size }) {
+            if (col < 0 || col >= cols_) continue;
+            int row = leaf.row;
+            int last = std::min(rows_ - 1, leaf.row + leaf.size - 1);
+            while (row <= last) {
+                int32_t other = visit(row, col);
+                row = (other >= 0) ? std::max(row + 1, leaves_[other].row + leaves_[other].size) : row + 1;
+            }
+        }
+
+        std::sort(found.begin(), found.end());
+        found.erase(std::unique(found.begin(), found.end()), found.end());
+        neighbors_.insert(neighbors_.end(), found.begin(), found.end());
+    }
+    neighborOffsets_[leaves_.size()] = static_cast<uint32_t>(neighbors_.size());
+}
+
+size_t QuadtreeGrid::MemoryBytes() const {
+    return nodes_.size() * sizeof(Node) + leaves_.size() * sizeof(QuadtreeLeaf)
+        + neighborOffsets_.size() * sizeof(uint32_t) + neighbors_.size() * sizeof(int32_t);
+}
\ No newline at end of file
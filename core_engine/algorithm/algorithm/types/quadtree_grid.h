@@ -0,0 +1,93 @@
+#pragma once
+
+#include "grid_types.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ===== Quadtree Leaf =====
+// Square block of size x size cells of the source grid at (row, col).
+// A navigable leaf lies entirely inside the grid and every cell in it is
+// NAVIGABLE; other leaves contain no navigable cell.
+struct QuadtreeLeaf {
+    int32_t row;
+    int32_t col;
+    int32_t size;
+    bool navigable;
+
+    // Source-grid cell at the block centre
+    GridCoordinate Center() const { return GridCoordinate(row + size / 2, col + size / 2); }
+};
+
+// ===== Quadtree Adaptive Grid =====
+// Region quadtree over a NavigableGrid: open water far from any
+// non-navigable cell collapses into large leaves, while coasts, shallows
+// and the given waypoint cells keep the source resolution. Navigable leaves
+// carry neighbour links (edge or corner contact) for graph search
+// (QuadtreeSearchEngine). Positions stay in source-grid cells, so the
+// source grid's GridToGeo and the route planners apply unchanged.
+//
+// Moving between the centres of two touching navigable leaves never leaves
+// them: across a shared edge the segment crosses that edge, and across a
+// shared corner it passes through the corner point, like a diagonal step
+// on the source grid.
+//
+// The tree is built from the full dense source grid (plus a transient
+// 4-byte-per-cell summed-area table), so it reduces search work, not the
+// memory needed to build the grid; tiled grids are not supported.
+class QuadtreeGrid {
+public:
+    QuadtreeGrid();
+
+    /**
+     * @brief Build from a regular (not equal-distance) grid
+     *
+     * @param grid Source grid (GridBuilder output)
+     * @param fineCells Cells kept as 1x1 leaves (snapped waypoints)
+     * @param maxLeafSize Largest navigable leaf in cells (rounded down to a power of two)
+     * @param coastMarginCells Navigable leaves larger than one cell keep at least
+     *                         this many cells from any non-navigable cell
+     * @throws std::invalid_argument on equal-distance grids
+     */
+    static QuadtreeGrid Build(
+        const NavigableGrid& grid,
+        const std::vector<GridCoordinate>& fineCells = {},
+        int maxLeafSize = 64,
+        int coastMarginCells = 1
+    );
+
+    // Leaf containing the source cell, -1 outside the grid
+    int32_t LeafAt(int row, int col) const;
+    int32_t LeafAt(const GridCoordinate& pos) const { return LeafAt(pos.row, pos.col); }
+
+    const QuadtreeLeaf& Leaf(int32_t id) const { return leaves_[id]; }
+    int32_t LeafCount() const { return static_cast<int32_t>(leaves_.size()); }
+    int32_t NavigableLeafCount() const { return navigableLeaves_; }
+
+    // Navigable leaves touching a navigable leaf (empty for other leaves)
+    const int32_t* NeighborsBegin(int32_t id) const { return neighbors_.data() + neighborOffsets_[id]; }
+    const int32_t* NeighborsEnd(int32_t id) const { return neighbors_.data() + neighborOffsets_[id + 1]; }
+
+    int Rows() const { return rows_; }
+    int Cols() const { return cols_; }
+    size_t MemoryBytes() const;
+
+private:
+    // firstChild >= 0: four children at firstChild..+3 (NW, NE, SW, SE);
+    // otherwise leaf is the leaf id
+    struct Node {
+        int32_t firstChild;
+        int32_t leaf;
+    };
+
+    int rows_;
+    int cols_;
+    int rootSize_;
+    int32_t navigableLeaves_;
+    std::vector<Node> nodes_;
+    std::vector<QuadtreeLeaf> leaves_;
+    std::vector<uint32_t> neighborOffsets_;   // LeafCount() + 1 entries
+    std::vector<int32_t> neighbors_;
+
+    void LinkNeighbors();
+};
\ No newline at end of file
@@ -21,6 +21,8 @@ struct VoyageConfig {
     // 그리드 설정
     double gridCellSizeKm = 5.0;
     int gridMarginCells = 20;
+    bool equalDistanceGrid = false; // 행마다 경도 셀 수를 달리해 셀 폭을 gridCellSizeKm에 맞춤 (고위도 과해상도 방지)
+    double underKeelClearanceM = -1.0;  // 0 이상이면 수심 < draftM + 여유 수심인 셀을 SHALLOW로 (그리드 재생성 없이 수심 레이어로 재분류, 음수면 GridBuilder 기준)
     
     // 스냅핑 설정
     double maxSnapRadiusKm = 50.0;
@@ -28,6 +30,16 @@ struct VoyageConfig {
     // 계산 옵션
     bool calculateShortest = true;
     bool calculateOptimized = true;
+    bool keepReplanState = false;   // 최적 경로 탐색 상태 유지 (날씨 갱신/선박 이동 시 증분 재탐색)
+    int searchThreads = 1;          // A* 탐색 스레드 수 (2 이상이면 병렬 HDA*)
+    bool useIsochrone = false;      // 최적 경로를 격자 A* 대신 등시선(isochrone) 방식으로 계산
+    int maxLabelsPerCell = 0;       // 셀당 (연료, 시간) 파레토 라벨 수 (0이면 단일 라벨 A*)
+    bool pruneWithShortestFuel = true;  // 최단 경로 연료를 최적 경로 탐색의 상한으로 사용
+    bool useQuadtree = false;       // 연안/천해/웨이포인트만 원 해상도인 쿼드트리 잎 그래프에서 탐색 (원해는 큰 잎)
+    int quadtreeMaxLeafCells = 64;  // 쿼드트리 잎 한 변의 최대 셀 수 (2의 거듭제곱으로 내림)
+    bool useVisibilityGraph = false;    // 최단 경로를 GSHHS 해안선 가시성 그래프(any-angle)로 계산 (GSHHS 로드 필요)
+    double visibilityBufferKm = 2.0;    // 가시성 그래프 해안선 안전 거리 (격자 셀 크기 이상 권장)
+    double visibilitySimplifyKm = 1.0;  // 해안선 단순화 허용 오차 (안전 거리에 더해 팽창)
 
     std::string output_path = "";
 };
\ No newline at end of file
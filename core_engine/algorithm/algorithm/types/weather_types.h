@@ -26,4 +26,22 @@ struct Weather {
     double waveDir = 0.0;   // degrees
     double waveHgt = 0.0;   // meters
     double wavePrd = 0.0;   // seconds
+};
+
+// Region of a weather field whose values changed between two forecasts
+// (used to repair incremental search state instead of replanning from scratch)
+struct WeatherChangeRegion {
+    bool global = false;        // header/layout changed: everything is affected
+
+    // Changed area in the field's own lon/lat space
+    double minLat = 0.0, maxLat = 0.0;
+    double minLon = 0.0, maxLon = 0.0;  // StartLon-relative, in [StartLon, StartLon + 360]
+    double startLon = 0.0;
+
+    // Changed time bins (inclusive) and the timing of the field they refer to
+    int timeIdxMin = 0;
+    int timeIdxMax = 0;
+    unsigned int iStartTime = 0;
+    unsigned int iNumTime = 0;
+    unsigned int iTimeBin = 0;
 };
\ No newline at end of file
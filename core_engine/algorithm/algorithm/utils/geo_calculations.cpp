@@ -73,4 +73,27 @@ double calculateBearing(const GeoCoordinate& from, const GeoCoordinate& to) {
     bearing_deg = std::fmod(bearing_deg + 360.0, 360.0);
 
     return bearing_deg;
+}
+
+GeoCoordinate destinationPoint(const GeoCoordinate& from, double bearingDeg, double distanceKm) {
+    const double R = 6371.0; // Earth radius in km
+
+    double lat1 = from.latitude * PI / 180.0;
+    double lon1 = from.longitude * PI / 180.0;
+    double brng = bearingDeg * PI / 180.0;
+    double delta = distanceKm / R;
+
+    double lat2 = std::asin(std::sin(lat1) * std::cos(delta) +
+                            std::cos(lat1) * std::sin(delta) * std::cos(brng));
+    double lon2 = lon1 + std::atan2(std::sin(brng) * std::sin(delta) * std::cos(lat1),
+                                    std::cos(delta) - std::sin(lat1) * std::sin(lat2));
+
+    return GeoCoordinate(lat2 * 180.0 / PI, lon2 * 180.0 / PI);
+}
+
+double normalizeLongitude(double lon) {
+    if (lon >= -180.0 && lon <= 180.0) {
+        return lon;
+    }
+    return std::fmod(std::fmod(lon + 180.0, 360.0) + 360.0, 360.0) - 180.0;
 }
\ No newline at end of file
@@ -17,4 +17,10 @@ std::vector<GeoCoordinate> generateGreatCirclePoints(
 );
 
 // 방위각 계산 (bearing)
-double calculateBearing(const GeoCoordinate& from, const GeoCoordinate& to);
\ No newline at end of file
+double calculateBearing(const GeoCoordinate& from, const GeoCoordinate& to);
+
+// 시작점에서 방위각(도)과 거리(km)만큼 이동한 지점 (경도는 시작점 기준 연속값, 정규화하지 않음)
+GeoCoordinate destinationPoint(const GeoCoordinate& from, double bearingDeg, double distanceKm);
+
+// 경도를 [-180, 180] 범위로 정규화 (날짜변경선을 넘는 그리드의 연속 경도 출력용)
+double normalizeLongitude(double lon);
\ No newline at end of file
@@ -127,4 +127,146 @@ Weather getWeatherAtCoordinate(
     }
     
     return conditions;
-}
\ No newline at end of file
+}
+
+// ===== 증분 재탐색을 위한 날씨 변경 영역 계산 =====
+
+static int getTimeIndex(
+    unsigned int iStartTime, unsigned int iNumTime, unsigned int iTimeBin,
+    unsigned int time)
+{
+    // get3dIndex()의 time index 계산과 동일 (음수 = 조회 범위 밖, 날씨 0)
+    double elapsed_seconds = (double)time - iStartTime;
+    if (elapsed_seconds < 0 || iTimeBin == 0) return -1;
+    double elapsed_hours = elapsed_seconds / 3600.0;
+    int time_idx = (int)std::floor(elapsed_hours / (double)iTimeBin);
+    int NT = (int)iNumTime;
+    if (NT > 0) time_idx = (time_idx % NT + NT) % NT;
+    return time_idx;
+}
+
+static bool sameWeatherLayout(const WeatherDataInput& a, const WeatherDataInput& b) {
+    return a.iStartTime == b.iStartTime && a.iNumTime == b.iNumTime &&
+        a.iTimeBin == b.iTimeBin && a.StartLon == b.StartLon &&
+        a.iNumLon == b.iNumLon && a.LonBin == b.LonBin &&
+        a.StartLat == b.StartLat && a.iNumLat == b.iNumLat &&
+        a.LatBin == b.LatBin && a.data.size() == b.data.size();
+}
+
+static bool sameWeatherValue(float a, float b) {
+    // getWeatherValue()에서 0.0으로 처리되는 결측값끼리는 같은 값으로 취급
+    bool missingA = !std::isfinite(a) || a < -9000.0f;
+    bool missingB = !std::isfinite(b) || b < -9000.0f;
+    if (missingA || missingB) return missingA == missingB;
+    return a == b;
+}
+
+static WeatherChangeRegion makeRegion(
+    const WeatherDataInput& data,
+    int timeIdx,
+    int lonIdxMin, int lonIdxMax,
+    int latIdxMin, int latIdxMax)
+{
+    WeatherChangeRegion region;
+    region.iStartTime = data.iStartTime;
+    region.iNumTime = data.iNumTime;
+    region.iTimeBin = data.iTimeBin;
+    region.timeIdxMin = timeIdx;
+    region.timeIdxMax = timeIdx;
+    region.startLon = data.StartLon;
+
+    // lon: 조회 시 StartLon 기준으로 정규화되며, 마지막 bin은 clamp되므로 360도까지 확장
+    region.minLon = data.StartLon + lonIdxMin * data.LonBin;
+    region.maxLon = (lonIdxMax >= (int)data.iNumLon - 1)
+        ? data.StartLon + 360.0
+        : data.StartLon + (lonIdxMax + 1) * data.LonBin;
+
+    // lat: get3dIndex는 LatBin 부호와 무관하게 lat_idx = floor((StartLat - lat) / |LatBin|)
+    // (lat_idx 증가 방향 = 항상 남쪽), 양 끝 bin은 clamp되므로 극까지 확장
+    const double latBin = std::abs(data.LatBin);
+    region.maxLat = (latIdxMin == 0) ? 90.0 : data.StartLat - latIdxMin * latBin;
+    region.minLat = (latIdxMax >= (int)data.iNumLat - 1)
+        ? -90.0
+        : data.StartLat - (latIdxMax + 1) * latBin;
+    return region;
+}
+
+std::vector<WeatherChangeRegion> diffWeatherData(
+    const std::map<std::string, WeatherDataInput>& old_weather_data,
+    const std::map<std::string, WeatherDataInput>& new_weather_data)
+{
+    std::vector<WeatherChangeRegion> regions;
+    WeatherChangeRegion globalRegion;
+    globalRegion.global = true;
+
+    // 파일이 추가/삭제되면 모든 조회 결과가 바뀔 수 있음
+    for (const auto& [key, oldData] : old_weather_data) {
+        if (!new_weather_data.count(key)) return { globalRegion };
+    }
+
+    for (const auto& [key, newData] : new_weather_data) {
+        auto it = old_weather_data.find(key);
+        if (it == old_weather_data.end() || !sameWeatherLayout(it->second, newData)) {
+            return { globalRegion };
+        }
+        const WeatherDataInput& oldData = it->second;
+
+        const int NT = (int)newData.iNumTime;
+        const int NLon = (int)newData.iNumLon;
+        const int NLat = (int)newData.iNumLat;
+        if ((size_t)NT * NLon * NLat != newData.data.size()) return { globalRegion };
+
+        // layout: [time][lon][lat] -> time bin마다 변경된 index 범위(bbox)를 기록
+        for (int t = 0; t < NT; ++t) {
+            int lonMin = NLon, lonMax = -1, latMin = NLat, latMax = -1;
+            for (int lo = 0; lo < NLon; ++lo) {
+                size_t base = ((size_t)t * NLon + lo) * NLat;
+                for (int la = 0; la < NLat; ++la) {
+                    if (!sameWeatherValue(oldData.data[base + la], newData.data[base + la])) {
+                        lonMin = std::min(lonMin, lo);
+                        lonMax = std::max(lonMax, lo);
+                        latMin = std::min(latMin, la);
+                        latMax = std::max(latMax, la);
+                    }
+                }
+            }
+            if (lonMax < 0) continue;
+
+            WeatherChangeRegion region = makeRegion(newData, t, lonMin, lonMax, latMin, latMax);
+
+            // 같은 영역이 연속된 time bin에서 바뀌었으면 하나로 병합
+            if (!regions.empty()) {
+                WeatherChangeRegion& last = regions.back();
+                if (last.iStartTime == region.iStartTime && last.iTimeBin == region.iTimeBin &&
+                    last.iNumTime == region.iNumTime && last.timeIdxMax + 1 == t &&
+                    last.minLat == region.minLat && last.maxLat == region.maxLat &&
+                    last.minLon == region.minLon && last.maxLon == region.maxLon) {
+                    last.timeIdxMax = t;
+                    continue;
+                }
+            }
+            regions.push_back(region);
+        }
+    }
+
+    return regions;
+}
+
+bool isInWeatherChangeRegion(
+    const WeatherChangeRegion& region,
+    unsigned int time,
+    double lat,
+    double lon)
+{
+    if (region.global) return true;
+
+    int time_idx = getTimeIndex(region.iStartTime, region.iNumTime, region.iTimeBin, time);
+    if (time_idx < region.timeIdxMin || time_idx > region.timeIdxMax) return false;
+
+    // get3dIndex()와 동일한 lon 정규화
+    double lon_rel = std::fmod(std::fmod(lon - region.startLon, 360.0) + 360.0, 360.0);
+    double lon_norm = region.startLon + lon_rel;
+
+    return lat >= region.minLat && lat <= region.maxLat &&
+        lon_norm >= region.minLon && lon_norm <= region.maxLon;
+}
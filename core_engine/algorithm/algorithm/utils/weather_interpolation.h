@@ -1,6 +1,8 @@
 #pragma once
 #include "../types/weather_types.h"
 #include <map>
+#include <string>
+#include <vector>
 
 // ===== 기존 parse_weather_data.h 내용 100% 그대로 =====
 
@@ -9,4 +11,18 @@ Weather getWeatherAtCoordinate(
     unsigned int time,
     double lat,
     double lon
-);
\ No newline at end of file
+);
+
+// 두 날씨 데이터 사이에서 값이 바뀐 영역 계산 (증분 재탐색용)
+std::vector<WeatherChangeRegion> diffWeatherData(
+    const std::map<std::string, WeatherDataInput>& old_weather_data,
+    const std::map<std::string, WeatherDataInput>& new_weather_data
+);
+
+// 주어진 시각/좌표의 날씨 조회가 변경 영역에 해당하는지 확인
+bool isInWeatherChangeRegion(
+    const WeatherChangeRegion& region,
+    unsigned int time,
+    double lat,
+    double lon
+);